@@ -19,6 +19,7 @@
 #include "image.h"
 #include "fih.h"
 #include "bl1_1_config.h"
+#include "tfm_boot_timeline.h"
 
 #if defined(TEST_BL1_1) && defined(PLATFORM_DEFAULT_BL1_TEST_EXECUTION)
 #include "bl1_1_suites.h"
@@ -92,11 +93,15 @@ int main(void)
     fih_int fih_rc = FIH_FAILURE;
     fih_int recovery_succeeded = FIH_FAILURE;
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_ENTRY, 0);
+
     fih_rc = fih_int_encode_zero_equality(boot_platform_init());
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         boot_platform_error_state(fih_int_decode(fih_rc));
     }
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_PLATFORM_INIT_DONE, 0);
+
     INFO("Starting TF-M BL1_1\n");
 
 #if defined(TEST_BL1_1) && defined(PLATFORM_DEFAULT_BL1_TEST_EXECUTION)
@@ -125,12 +130,16 @@ int main(void)
 
     do {
         /* Copy BL1_2 from OTP into SRAM*/
+        BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_COPY_START, 0);
         FIH_CALL(bl1_read_bl1_2_image, fih_rc, (uint8_t *)BL1_2_CODE_START);
         if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
             boot_platform_error_state(fih_int_decode(fih_rc));
         }
+        BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_COPY_DONE, 0);
 
+        BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_HASH_START, 0);
         FIH_CALL(bl1_1_validate_image_at_addr, fih_rc, (uint8_t *)BL1_2_CODE_START);
+        BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_HASH_DONE, 0);
 
         if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
             ERROR("BL1_2 image failed to validate\n");
@@ -151,6 +160,13 @@ int main(void)
     collect_boot_measurement();
 #endif /* TFM_MEASURED_BOOT_API */
 
+#ifdef TFM_BOOT_TIMELINE
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_EXIT, 0);
+    if (boot_timeline_save(BOOT_TIMELINE_STAGE_BL1_1)) {
+        WARN("Failed to save the boot timeline of BL1_1\n");
+    }
+#endif /* TFM_BOOT_TIMELINE */
+
     INFO("Jumping to BL1_2\n");
     /* Jump to BL1_2 */
     boot_platform_start_next_image((struct boot_arm_vector_table *)BL1_2_CODE_START);
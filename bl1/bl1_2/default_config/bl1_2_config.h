@@ -45,6 +45,14 @@
 #define TFM_BL1_2_MEASUREMENT_HASH_MAX_SIZE 48
 #endif
 
+/* Size of the chunks in which an encrypted image is decrypted and measured in a
+ * single pass. Must be a multiple of 16. 0 decrypts the whole image and then
+ * hashes it in a second pass.
+ */
+#ifndef TFM_BL1_2_DECRYPT_CHUNK_SIZE
+#define TFM_BL1_2_DECRYPT_CHUNK_SIZE 0
+#endif
+
 #ifndef TFM_BL1_2_HEADER_MAX_SIZE
 #define TFM_BL1_2_HEADER_MAX_SIZE 0xC80
 #endif
@@ -21,6 +21,7 @@
 #include "pq_crypto.h"
 #include "tfm_plat_nv_counters.h"
 #include "tfm_plat_otp.h"
+#include "tfm_boot_timeline.h"
 
 #ifdef TFM_MEASURED_BOOT_API
 #include "boot_measurement.h"
@@ -76,6 +77,12 @@ static fih_int submit_boot_measurement(const struct bl1_2_image_t *image,
 }
 #endif /* TFM_MEASURED_BOOT_API */
 
+#if defined(TFM_BL1_2_IMAGE_ENCRYPTION) && (TFM_BL1_2_DECRYPT_CHUNK_SIZE > 0)
+#if (TFM_BL1_2_DECRYPT_CHUNK_SIZE % 16) != 0
+#error TFM_BL1_2_DECRYPT_CHUNK_SIZE must be a multiple of the AES block size
+#endif
+#endif
+
 static fih_int is_image_security_counter_valid(struct bl1_2_image_t *img)
 {
     uint32_t security_counter;
@@ -263,28 +270,43 @@ static fih_int check_key_policy(fih_int validate_rc,
 }
 #endif
 
-static fih_int is_image_signature_valid(struct bl1_2_image_t *img)
+#if !defined(TFM_BL1_2_IMAGE_ENCRYPTION) || (TFM_BL1_2_DECRYPT_CHUNK_SIZE == 0) || \
+    defined(TEST_BL1_2)
+static fih_int calc_measurement_hash(struct bl1_2_image_t *img,
+                                     uint8_t *measurement_hash,
+                                     size_t measurement_hash_buf_size,
+                                     size_t *measurement_hash_size)
 {
     fih_int fih_rc = FIH_FAILURE;
-    static uint8_t measurement_hash[TFM_BL1_2_MEASUREMENT_HASH_MAX_SIZE];
-    static size_t measurement_hash_size;
-    uint32_t idx;
-#ifdef TFM_BL1_2_ENABLE_ROTPK_POLICIES
-    bool key_must_sign  = true;
-    bool key_might_sign = false;
-#endif
 
-    /* Calculate the image hash for measured boot */
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_HASH_START, 0);
     FIH_CALL(bl1_hash_compute, fih_rc, TFM_BL1_2_MEASUREMENT_HASH_ALG,
                                        (uint8_t *)&img->protected_values,
                                        sizeof(img->protected_values),
-                                       measurement_hash, sizeof(measurement_hash),
-                                       &measurement_hash_size);
+                                       measurement_hash, measurement_hash_buf_size,
+                                       measurement_hash_size);
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         ERROR("Boot measurement failed\n");
         FIH_RET(fih_rc);
     }
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_HASH_DONE, 0);
 
+    FIH_RET(FIH_SUCCESS);
+}
+#endif
+
+static fih_int is_image_signature_valid(struct bl1_2_image_t *img,
+                                        uint8_t *measurement_hash,
+                                        size_t measurement_hash_size)
+{
+    fih_int fih_rc = FIH_FAILURE;
+    uint32_t idx;
+#ifdef TFM_BL1_2_ENABLE_ROTPK_POLICIES
+    bool key_must_sign  = true;
+    bool key_might_sign = false;
+#endif
+
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_SIG_VERIFY_START, 0);
     for (idx = 0; idx < TFM_BL1_2_SIGNER_AMOUNT; idx++) {
         FIH_CALL(validate_image_signature, fih_rc, img,
                                                    &img->header.sigs[idx],
@@ -304,18 +326,23 @@ static fih_int is_image_signature_valid(struct bl1_2_image_t *img)
         FIH_RET(FIH_FAILURE);
     }
 #endif
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_SIG_VERIFY_DONE, 0);
 
     FIH_RET(FIH_SUCCESS);
 }
 
-#ifndef TEST_BL1_2
-static
-#endif
-fih_int bl1_2_validate_image_at_addr(struct bl1_2_image_t *image)
+/* Validates an image against the hash of its protected values, which the
+ * caller has computed over the same copy of the image.
+ */
+static fih_int validate_measured_image(struct bl1_2_image_t *image,
+                                       uint8_t *measurement_hash,
+                                       size_t measurement_hash_size)
 {
     fih_int fih_rc = FIH_FAILURE;
 
-    FIH_CALL(is_image_signature_valid, fih_rc, image);
+    FIH_CALL(is_image_signature_valid, fih_rc, image,
+                                               measurement_hash,
+                                               measurement_hash_size);
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         ERROR("BL2 image signature failed to validate\n");
         FIH_RET(fih_rc);
@@ -330,17 +357,122 @@ fih_int bl1_2_validate_image_at_addr(struct bl1_2_image_t *image)
     FIH_RET(FIH_SUCCESS);
 }
 
+/* Encrypted images are measured by copy_and_decrypt_image() instead */
+#if !defined(TFM_BL1_2_IMAGE_ENCRYPTION) || defined(TEST_BL1_2)
+#ifndef TEST_BL1_2
+static
+#endif
+fih_int bl1_2_validate_image_at_addr(struct bl1_2_image_t *image)
+{
+    static uint8_t measurement_hash[TFM_BL1_2_MEASUREMENT_HASH_MAX_SIZE];
+    size_t measurement_hash_size;
+    fih_int fih_rc = FIH_FAILURE;
+
+    FIH_CALL(calc_measurement_hash, fih_rc, image,
+                                            measurement_hash,
+                                            sizeof(measurement_hash),
+                                            &measurement_hash_size);
+    if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+        FIH_RET(fih_rc);
+    }
+
+    FIH_CALL(validate_measured_image, fih_rc, image,
+                                              measurement_hash,
+                                              measurement_hash_size);
+    FIH_RET(fih_rc);
+}
+#endif /* !TFM_BL1_2_IMAGE_ENCRYPTION || TEST_BL1_2 */
+
 #ifdef TFM_BL1_2_IMAGE_ENCRYPTION
+#if TFM_BL1_2_DECRYPT_CHUNK_SIZE > 0
+static void ctr_add_blocks(uint8_t *counter, size_t blocks)
+{
+    int idx;
+
+    /* The counter block is a 128-bit big-endian integer */
+    for (idx = 15; (idx >= 0) && (blocks != 0); idx--) {
+        blocks += counter[idx];
+        counter[idx] = (uint8_t)blocks;
+        blocks >>= 8;
+    }
+}
+
+/* Decrypts the image one chunk at a time, and feeds each decrypted chunk to
+ * the measurement hash while it is still hot in the cache, instead of making a
+ * second pass over the whole image in calc_measurement_hash(). The counter
+ * for each chunk is derived from the IV, as not every bl1_aes_256_ctr_decrypt()
+ * implementation writes the updated counter back.
+ */
+static fih_int decrypt_and_measure_image(const uint8_t *key,
+                                         const struct bl1_2_image_t *src,
+                                         struct bl1_2_image_t *image,
+                                         uint8_t *measurement_hash,
+                                         size_t measurement_hash_buf_size,
+                                         size_t *measurement_hash_size)
+{
+    const uint8_t *ciphertext = (const uint8_t *)&src->protected_values.encrypted_data;
+    uint8_t *plaintext = (uint8_t *)&image->protected_values.encrypted_data;
+    const size_t total_size = sizeof(image->protected_values.encrypted_data);
+    uint32_t counter[16 / sizeof(uint32_t)];
+    size_t offset;
+    size_t chunk_size;
+    fih_int fih_rc = FIH_FAILURE;
+
+    FIH_CALL(bl1_hash_init, fih_rc, TFM_BL1_2_MEASUREMENT_HASH_ALG);
+    if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+        FIH_RET(fih_rc);
+    }
+
+    /* The version and the security counter aren't encrypted */
+    FIH_CALL(bl1_hash_update, fih_rc, (uint8_t *)&image->protected_values,
+                                      sizeof(image->protected_values) - total_size);
+    if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+        FIH_RET(fih_rc);
+    }
+
+    for (offset = 0; offset < total_size; offset += chunk_size) {
+        chunk_size = total_size - offset;
+        if (chunk_size > TFM_BL1_2_DECRYPT_CHUNK_SIZE) {
+            chunk_size = TFM_BL1_2_DECRYPT_CHUNK_SIZE;
+        }
+
+        memcpy(counter, image->header.ctr_iv, sizeof(counter));
+        ctr_add_blocks((uint8_t *)counter, offset / 16);
+
+        FIH_CALL(bl1_aes_256_ctr_decrypt, fih_rc, TFM_BL1_KEY_USER, key,
+                                                  (uint8_t *)counter,
+                                                  ciphertext + offset, chunk_size,
+                                                  plaintext + offset);
+        if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+            FIH_RET(fih_rc);
+        }
+
+        FIH_CALL(bl1_hash_update, fih_rc, plaintext + offset, chunk_size);
+        if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+            FIH_RET(fih_rc);
+        }
+    }
+
+    FIH_CALL(bl1_hash_finish, fih_rc, measurement_hash, measurement_hash_buf_size,
+                                      measurement_hash_size);
+    FIH_RET(fih_rc);
+}
+#endif /* TFM_BL1_2_DECRYPT_CHUNK_SIZE > 0 */
+
 #ifndef TEST_BL1_2
 static
 #endif
-fih_int copy_and_decrypt_image(uint32_t image_id, struct bl1_2_image_t *image)
+fih_int copy_and_decrypt_image(uint32_t image_id, struct bl1_2_image_t *image,
+                               uint8_t *measurement_hash,
+                               size_t measurement_hash_buf_size,
+                               size_t *measurement_hash_size)
 {
     struct bl1_2_image_t *image_to_decrypt;
     uint32_t key_buf[32 / sizeof(uint32_t)];
     uint8_t label[] = "BL2_DECRYPTION_KEY";
     fih_int fih_rc = FIH_FAILURE;
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_COPY_START, image_id);
 #ifdef TFM_BL1_MEMORY_MAPPED_FLASH
     /* If we have memory-mapped flash, we can do the decrypt directly from the
      * flash and output to the SRAM. This is significantly faster if the AES
@@ -365,6 +497,7 @@ fih_int copy_and_decrypt_image(uint32_t image_id, struct bl1_2_image_t *image)
     }
     image_to_decrypt = image;
 #endif /* TFM_BL1_MEMORY_MAPPED_FLASH */
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_COPY_DONE, image_id);
 
     /* As the security counter is an attacker controlled parameter, bound the
      * values to a sensible range. In this case, we choose 1024 as the bound as
@@ -383,20 +516,41 @@ fih_int copy_and_decrypt_image(uint32_t image_id, struct bl1_2_image_t *image)
         FIH_RET(fih_rc);
     }
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_DECRYPT_START, image_id);
+#if TFM_BL1_2_DECRYPT_CHUNK_SIZE > 0
+    FIH_CALL(decrypt_and_measure_image, fih_rc, (uint8_t *)key_buf,
+                                                image_to_decrypt, image,
+                                                measurement_hash,
+                                                measurement_hash_buf_size,
+                                                measurement_hash_size);
+#else
     FIH_CALL(bl1_aes_256_ctr_decrypt, fih_rc, TFM_BL1_KEY_USER, (uint8_t *)key_buf,
                                  image->header.ctr_iv,
                                  (uint8_t *)&image_to_decrypt->protected_values.encrypted_data,
                                  sizeof(image->protected_values.encrypted_data),
                                  (uint8_t *)&image->protected_values.encrypted_data);
+#endif
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         FIH_RET(fih_rc);
     }
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_DECRYPT_DONE, image_id);
 
     if (image->protected_values.encrypted_data.decrypt_magic
             != TFM_BL1_2_IMAGE_DECRYPT_MAGIC_EXPECTED) {
         FIH_RET(FIH_FAILURE);
     }
 
+#if TFM_BL1_2_DECRYPT_CHUNK_SIZE == 0
+    /* The image wasn't measured while it was decrypted */
+    FIH_CALL(calc_measurement_hash, fih_rc, image,
+                                            measurement_hash,
+                                            measurement_hash_buf_size,
+                                            measurement_hash_size);
+    if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
+        FIH_RET(fih_rc);
+    }
+#endif
+
     FIH_RET(FIH_SUCCESS);
 }
 
@@ -406,6 +560,7 @@ fih_int copy_image(uint32_t image_id, struct bl1_2_image_t *image)
 {
     struct bl1_2_image_t *image_to_copy;
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_COPY_START, image_id);
 #ifdef TFM_BL1_MEMORY_MAPPED_FLASH
     image_to_copy = (struct bl1_2_image_t *)(FLASH_BL1_BASE_ADDRESS +
                        bl1_image_get_flash_offset(image_id));
@@ -414,6 +569,7 @@ fih_int copy_image(uint32_t image_id, struct bl1_2_image_t *image)
 #else
     bl1_image_copy_to_sram(image_id, (uint8_t *)image);
 #endif /* TFM_BL1_MEMORY_MAPPED_FLASH */
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_COPY_DONE, image_id);
 
     FIH_RET(FIH_SUCCESS);
 }
@@ -423,18 +579,34 @@ fih_int copy_image(uint32_t image_id, struct bl1_2_image_t *image)
 static fih_int bl1_2_validate_image(uint32_t image_id)
 {
     fih_int fih_rc = FIH_FAILURE;
+#ifdef TFM_BL1_2_IMAGE_ENCRYPTION
+    static uint8_t measurement_hash[TFM_BL1_2_MEASUREMENT_HASH_MAX_SIZE];
+    size_t measurement_hash_size;
+#endif
     struct bl1_2_image_t *image =
         (struct bl1_2_image_t *)(BL2_CODE_START -
                                  offsetof(struct bl1_2_image_t, protected_values.encrypted_data.data));
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_IMAGE_VALIDATE_START, image_id);
+
 #ifdef TFM_BL1_2_IMAGE_ENCRYPTION
-    FIH_CALL(copy_and_decrypt_image, fih_rc, image_id, image);
+    FIH_CALL(copy_and_decrypt_image, fih_rc, image_id, image,
+                                             measurement_hash,
+                                             sizeof(measurement_hash),
+                                             &measurement_hash_size);
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         ERROR("BL2 image failed to decrypt\n");
         FIH_RET(fih_rc);
     }
 
     INFO("BL2 image decrypted successfully\n");
+
+    /* The hash returned by the decryption is the one of this copy of the
+     * image, so it is checked against the signatures as is.
+     */
+    FIH_CALL(validate_measured_image, fih_rc, image,
+                                              measurement_hash,
+                                              measurement_hash_size);
 #else
     FIH_CALL(copy_image, fih_rc, image_id, image);
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
@@ -443,15 +615,16 @@ static fih_int bl1_2_validate_image(uint32_t image_id)
     }
 
     INFO("BL2 image copied successfully\n");
-#endif
 
     FIH_CALL(bl1_2_validate_image_at_addr, fih_rc, image);
+#endif
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         ERROR("BL2 image failed to validate\n");
         FIH_RET(fih_rc);
     }
 
     INFO("BL2 image validated successfully\n");
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_IMAGE_VALIDATE_DONE, image_id);
 
     FIH_RET(FIH_SUCCESS);
 }
@@ -461,12 +634,15 @@ int main(void)
     fih_int fih_rc = FIH_FAILURE;
     fih_int recovery_succeeded = FIH_FAILURE;
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_ENTRY, 0);
+
     fih_rc = fih_int_encode_zero_equality(boot_platform_init());
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         boot_platform_error_state(fih_rc);
         FIH_PANIC;
     }
     INFO("Starting TF-M BL1_2\n");
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_PLATFORM_INIT_DONE, 0);
 
 #if defined(TEST_BL1_2) && defined(PLATFORM_DEFAULT_BL1_TEST_EXECUTION)
     run_bl1_2_testsuite();
@@ -508,6 +684,13 @@ int main(void)
         FIH_PANIC;
     }
 
+#ifdef TFM_BOOT_TIMELINE
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_EXIT, 0);
+    if (boot_timeline_save(BOOT_TIMELINE_STAGE_BL1_2)) {
+        WARN("Failed to save the boot timeline of BL1_2\n");
+    }
+#endif /* TFM_BOOT_TIMELINE */
+
     INFO("Jumping to BL2\n");
     boot_platform_start_next_image((struct boot_arm_vector_table *)BL2_CODE_START);
 
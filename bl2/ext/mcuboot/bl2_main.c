@@ -31,6 +31,7 @@
 #include "uart_stdout.h"
 #include "tfm_plat_otp.h"
 #include "tfm_plat_provisioning.h"
+#include "tfm_boot_timeline.h"
 #ifdef TEST_BL2
 #include "mcuboot_suites.h"
 #endif /* TEST_BL2 */
@@ -115,6 +116,8 @@ int main(void)
     enum tfm_plat_err_t plat_err;
     int32_t image_id;
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_ENTRY, 0);
+
     /* Initialise the mbedtls static memory allocator so that mbedtls allocates
      * memory from the provided static buffer instead of from the heap.
      */
@@ -169,6 +172,8 @@ int main(void)
         boot_platform_error_state(err);
     }
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_PLATFORM_INIT_DONE, 0);
+
 #if defined(MCUBOOT_USE_PSA_CRYPTO)
     /* If the bootloader is configured to use PSA Crypto APIs in the
      * abstraction layer, the component needs to be explicitly initialized
@@ -201,6 +206,7 @@ int main(void)
             boot_platform_error_state(err);
         }
 
+        BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_IMAGE_VALIDATE_START, image_id);
         do {
             /* Primary goal to zeroize the 'rsp' is to avoid to accidentally load
              * the NS image in case of a fault injection attack. However, it is
@@ -219,6 +225,7 @@ int main(void)
                 }
             }
         } while FIH_NOT_EQ(fih_rc, FIH_SUCCESS);
+        BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_IMAGE_VALIDATE_DONE, image_id);
 
         err = boot_platform_post_load(image_id);
         if (err != 0) {
@@ -232,6 +239,13 @@ int main(void)
     BOOT_LOG_INF("Image version: v%d.%d.%d", rsp.br_hdr->ih_ver.iv_major,
                                                     rsp.br_hdr->ih_ver.iv_minor,
                                                     rsp.br_hdr->ih_ver.iv_revision);
+#ifdef TFM_BOOT_TIMELINE
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_EXIT, 0);
+    if (boot_timeline_save(BOOT_TIMELINE_STAGE_BL2)) {
+        BOOT_LOG_WRN("Failed to save the boot timeline of BL2");
+    }
+#endif /* TFM_BOOT_TIMELINE */
+
     BOOT_LOG_INF("Jumping to the first image slot");
     do_boot(&rsp);
 
@@ -6,6 +6,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 #include "target.h"
 #include "flash_map/flash_map.h"
 #include "flash_map_backend/flash_map_backend.h"
@@ -66,6 +67,142 @@ static bool is_range_valid(const struct flash_area *area,
 
     return true;
 }
+
+#if defined(PLATFORM_HAS_BOOT_DMA) && defined(BOOT_DMA_READ_AHEAD_SIZE)
+/*
+ * Sequential reads, such as the ones made while an image is being hashed, are
+ * served from two buffers. While the caller consumes the data of one of them,
+ * the DMA fetches the data following it in to the other one, so the flash
+ * access overlaps with the processing of the previous chunk.
+ */
+#if (BOOT_DMA_READ_AHEAD_SIZE % 4) != 0
+#error "BOOT_DMA_READ_AHEAD_SIZE must be a multiple of 4"
+#endif
+
+/* Kept apart from the channel used by the synchronous reads */
+#define BOOT_DMA_READ_AHEAD_CHANNEL    1
+
+struct read_ahead_buf_t {
+    uint32_t addr;      /* Flash offset of the buffered data */
+    uint32_t len;       /* Length of the buffered data, 0 if empty */
+    bool pending;       /* Whether the DMA is still filling the buffer */
+    uint32_t data[BOOT_DMA_READ_AHEAD_SIZE / sizeof(uint32_t)];
+};
+
+static struct read_ahead_buf_t read_ahead_buf[2];
+/* Flash offset following the last read, to detect sequential reads */
+static uint32_t read_ahead_next_addr = UINT32_MAX;
+
+static int read_ahead_wait(struct read_ahead_buf_t *buf)
+{
+    if (buf->pending) {
+        buf->pending = false;
+        if (boot_dma_wait(BOOT_DMA_READ_AHEAD_CHANNEL) != 0) {
+            buf->len = 0;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Waits for the transfer in flight, if any, and drops the buffered data. Has to
+ * be called before the flash is modified, and before BL2 hands over the memory
+ * the buffers live in.
+ */
+static void read_ahead_invalidate(void)
+{
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        (void)read_ahead_wait(&read_ahead_buf[i]);
+        read_ahead_buf[i].len = 0;
+    }
+
+    read_ahead_next_addr = UINT32_MAX;
+}
+
+/*
+ * Starts fetching the data of `area` at flash offset `addr` in to `buf`.
+ */
+static void read_ahead_fill(const struct flash_area *area,
+                            struct read_ahead_buf_t *buf,
+                            uint32_t addr)
+{
+    uint32_t area_end = area->fa_off + area->fa_size;
+    uint32_t len;
+
+    if ((buf->len != 0) && (buf->addr == addr)) {
+        /* Already fetched, or being fetched */
+        return;
+    }
+
+    /* There is only one channel, so there is one transfer in flight at most */
+    if ((read_ahead_wait(&read_ahead_buf[0]) != 0) ||
+        (read_ahead_wait(&read_ahead_buf[1]) != 0)) {
+        return;
+    }
+
+    buf->len = 0;
+    if (addr >= area_end) {
+        return;
+    }
+
+    len = area_end - addr;
+    if (len > BOOT_DMA_READ_AHEAD_SIZE) {
+        len = BOOT_DMA_READ_AHEAD_SIZE;
+    }
+
+    if (boot_dma_memcpy_start(FLASH_BASE_ADDRESS + addr, (uint32_t)buf->data,
+                              len, BOOT_DMA_READ_AHEAD_CHANNEL) == 0) {
+        buf->addr = addr;
+        buf->len = len;
+        buf->pending = true;
+    }
+}
+
+/*
+ * Serves a read from the read-ahead buffers if possible.
+ * Return 0 if `dst` has been filled, other value if the caller has to read the
+ * flash itself.
+ */
+static int read_ahead_read(const struct flash_area *area, uint32_t off,
+                           void *dst, uint32_t len)
+{
+    uint32_t addr = area->fa_off + off;
+    bool sequential = (addr == read_ahead_next_addr);
+    struct read_ahead_buf_t *buf;
+    int i;
+
+    read_ahead_next_addr = addr + len;
+
+    for (i = 0; i < 2; i++) {
+        buf = &read_ahead_buf[i];
+        if ((buf->len != 0) && (addr >= buf->addr) &&
+            ((addr + len) <= (buf->addr + buf->len))) {
+            if (read_ahead_wait(buf) != 0) {
+                return -1;
+            }
+
+            /* Refill the other buffer with the data which follows this one */
+            read_ahead_fill(area, &read_ahead_buf[i ^ 1],
+                            buf->addr + buf->len);
+
+            memcpy(dst, (uint8_t *)buf->data + (addr - buf->addr), len);
+            return 0;
+        }
+    }
+
+    if (sequential) {
+        /* Start the pipeline with the data which follows this read */
+        read_ahead_fill(area, &read_ahead_buf[0], addr + len);
+    }
+
+    return -1;
+}
+#endif /* PLATFORM_HAS_BOOT_DMA && BOOT_DMA_READ_AHEAD_SIZE */
+
 int flash_area_driver_init(void)
 {
     int i;
@@ -102,7 +239,10 @@ int flash_area_open(uint8_t id, const struct flash_area **area)
 
 void flash_area_close(const struct flash_area *area)
 {
-    /* Nothing to do. */
+#if defined(PLATFORM_HAS_BOOT_DMA) && defined(BOOT_DMA_READ_AHEAD_SIZE)
+    /* Don't leave a transfer in flight once the caller is done with the area */
+    read_ahead_invalidate();
+#endif /* PLATFORM_HAS_BOOT_DMA && BOOT_DMA_READ_AHEAD_SIZE */
 }
 
 /*
@@ -143,6 +283,12 @@ int flash_area_read(const struct flash_area *area, uint32_t off, void *dst,
     aligned_off = FLOOR_ALIGN(off, data_width);
 
 #ifdef PLATFORM_HAS_BOOT_DMA
+#ifdef BOOT_DMA_READ_AHEAD_SIZE
+    if (read_ahead_read(area, off, dst, len) == 0) {
+        return 0;
+    }
+#endif /* BOOT_DMA_READ_AHEAD_SIZE */
+
     if (len >= BOOT_DMA_MIN_SIZE_REQ) {
         dma_src_addr = FLASH_BASE_ADDRESS + area->fa_off + off;
         BOOT_LOG_DBG("dma memcpy call:src_addr=%#x, dest_addr=%#x, len=%#x",
@@ -262,6 +408,10 @@ int flash_area_write(const struct flash_area *area, uint32_t off,
 
     BOOT_LOG_DBG("write area=%d, off=%#x, len=%#x", area->fa_id, off, len);
 
+#if defined(PLATFORM_HAS_BOOT_DMA) && defined(BOOT_DMA_READ_AHEAD_SIZE)
+    read_ahead_invalidate();
+#endif /* PLATFORM_HAS_BOOT_DMA && BOOT_DMA_READ_AHEAD_SIZE */
+
     /* Align the target address. The area->fa_off should already be aligned. */
     aligned_off = FLOOR_ALIGN(off, FLASH_PROGRAM_UNIT);
     add_padding_size = off - aligned_off;
@@ -389,6 +539,10 @@ int flash_area_erase(const struct flash_area *area, uint32_t off, uint32_t len)
 
     BOOT_LOG_DBG("erase area=%d, off=%#x, len=%#x", area->fa_id, off, len);
 
+#if defined(PLATFORM_HAS_BOOT_DMA) && defined(BOOT_DMA_READ_AHEAD_SIZE)
+    read_ahead_invalidate();
+#endif /* PLATFORM_HAS_BOOT_DMA && BOOT_DMA_READ_AHEAD_SIZE */
+
     if (!is_range_valid(area, off, len)) {
         return -1;
     }
@@ -52,6 +52,11 @@ tfm_invalid_config(NOT TFM_CODE_SHARING STREQUAL "OFF" AND NOT TFM_PLATFORM IN_L
 tfm_invalid_config(NOT TFM_CODE_SHARING STREQUAL "OFF" AND CRYPTO_HW_ACCELERATOR)
 tfm_invalid_config(NOT TFM_CODE_SHARING STREQUAL "OFF" AND NOT C_COMPILER_ID:IAR)
 
+####################### Crypto #################################################
+
+tfm_invalid_config(CRYPTO_MVE_ACCELERATION AND CRYPTO_HW_ACCELERATOR)
+tfm_invalid_config(CRYPTO_MVE_ACCELERATION AND NOT CONFIG_TFM_ENABLE_MVE)
+
 ########################## Platform ############################################
 
 tfm_invalid_config(OTP_NV_COUNTERS_RAM_EMULATION AND NOT (PLATFORM_DEFAULT_OTP OR PLATFORM_DEFAULT_NV_COUNTERS))
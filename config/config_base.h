@@ -51,6 +51,40 @@
 #define CRYPTO_CONC_OPER_NUM                   8
 #endif
 
+/*
+ * The number of concurrent operations of each type served from a pool of
+ * contexts dedicated to that type, before using the shared pool
+ */
+#ifndef CRYPTO_CONC_CIPHER_OPER_NUM
+#define CRYPTO_CONC_CIPHER_OPER_NUM            0
+#endif
+#ifndef CRYPTO_CONC_MAC_OPER_NUM
+#define CRYPTO_CONC_MAC_OPER_NUM               0
+#endif
+#ifndef CRYPTO_CONC_HASH_OPER_NUM
+#define CRYPTO_CONC_HASH_OPER_NUM              0
+#endif
+#ifndef CRYPTO_CONC_KEY_DERIV_OPER_NUM
+#define CRYPTO_CONC_KEY_DERIV_OPER_NUM         0
+#endif
+#ifndef CRYPTO_CONC_AEAD_OPER_NUM
+#define CRYPTO_CONC_AEAD_OPER_NUM              0
+#endif
+
+/* The max number of concurrent operations a single secure partition can hold,
+ * 0 for all the contexts of the shared and dedicated pools
+ */
+#ifndef CRYPTO_CONC_OPER_NUM_PER_PARTITION
+#define CRYPTO_CONC_OPER_NUM_PER_PARTITION     0
+#endif
+
+/* The max number of concurrent operations a single NS client can hold,
+ * 0 for all the contexts of the shared and dedicated pools
+ */
+#ifndef CRYPTO_CONC_OPER_NUM_PER_NS_CLIENT
+#define CRYPTO_CONC_OPER_NUM_PER_NS_CLIENT     0
+#endif
+
 /* Enable PSA Crypto random number generator module */
 #ifndef CRYPTO_RNG_MODULE_ENABLED
 #define CRYPTO_RNG_MODULE_ENABLED              1
@@ -96,6 +130,16 @@
 #define CRYPTO_KEY_DERIVATION_MODULE_ENABLED   1
 #endif
 
+/* Enable PSA Crypto compound operations module */
+#ifndef CRYPTO_COMPOUND_MODULE_ENABLED
+#define CRYPTO_COMPOUND_MODULE_ENABLED         0
+#endif
+
+/* Size of the buffer holding the intermediate results of compound operations */
+#ifndef CRYPTO_COMPOUND_BUFFER_SIZE
+#define CRYPTO_COMPOUND_BUFFER_SIZE            512
+#endif
+
 /* Default size of the internal scratch buffer used for PSA FF IOVec allocations */
 #ifndef CRYPTO_IOVEC_BUFFER_SIZE
 #define CRYPTO_IOVEC_BUFFER_SIZE               5120
@@ -153,10 +197,26 @@
 #define ATTEST_INCLUDE_COSE_KEY_ID             0
 #endif
 
-/* The stack size of the Initial Attestation Secure Partition */
+/* Size of the cache of the claims encoded once for all the tokens */
+#ifndef ATTEST_CLAIM_CACHE_SIZE
+#define ATTEST_CLAIM_CACHE_SIZE                0
+#endif
+
+/* Maximal number of challenges bound to a batch token, 0 to disable */
+#ifndef ATTEST_BATCH_MAX_CHALLENGES
+#define ATTEST_BATCH_MAX_CHALLENGES            0
+#endif
+
+/* The stack size of the Initial Attestation Secure Partition, with room for
+ * the Merkle tree of the largest batch token when those are enabled
+ */
 #ifndef ATTEST_STACK_SIZE
+#if ATTEST_BATCH_MAX_CHALLENGES != 0
+#define ATTEST_STACK_SIZE                      0xC00
+#else
 #define ATTEST_STACK_SIZE                      0x800
 #endif
+#endif
 
 /* Set the initial attestation token profile */
 #if (!ATTEST_TOKEN_PROFILE_PSA_IOT_1) && \
@@ -302,6 +362,11 @@
 #endif
 #endif
 
+/* The maximal number of shared boot data TLV entries indexed by SPM */
+#ifndef CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM
+#define CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM      0
+#endif
+
 /* Disable the doorbell APIs */
 #ifndef CONFIG_TFM_DOORBELL_API
 #define CONFIG_TFM_DOORBELL_API                 0
@@ -8,6 +8,10 @@
 #ifndef __TFM_ATTEST_DEFS_H__
 #define __TFM_ATTEST_DEFS_H__
 
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/error.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -15,6 +19,38 @@ extern "C" {
 /* Initial Attestation message types that distinguish Attest services. */
 #define TFM_ATTEST_GET_TOKEN       1001
 #define TFM_ATTEST_GET_TOKEN_SIZE  1002
+#define TFM_ATTEST_GET_BATCH_TOKEN 1003
+
+/**
+ * \brief Get an initial attestation token bound to several challenges
+ *
+ * The nonce claim of the token is the root of a SHA-256 Merkle tree over the
+ * challenges, so that one signature serves several verifiers. The leaves are
+ * SHA-256(0x00 || challenge) in the order of \p challenges, an inner node is
+ * SHA-256(0x01 || left || right), and the last node of a level with an odd
+ * number of nodes is promoted to the next level unchanged. The caller holds
+ * all the challenges, so it computes the inclusion proof for each verifier
+ * from the siblings on the path from its leaf to the root.
+ *
+ * \param[in]  challenges       Buffer holding the challenges, one after the
+ *                              other.
+ * \param[in]  challenge_size   Size of each challenge in bytes. It must be a
+ *                              supported challenge size.
+ * \param[in]  challenge_count  Number of challenges.
+ * \param[out] token_buf        Buffer where the token will be stored.
+ * \param[in]  token_buf_size   Size of \p token_buf in bytes.
+ * \param[out] token_size       Size of the token in bytes.
+ *
+ * \return Returns error code as specified in \ref psa_status_t.
+ *         PSA_ERROR_NOT_SUPPORTED if the service doesn't accept batches.
+ */
+psa_status_t
+tfm_initial_attest_get_batch_token(const uint8_t *challenges,
+                                   size_t         challenge_size,
+                                   size_t         challenge_count,
+                                   uint8_t       *token_buf,
+                                   size_t         token_buf_size,
+                                   size_t        *token_size);
 
 #ifdef __cplusplus
 }
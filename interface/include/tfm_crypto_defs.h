@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -62,10 +62,92 @@ struct tfm_crypto_pack_iovec {
     };
 };
 
+/**
+ * \brief The maximum number of steps of a compound operation
+ */
+#define TFM_CRYPTO_COMPOUND_MAX_STEPS (4u)
+
+/**
+ * \brief The maximum number of data references consumed by a compound step
+ */
+#define TFM_CRYPTO_COMPOUND_MAX_REFS (3u)
+
+/**
+ * \brief Operations which can be chained as steps of a compound operation
+ */
+enum tfm_crypto_compound_op_t {
+    TFM_CRYPTO_COMPOUND_OP_NONE          = 0,
+    TFM_CRYPTO_COMPOUND_OP_HASH_COMPUTE  = 1, /*!< ref[0]: input */
+    TFM_CRYPTO_COMPOUND_OP_MAC_COMPUTE   = 2, /*!< ref[0]: input */
+    TFM_CRYPTO_COMPOUND_OP_SIGN_HASH     = 3, /*!< ref[0]: hash */
+    TFM_CRYPTO_COMPOUND_OP_VERIFY_HASH   = 4, /*!< ref[0]: hash,
+                                               *   ref[1]: signature
+                                               */
+    TFM_CRYPTO_COMPOUND_OP_AEAD_ENCRYPT  = 5, /*!< ref[0]: nonce,
+                                               *   ref[1]: additional data,
+                                               *   ref[2]: plaintext
+                                               */
+    TFM_CRYPTO_COMPOUND_OP_AEAD_DECRYPT  = 6, /*!< ref[0]: nonce,
+                                               *   ref[1]: additional data,
+                                               *   ref[2]: ciphertext
+                                               */
+    TFM_CRYPTO_COMPOUND_OP_IMPORT_KEY    = 7, /*!< ref[0]: key data,
+                                               *   produces a key
+                                               */
+    TFM_CRYPTO_COMPOUND_OP_DERIVE_KEY    = 8, /*!< ref[0]: salt, ref[1]: info,
+                                               *   the secret is the step key,
+                                               *   produces a key
+                                               */
+};
+
+/**
+ * \brief Where the data referenced by a compound step comes from
+ */
+enum tfm_crypto_compound_src_t {
+    TFM_CRYPTO_COMPOUND_SRC_NONE  = 0, /*!< No data, i.e. zero length */
+    TFM_CRYPTO_COMPOUND_SRC_INPUT = 1, /*!< Slice of the compound input */
+    TFM_CRYPTO_COMPOUND_SRC_STEP  = 2, /*!< Output of a previous step */
+};
+
+/**
+ * \brief Reference to the data consumed by a compound step
+ */
+struct tfm_crypto_compound_ref {
+    uint8_t source;   /*!< One of \ref tfm_crypto_compound_src_t */
+    uint8_t step;     /*!< Index of the step for TFM_CRYPTO_COMPOUND_SRC_STEP */
+    uint16_t offset;  /*!< Offset in the input for TFM_CRYPTO_COMPOUND_SRC_INPUT */
+    uint16_t length;  /*!< Length in the input for TFM_CRYPTO_COMPOUND_SRC_INPUT */
+    uint16_t reserved;
+};
+
+/**
+ * \brief Description of one step of a compound operation. Each step consumes
+ *        slices of the input or outputs of previous steps and produces either
+ *        data or a volatile key, which can in turn be referenced by the
+ *        following steps. Only the output of the last step is returned to the
+ *        caller, and the keys produced by the steps are destroyed when the
+ *        compound operation completes.
+ */
+struct tfm_crypto_compound_step {
+    uint16_t op;              /*!< One of \ref tfm_crypto_compound_op_t */
+    uint8_t key_source;       /*!< TFM_CRYPTO_COMPOUND_SRC_NONE to use
+                               *   \a key_id, TFM_CRYPTO_COMPOUND_SRC_STEP to
+                               *   use the key produced by \a key_step
+                               */
+    uint8_t key_step;         /*!< Index of the step producing the key */
+    psa_key_id_t key_id;      /*!< Key used by the step */
+    psa_algorithm_t alg;      /*!< Algorithm of the step */
+    psa_key_type_t key_type;  /*!< Type of the key produced by the step */
+    uint16_t key_bits;        /*!< Size of the key produced by the step */
+    psa_key_usage_t key_usage;/*!< Usage of the key produced by the step */
+    psa_algorithm_t key_alg;  /*!< Permitted algorithm of the key produced */
+    struct tfm_crypto_compound_ref ref[TFM_CRYPTO_COMPOUND_MAX_REFS];
+};
+
 /**
  * \brief Type associated to the group of a function encoding. There can be
- *        nine groups (Random, Key management, Hash, MAC, Cipher, AEAD,
- *        Asym sign, Asym encrypt, Key derivation).
+ *        ten groups (Random, Key management, Hash, MAC, Cipher, AEAD,
+ *        Asym sign, Asym encrypt, Key derivation, Compound).
  */
 enum tfm_crypto_group_id_t {
     TFM_CRYPTO_GROUP_ID_RANDOM          = UINT8_C(1),
@@ -76,7 +158,8 @@ enum tfm_crypto_group_id_t {
     TFM_CRYPTO_GROUP_ID_AEAD            = UINT8_C(6),
     TFM_CRYPTO_GROUP_ID_ASYM_SIGN       = UINT8_C(7),
     TFM_CRYPTO_GROUP_ID_ASYM_ENCRYPT    = UINT8_C(8),
-    TFM_CRYPTO_GROUP_ID_KEY_DERIVATION  = UINT8_C(9)
+    TFM_CRYPTO_GROUP_ID_KEY_DERIVATION  = UINT8_C(9),
+    TFM_CRYPTO_GROUP_ID_COMPOUND        = UINT8_C(10)
 };
 
 /* Set of X macros describing each of the available PSA Crypto APIs */
@@ -163,6 +246,9 @@ enum tfm_crypto_group_id_t {
     X(TFM_CRYPTO_KEY_DERIVATION_OUTPUT_KEY)        \
     X(TFM_CRYPTO_KEY_DERIVATION_ABORT)
 
+#define COMPOUND_FUNCS                             \
+    X(TFM_CRYPTO_COMPOUND_EXECUTE)
+
 #define BASE__VALUE(x) ((uint16_t)((((uint16_t)(x)) << 8) & 0xFF00))
 
 /**
@@ -197,6 +283,8 @@ enum tfm_crypto_func_sid_t {
     ASYM_ENCRYPT_FUNCS
     BASE__KEY_DERIVATION = BASE__VALUE(TFM_CRYPTO_GROUP_ID_KEY_DERIVATION) - 1,
     KEY_DERIVATION_FUNCS
+    BASE__COMPOUND       = BASE__VALUE(TFM_CRYPTO_GROUP_ID_COMPOUND) - 1,
+    COMPOUND_FUNCS
 #undef X
 };
 
@@ -207,6 +295,32 @@ enum tfm_crypto_func_sid_t {
 #define TFM_CRYPTO_GET_GROUP_ID(_function_id) \
     ((enum tfm_crypto_group_id_t)(((uint16_t)(_function_id) >> 8) & 0xFF))
 
+/**
+ * \brief Runs a list of crypto steps inside the Crypto service in a single
+ *        call, e.g. hash then sign, or derive a key then AEAD encrypt with
+ *        it, so that the intermediate results don't need to go back and
+ *        forth between the caller and the service.
+ *
+ * \param[in]  steps         Array of steps to run in order
+ * \param[in]  step_count    Number of steps, at most
+ *                           \ref TFM_CRYPTO_COMPOUND_MAX_STEPS
+ * \param[in]  input         Buffer holding the data sliced by the steps
+ * \param[in]  input_length  Size of \p input
+ * \param[out] output        Buffer to hold the output of the last step
+ * \param[in]  output_size   Size of \p output
+ * \param[out] output_length Length of the output of the last step
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_compound_execute(
+                                const struct tfm_crypto_compound_step *steps,
+                                size_t step_count,
+                                const uint8_t *input,
+                                size_t input_length,
+                                uint8_t *output,
+                                size_t output_size,
+                                size_t *output_length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -69,3 +69,42 @@ psa_initial_attest_get_token_size(size_t  challenge_size,
 
     return status;
 }
+
+psa_status_t
+tfm_initial_attest_get_batch_token(const uint8_t *challenges,
+                                   size_t         challenge_size,
+                                   size_t         challenge_count,
+                                   uint8_t       *token_buf,
+                                   size_t         token_buf_size,
+                                   size_t        *token_size)
+{
+    psa_status_t status;
+    rot_size_t challenge_size_param;
+
+    psa_invec in_vec[] = {
+        {challenges, challenge_size * challenge_count},
+        {&challenge_size_param, sizeof(challenge_size_param)}
+    };
+    psa_outvec out_vec[] = {
+        {token_buf, token_buf_size}
+    };
+
+    if ((challenge_size == 0) || (challenge_size > ROT_SIZE_MAX) ||
+        (challenge_count == 0) ||
+        (challenge_count > SIZE_MAX / challenge_size) ||
+        (token_size == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    challenge_size_param = (rot_size_t)challenge_size;
+
+    status = psa_call(TFM_ATTESTATION_SERVICE_HANDLE,
+                      TFM_ATTEST_GET_BATCH_TOKEN,
+                      in_vec, IOVEC_LEN(in_vec),
+                      out_vec, IOVEC_LEN(out_vec));
+
+    if (status == PSA_SUCCESS) {
+        *token_size = out_vec[0].len;
+    }
+
+    return status;
+}
@@ -1717,3 +1717,40 @@ TFM_CRYPTO_API(void, psa_reset_key_attributes)(
 {
     memset(attributes, 0, sizeof(*attributes));
 }
+
+psa_status_t tfm_crypto_compound_execute(
+                                const struct tfm_crypto_compound_step *steps,
+                                size_t step_count,
+                                const uint8_t *input,
+                                size_t input_length,
+                                uint8_t *output,
+                                size_t output_size,
+                                size_t *output_length)
+{
+    psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_COMPOUND_EXECUTE_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = steps, .len = step_count * sizeof(*steps)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = output, .len = output_size},
+    };
+
+    if ((steps == NULL) || (step_count == 0) ||
+        (step_count > TFM_CRYPTO_COMPOUND_MAX_STEPS)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = API_DISPATCH(in_vec, out_vec);
+
+    if (output_length != NULL) {
+        *output_length = out_vec[0].len;
+    }
+
+    return status;
+}
@@ -10,8 +10,19 @@
 #include <stddef.h>
 #include "region_defs.h"
 #include "cc3xx_init.h"
+#include "cc3xx_rng.h"
+#include "cc3xx_config.h"
 #include "device_definition.h"
 
+/* Every update of a multipart operation is a separate request to the crypto
+ * service, and the engine is shared with other partitions which can't write
+ * to the contexts of this one, so there is nothing a resident context could
+ * be reused by at runtime.
+ */
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+#error "CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE is not supported by the runtime crypto service"
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+
 int crypto_hw_accelerator_init(void)
 {
     return cc3xx_lowlevel_init();
@@ -22,6 +33,21 @@ int crypto_hw_accelerator_finish(void)
     return cc3xx_lowlevel_uninit();
 }
 
+int crypto_hw_accelerator_request_done(void)
+{
+#ifdef CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE
+    /* Top up the pool now rather than when a later request seeds a DRBG. A
+     * failed refill leaves the pool empty, and the entropy is then collected
+     * on demand, so it doesn't fail the request that has just completed.
+     */
+    if (cc3xx_lowlevel_rng_entropy_pool_needs_refill()) {
+        (void)cc3xx_lowlevel_rng_refill_entropy_pool();
+    }
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE */
+
+    return 0;
+}
+
 int fih_delay_init(void)
 {
     return 0;
@@ -29,6 +29,15 @@ int crypto_hw_accelerator_init(void);
  */
 int crypto_hw_accelerator_finish(void);
 
+/**
+ * \brief Called by the crypto service at the end of each request, for the
+ *        accelerator to do any housekeeping which doesn't need to delay the
+ *        response, e.g. refilling its entropy pool.
+ *
+ * \return 0 on success, non-zero otherwise
+ */
+int crypto_hw_accelerator_request_done(void);
+
 /*
  * \brief  This function performs key derivation
  *
@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "region_defs.h"
+#include "tfm_hal_device_header.h"
+#include "tfm_boot_status.h"
+#include "tfm_boot_timeline.h"
+
+static struct boot_timeline_event timeline[BOOT_TIMELINE_MAX_EVENTS];
+static uint32_t timeline_len;
+
+__WEAK uint32_t boot_timeline_get_timestamp(void)
+{
+#if defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+void boot_timeline_record(uint8_t event, uint16_t arg)
+{
+    if (timeline_len >= BOOT_TIMELINE_MAX_EVENTS) {
+        return;
+    }
+
+    timeline[timeline_len].event = event;
+    timeline[timeline_len].reserved = 0;
+    timeline[timeline_len].arg = arg;
+    timeline[timeline_len].timestamp = boot_timeline_get_timestamp();
+    timeline_len++;
+}
+
+int boot_timeline_save(uint8_t stage)
+{
+    struct shared_data_tlv_entry tlv_entry;
+    struct tfm_boot_data *boot_data;
+    size_t size = timeline_len * sizeof(timeline[0]);
+    uintptr_t offset;
+
+    boot_data = (struct tfm_boot_data *)SHARED_BOOT_MEASUREMENT_BASE;
+
+    /* The first stage to save data initialises the shared area */
+    if ((boot_data->header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) ||
+        (boot_data->header.tlv_tot_len > SHARED_BOOT_MEASUREMENT_SIZE)) {
+        memset((void *)SHARED_BOOT_MEASUREMENT_BASE, 0,
+               SHARED_BOOT_MEASUREMENT_SIZE);
+        boot_data->header.tlv_magic   = SHARED_DATA_TLV_INFO_MAGIC;
+        boot_data->header.tlv_tot_len = SHARED_DATA_HEADER_SIZE;
+    }
+
+    /* Check overflow of the shared data area */
+    if ((SHARED_DATA_ENTRY_SIZE(size) + boot_data->header.tlv_tot_len) >
+        SHARED_BOOT_MEASUREMENT_SIZE) {
+        return -1;
+    }
+
+    tlv_entry.tlv_type = SET_TLV_TYPE(TLV_MAJOR_BTL, stage);
+    tlv_entry.tlv_len  = (uint16_t)size;
+
+    offset = SHARED_BOOT_MEASUREMENT_BASE + boot_data->header.tlv_tot_len;
+    memcpy((void *)offset, &tlv_entry, SHARED_DATA_ENTRY_HEADER_SIZE);
+
+    offset += SHARED_DATA_ENTRY_HEADER_SIZE;
+    memcpy((void *)offset, timeline, size);
+
+    boot_data->header.tlv_tot_len += SHARED_DATA_ENTRY_SIZE(size);
+
+    return 0;
+}
@@ -162,6 +162,50 @@ void cc3xx_lowlevel_aes_get_state(struct cc3xx_aes_state_t *state);
  */
 cc3xx_err_t cc3xx_lowlevel_aes_set_state(const struct cc3xx_aes_state_t *state);
 
+/**
+ * @brief                        Load a multipart AES state into the engine at
+ *                               the start of an operation step. If the state
+ *                               was left loaded by
+ *                               cc3xx_lowlevel_aes_put_state and no other user
+ *                               has needed the engine since, nothing is
+ *                               reloaded.
+ *
+ * @param[in]  state            The cc3xx_aes_state_t of the operation.
+ *
+ * @return                       CC3XX_ERR_SUCCESS on success, another
+ *                               cc3xx_err_t on error.
+ */
+cc3xx_err_t cc3xx_lowlevel_aes_load_state(struct cc3xx_aes_state_t *state);
+
+/**
+ * @brief                        Release the engine at the end of an operation
+ *                               step. With CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+ *                               the state, including the key, stays loaded and
+ *                               is only written back to state when another
+ *                               user needs the engine. Otherwise it is written
+ *                               back and the engine is uninitialized straight
+ *                               away.
+ *
+ * @note                         state must stay at the same address until it
+ *                               is loaded again, discarded, or written back
+ *                               by cc3xx_lowlevel_uninit(). The caller must
+ *                               do the latter before returning to code which
+ *                               can't write to state.
+ *
+ * @param[out] state            The cc3xx_aes_state_t of the operation.
+ */
+void cc3xx_lowlevel_aes_put_state(struct cc3xx_aes_state_t *state);
+
+/**
+ * @brief                        Drop state from the engine without writing it
+ *                               back, if it is still loaded. Must be called
+ *                               before a state left loaded by
+ *                               cc3xx_lowlevel_aes_put_state is freed.
+ *
+ * @param[in]  state            The cc3xx_aes_state_t of the operation.
+ */
+void cc3xx_lowlevel_aes_discard_state(const struct cc3xx_aes_state_t *state);
+
 /**
  * @brief                        Set the length of the tag produced or verified
  *                               by AEAD/MAC modes.
@@ -214,6 +258,18 @@ void cc3xx_lowlevel_aes_set_output_buffer(uint8_t *out, size_t out_len);
  */
 cc3xx_err_t cc3xx_lowlevel_aes_update(const uint8_t* in, size_t in_len);
 
+/**
+ * @brief                        Input a list of fragments to be
+ *                               encrypted/decrypted into an AES operation, as
+ *                               if they were one contiguous buffer. The output
+ *                               is contiguous.
+
+ * @param[in]  iov               The fragments to be input, in order.
+ * @param[in]  iov_len           The amount of fragments.
+ */
+cc3xx_err_t cc3xx_lowlevel_aes_update_iovec(const struct cc3xx_dma_iovec_t *iov,
+                                            size_t iov_len);
+
 /**
  * @brief                        Input data to be authenticated, but not
  *                               encrypted or decrypted into an AEAD/MAC
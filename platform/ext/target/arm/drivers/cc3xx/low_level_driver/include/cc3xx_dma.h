@@ -18,6 +18,24 @@
 
 #define CC3XX_DMA_BLOCK_BUF_MAX_SIZE 64
 
+/**
+ * @brief             A fragment of DMA input.
+ */
+struct cc3xx_dma_iovec_t {
+    const void *buf;  /*!< The start of the fragment */
+    size_t len;       /*!< The size of the fragment in bytes */
+};
+
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+/**
+ * @brief             Called from cc3xx_lowlevel_dma_irq_handler() when an
+ *                    asynchronous transfer has completed.
+ *
+ * @param[in]  ctx    The context passed to cc3xx_lowlevel_dma_set_async().
+ */
+typedef void (*cc3xx_dma_completion_callback_t)(void *ctx);
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
 struct cc3xx_dma_state_t {
     uint8_t block_buf[CC3XX_DMA_BLOCK_BUF_MAX_SIZE];
     size_t block_buf_size_in_use;
@@ -119,6 +137,26 @@ void cc3xx_lowlevel_dma_copy_data(void* dest, const void* src, size_t length);
 cc3xx_err_t cc3xx_lowlevel_dma_buffered_input_data(const void* buf, size_t length,
                                                    bool write_output);
 
+/**
+ * @brief             Input a list of fragments as if they were one contiguous
+ *                    buffer. Whole blocks are input directly from each
+ *                    fragment, and only a block which straddles two fragments
+ *                    is copied into the block buffer. As with
+ *                    cc3xx_lowlevel_dma_buffered_input_data(),
+ *                    cc3xx_dma_flush_buffer must be called to ensure all data
+ *                    is processed.
+ *
+ * @param[in]  iov          The fragments to input, in order.
+ * @param[in]  iov_len      The amount of fragments.
+ * @param[in]  write_output Whether the data should be output from the engine.
+ *
+ * @return            CC3XX_ERR_SUCCESS on success, another cc3xx_err_t on
+ *                    error.
+ */
+cc3xx_err_t cc3xx_lowlevel_dma_buffered_input_iovec(const struct cc3xx_dma_iovec_t *iov,
+                                                    size_t iov_len,
+                                                    bool write_output);
+
 /**
  * @brief             Flush the DMA buffer. Engine setup is not saved with the
  *                    DMA buffer, so the engine must be configured correctly
@@ -149,6 +187,49 @@ void cc3xx_lowlevel_dma_set_buffer_size(size_t size);
  */
 void cc3xx_lowlevel_dma_set_output(void* buf, size_t length);
 
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+/**
+ * @brief              Enable or disable asynchronous DMA. While enabled, the
+ *                     bulk transfers started by
+ *                     cc3xx_lowlevel_dma_buffered_input_data() are left
+ *                     running when it returns, so the caller can do other
+ *                     work until the completion callback is called from
+ *                     cc3xx_lowlevel_dma_irq_handler(). The input and output
+ *                     buffers must not be accessed until then. Any later
+ *                     driver call which needs the DMA or the engine state
+ *                     waits for the transfer first, and the setting is cleared
+ *                     by cc3xx_lowlevel_dma_uninit().
+ *
+ * @param[in]  callback The function to call on completion, or NULL to make
+ *                      transfers synchronous again.
+ * @param[in]  ctx      The context to pass to the callback.
+ */
+void cc3xx_lowlevel_dma_set_async(cc3xx_dma_completion_callback_t callback,
+                                  void *ctx);
+
+/**
+ * @brief             Handle the CC3XX DMA completion interrupt. This must be
+ *                    called from the CC3XX interrupt handler of the platform
+ *                    when asynchronous DMA is used.
+ */
+void cc3xx_lowlevel_dma_irq_handler(void);
+
+/**
+ * @brief             Check whether an asynchronous transfer is in flight.
+ *
+ * @return            true if a transfer has not yet completed.
+ */
+bool cc3xx_lowlevel_dma_is_busy(void);
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
+/**
+ * @brief             Wait for any asynchronous transfer to complete. The
+ *                    completion callback is not called for a transfer which is
+ *                    completed by this function. Returns immediately if
+ *                    asynchronous DMA is not enabled.
+ */
+void cc3xx_lowlevel_dma_wait_for_completion(void);
+
 /**
  * @brief                       Uninitialize the DMA.
  *
@@ -107,6 +107,21 @@ typedef enum {
 #define CC3XX_EC_MAX_BARRETT_TAG_SIZE 0
 #endif
 
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+/**
+ * @brief Precomputed comb table for multiplying the generator of a curve
+ *
+ * Entry e of the table is the affine point sum((2 * e_r - 1) * 2^(r * spacing) * G)
+ * for r from 0 to 3, where e_r is bit r of e. Entries are stored in order, each
+ * as the x then the y coordinate, both as little-endian words of the curve
+ * modulus size.
+ */
+typedef struct {
+    size_t spacing;
+    const uint32_t *points;
+} cc3xx_ec_comb_table_t;
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
+
 /**
  * @brief Structure describing Elliptic Curve parameters
  *
@@ -130,6 +145,10 @@ typedef struct {
 
     uint32_t order[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
     uint32_t cofactor;
+
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+    const cc3xx_ec_comb_table_t *generator_comb; /*!< NULL if not available */
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
 } cc3xx_ec_curve_data_t;
 
 extern const cc3xx_ec_curve_data_t secp_192_r1;
@@ -68,6 +68,20 @@ cc3xx_err_t cc3xx_lowlevel_hash_init(cc3xx_hash_alg_t alg);
  */
 cc3xx_err_t cc3xx_lowlevel_hash_update(const uint8_t *buf, size_t length);
 
+/**
+ * @brief                        Input a list of fragments into a hash
+ *                               operation, as if they were one contiguous
+ *                               buffer.
+ *
+ * @param[in]  iov               The fragments to be input, in order.
+ * @param[in]  iov_len           The amount of fragments.
+ *
+ * @return                       CC3XX_ERR_SUCCESS on success, another
+ *                               cc3xx_err_t on error.
+ */
+cc3xx_err_t cc3xx_lowlevel_hash_update_iovec(const struct cc3xx_dma_iovec_t *iov,
+                                             size_t iov_len);
+
 /**
  * @brief                        Get the current state of the hash operation.
  *                               Allows for restartable hash operations.
@@ -87,6 +101,57 @@ void cc3xx_lowlevel_hash_get_state(struct cc3xx_hash_state_t *state);
  */
 void cc3xx_lowlevel_hash_set_state(const struct cc3xx_hash_state_t *state);
 
+/**
+ * @brief                        Load a multipart hash state into the engine
+ *                               at the start of an operation step. If the
+ *                               state was left loaded by
+ *                               cc3xx_lowlevel_hash_put_state and no other
+ *                               user has needed the engine since, nothing is
+ *                               reloaded.
+ *
+ * @param[in]  state             The cc3xx_hash_state_t of the operation.
+ */
+void cc3xx_lowlevel_hash_load_state(struct cc3xx_hash_state_t *state);
+
+/**
+ * @brief                        Release the engine at the end of an operation
+ *                               step. With CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+ *                               the state stays loaded, and is only written
+ *                               back to state when another user needs the
+ *                               engine. Otherwise it is written back and the
+ *                               engine is uninitialized straight away.
+ *
+ * @note                         state must stay at the same address until it
+ *                               is loaded again, discarded, or written back
+ *                               by cc3xx_lowlevel_uninit(). The caller must
+ *                               do the latter before returning to code which
+ *                               can't write to state.
+ *
+ * @param[out] state             The cc3xx_hash_state_t of the operation.
+ */
+void cc3xx_lowlevel_hash_put_state(struct cc3xx_hash_state_t *state);
+
+/**
+ * @brief                        Copy a multipart hash state, taking the
+ *                               context from the engine if src is still
+ *                               loaded there. src stays loaded.
+ *
+ * @param[out] dst               The cc3xx_hash_state_t to copy into.
+ * @param[in]  src               The cc3xx_hash_state_t to copy from.
+ */
+void cc3xx_lowlevel_hash_copy_state(struct cc3xx_hash_state_t *dst,
+                                    const struct cc3xx_hash_state_t *src);
+
+/**
+ * @brief                        Drop state from the engine without writing it
+ *                               back, if it is still loaded. Must be called
+ *                               before a state left loaded by
+ *                               cc3xx_lowlevel_hash_put_state is freed.
+ *
+ * @param[in]  state             The cc3xx_hash_state_t of the operation.
+ */
+void cc3xx_lowlevel_hash_discard_state(const struct cc3xx_hash_state_t *state);
+
 /**
  * @brief                        Finish a hash operation, and output the hash.
  *
@@ -26,7 +26,10 @@ extern "C" {
 cc3xx_err_t cc3xx_lowlevel_init(void);
 
 /**
- * @brief                        Uninitialize the CC3XX accelerator.
+ * @brief                        Uninitialize the CC3XX accelerator. Also
+ *                               writes back any multipart context left
+ *                               loaded in the engine, see
+ *                               CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE.
  *
  * @return                       CC3XX_ERR_SUCCESS on success, another
  *                               cc3xx_err_t on error.
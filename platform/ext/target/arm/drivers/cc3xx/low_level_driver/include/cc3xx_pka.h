@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "cc3xx_config.h"
 #include "cc3xx_error.h"
 
 #define CC3XX_PKA_REG_N  0
@@ -28,6 +29,14 @@ struct cc3xx_pka_state_t {
     uint32_t virt_reg_next_mapped;
 };
 
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+struct cc3xx_pka_reg_stats_t {
+    uint32_t maps;      /*!< Virtual registers mapped onto a physical register */
+    uint32_t evictions; /*!< Mappings evicted to make space for another one */
+    uint32_t flushes;   /*!< Calls to cc3xx_lowlevel_pka_unmap_physical_registers */
+};
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
+
 /**
  * @brief                       Initialize the PKA engine.
  *
@@ -187,6 +196,21 @@ void cc3xx_lowlevel_pka_set_state(const struct cc3xx_pka_state_t *state,
                                   uint32_t load_reg_am, cc3xx_pka_reg_id_t *load_reg_list,
                                   const uint32_t **load_reg_ptr_list,
                                   const size_t *load_reg_size_list);
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+/**
+ * @brief                       Get the physical register mapping counters,
+ *                              accumulated since the last reset.
+ *
+ * @param[out] stats            The structure to copy the counters into.
+ */
+void cc3xx_lowlevel_pka_get_reg_stats(struct cc3xx_pka_reg_stats_t *stats);
+
+/**
+ * @brief                       Reset the physical register mapping counters.
+ */
+void cc3xx_lowlevel_pka_reset_reg_stats(void);
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
+
 /**
  * @brief Getter function to return the value of the register size currently
  *        configured on the PKA engine
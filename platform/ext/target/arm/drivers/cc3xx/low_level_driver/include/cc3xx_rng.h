@@ -107,6 +107,11 @@ void cc3xx_lowlevel_rng_set_hw_test_bypass(bool bypass_autocorr, bool bypass_crn
 /**
  * @brief                        Requires an amount of entropy from the TRNG
  *
+ * @note                         If \a CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE is
+ *                               set, the request is served from the entropy
+ *                               pool when it holds enough, and collected from
+ *                               the TRNG otherwise.
+ *
  * @param[out] entropy           Buffer containing the requested entropy
  * @param[in]  entropy_len       Size in bytes of the \p entropy buffer. Must be an
  *                               integer multiple of \def CC3XX_RNG_ENTROPY_SIZE
@@ -116,6 +121,38 @@ void cc3xx_lowlevel_rng_set_hw_test_bypass(bool bypass_autocorr, bool bypass_crn
  */
 cc3xx_err_t cc3xx_lowlevel_rng_get_entropy(uint32_t *entropy, size_t entropy_len);
 
+/**
+ * @brief                        Tops up the entropy pool from the TRNG, so
+ *                               that later calls to
+ *                               \a cc3xx_lowlevel_rng_get_entropy are served
+ *                               from memory. Intended to be called when the
+ *                               caller is otherwise idle, e.g. from a deferred
+ *                               low priority context, when
+ *                               \a cc3xx_lowlevel_rng_entropy_pool_needs_refill
+ *                               returns true.
+ *
+ * @note                         Only available when
+ *                               \a CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE is set.
+ *                               Like every other API in this driver, it must
+ *                               not preempt another call into the driver.
+ *
+ * @return                       CC3XX_ERR_SUCCESS on success, another
+ *                               cc3xx_err_t on error, in which case the pool
+ *                               is emptied.
+ */
+cc3xx_err_t cc3xx_lowlevel_rng_refill_entropy_pool(void);
+
+/**
+ * @brief                        Checks whether the entropy pool has dropped
+ *                               below \a CC3XX_CONFIG_RNG_ENTROPY_POOL_LOW_WATER_MARK
+ *
+ * @note                         Only available when
+ *                               \a CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE is set.
+ *
+ * @return                       true if the pool should be refilled
+ */
+bool cc3xx_lowlevel_rng_entropy_pool_needs_refill(void);
+
 /**
  * @brief                        Get random bytes from the CC3XX TRNG.
  *
@@ -466,7 +466,9 @@ cc3xx_err_t cc3xx_lowlevel_aes_init(
     }
 #endif /* CC3XX_CONFIG_DFA_MITIGATIONS_ENABLE */
 
-    /* Get a clean starting state */
+    /* Get a clean starting state. This also writes back any context left
+     * loaded in the engine.
+     */
     cc3xx_lowlevel_aes_uninit();
 
     aes_state.mode = mode;
@@ -533,6 +535,8 @@ cc3xx_err_t cc3xx_lowlevel_aes_init(
 
 void cc3xx_lowlevel_aes_get_state(struct cc3xx_aes_state_t *state)
 {
+    cc3xx_lowlevel_dma_wait_for_completion();
+
 #ifdef CC3XX_CONFIG_DPA_MITIGATIONS_ENABLE
     memcpy(state, &aes_state, sizeof(*state));
     cc3xx_dpa_hardened_word_copy(state->key_buf,
@@ -567,6 +571,10 @@ cc3xx_err_t cc3xx_lowlevel_aes_set_state(const struct cc3xx_aes_state_t *state)
 {
     cc3xx_err_t err;
 
+    cc3xx_lowlevel_engine_evict();
+
+    cc3xx_lowlevel_dma_wait_for_completion();
+
 #ifdef CC3XX_CONFIG_DPA_MITIGATIONS_ENABLE
     memcpy(&aes_state, state, sizeof(*state));
     cc3xx_dpa_hardened_word_copy(aes_state.key_buf,
@@ -608,6 +616,43 @@ cc3xx_err_t cc3xx_lowlevel_aes_set_state(const struct cc3xx_aes_state_t *state)
     return CC3XX_ERR_SUCCESS;
 }
 
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+static void aes_evict(void *ctx)
+{
+    cc3xx_lowlevel_aes_get_state(ctx);
+    cc3xx_lowlevel_aes_uninit();
+}
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+
+cc3xx_err_t cc3xx_lowlevel_aes_load_state(struct cc3xx_aes_state_t *state)
+{
+    if (cc3xx_lowlevel_engine_is_resident(state)) {
+        /* Still loaded, and owned by the caller until it puts it back */
+        cc3xx_lowlevel_engine_clear_resident();
+        return CC3XX_ERR_SUCCESS;
+    }
+
+    return cc3xx_lowlevel_aes_set_state(state);
+}
+
+void cc3xx_lowlevel_aes_put_state(struct cc3xx_aes_state_t *state)
+{
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+    cc3xx_lowlevel_engine_set_resident(state, aes_evict);
+#else
+    cc3xx_lowlevel_aes_get_state(state);
+    cc3xx_lowlevel_aes_uninit();
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+}
+
+void cc3xx_lowlevel_aes_discard_state(const struct cc3xx_aes_state_t *state)
+{
+    if (cc3xx_lowlevel_engine_is_resident(state)) {
+        cc3xx_lowlevel_engine_clear_resident();
+        cc3xx_lowlevel_aes_uninit();
+    }
+}
+
 void cc3xx_lowlevel_aes_set_output_buffer(uint8_t *out, size_t out_len)
 {
     cc3xx_lowlevel_dma_set_output(out, out_len);
@@ -783,6 +828,8 @@ void cc3xx_lowlevel_aes_update_authed_data(const uint8_t* in, size_t in_len)
 {
     bool write_output;
 
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     if (in_len == 0) {
         return;
     }
@@ -869,9 +916,24 @@ static void configure_engine_for_crypted_data(bool *write_output)
 }
 
 cc3xx_err_t cc3xx_lowlevel_aes_update(const uint8_t* in, size_t in_len)
+{
+    const struct cc3xx_dma_iovec_t iov = {
+        .buf = in,
+        .len = in_len,
+    };
+
+    return cc3xx_lowlevel_aes_update_iovec(&iov, 1);
+}
+
+cc3xx_err_t cc3xx_lowlevel_aes_update_iovec(const struct cc3xx_dma_iovec_t *iov,
+                                            size_t iov_len)
 {
     cc3xx_err_t err;
     bool write_output;
+    size_t in_len = 0;
+    size_t idx;
+
+    cc3xx_lowlevel_dma_wait_for_completion();
 
     /* MAC modes have no concept of encryption/decryption
      * so cc3xx_lowlevel_aes_update is a no-op.
@@ -922,8 +984,12 @@ cc3xx_err_t cc3xx_lowlevel_aes_update(const uint8_t* in, size_t in_len)
 
     configure_engine_for_crypted_data(&write_output);
 
+    for (idx = 0; idx < iov_len; idx++) {
+        in_len += iov[idx].len;
+    }
+
     aes_state.crypted_length += in_len;
-    err = cc3xx_lowlevel_dma_buffered_input_data(in, in_len, write_output);
+    err = cc3xx_lowlevel_dma_buffered_input_iovec(iov, iov_len, write_output);
     if (err != CC3XX_ERR_SUCCESS) {
         return err;
     }
@@ -1063,6 +1129,8 @@ cc3xx_err_t cc3xx_lowlevel_aes_finish(uint32_t *tag, size_t *size)
     cc3xx_err_t err = CC3XX_ERR_SUCCESS;
     bool write_output;
 
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     /* Check alignment */
 #ifdef CC3XX_CONFIG_STRICT_UINT32_T_ALIGNMENT
     assert(((uintptr_t)tag & 0b11) == 0);
@@ -1153,6 +1221,11 @@ cc3xx_err_t cc3xx_lowlevel_aes_finish(uint32_t *tag, size_t *size)
 void cc3xx_lowlevel_aes_uninit(void)
 {
     static const uint32_t zero_block[AES_BLOCK_SIZE / sizeof(uint32_t)] = {0};
+
+    cc3xx_lowlevel_engine_evict();
+
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     memset(&aes_state, 0, sizeof(struct cc3xx_aes_state_t));
 
     set_iv(zero_block);
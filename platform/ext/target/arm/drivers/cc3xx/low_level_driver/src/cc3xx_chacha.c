@@ -177,6 +177,8 @@ cc3xx_err_t cc3xx_lowlevel_chacha20_init(
 
 void cc3xx_lowlevel_chacha20_get_state(struct cc3xx_chacha_state_t *state)
 {
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     memcpy(state, &chacha_state, sizeof(struct cc3xx_chacha_state_t));
     memcpy(&state->dma_state, &dma_state, sizeof(dma_state));
 
@@ -192,6 +194,10 @@ void cc3xx_lowlevel_chacha20_get_state(struct cc3xx_chacha_state_t *state)
 
 void cc3xx_lowlevel_chacha20_set_state(const struct cc3xx_chacha_state_t *state)
 {
+    cc3xx_lowlevel_engine_evict();
+
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     memcpy(&chacha_state, state, sizeof(struct cc3xx_chacha_state_t));
     memcpy(&dma_state, &state->dma_state, sizeof(dma_state));
 
@@ -245,6 +251,8 @@ cc3xx_err_t cc3xx_lowlevel_chacha20_update(const uint8_t* in, size_t in_len)
     uint32_t pad_len;
 #endif /* CC3XX_CONFIG_CHACHA_POLY1305_ENABLE */
 
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     if (in_len == 0) {
         return CC3XX_ERR_SUCCESS;
     }
@@ -297,6 +305,8 @@ cc3xx_err_t cc3xx_lowlevel_chacha20_update(const uint8_t* in, size_t in_len)
     if (chacha_state.mode == CC3XX_CHACHA_MODE_CHACHA_POLY1305 &&
         chacha_state.direction == CC3XX_CHACHA_DIRECTION_ENCRYPT &&
         bytes_outputted_from_dma > 0) {
+        /* The output has to have been written before it can be authenticated */
+        cc3xx_lowlevel_dma_wait_for_completion();
         cc3xx_lowlevel_poly1305_update((uint8_t *)(dma_state.output_addr - bytes_outputted_from_dma),
                                        bytes_outputted_from_dma);
     }
@@ -346,6 +356,8 @@ cc3xx_err_t cc3xx_lowlevel_chacha20_finish(uint32_t *tag, size_t *size)
 #endif /* CC3XX_CONFIG_CHACHA_POLY1305_ENABLE */
     cc3xx_err_t err;
 
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     /* Check alignment */
 #ifdef CC3XX_CONFIG_STRICT_UINT32_T_ALIGNMENT
     assert(((uintptr_t)tag & 0b11) == 0);
@@ -402,6 +414,11 @@ cc3xx_err_t cc3xx_lowlevel_chacha20_finish(uint32_t *tag, size_t *size)
 void cc3xx_lowlevel_chacha20_uninit(void)
 {
     uint32_t zero_iv[3] = {0};
+
+    cc3xx_lowlevel_engine_evict();
+
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     memset(&chacha_state, 0, sizeof(chacha_state));
 
 #if defined(CC3XX_CONFIG_CHACHA_POLY1305_ENABLE)
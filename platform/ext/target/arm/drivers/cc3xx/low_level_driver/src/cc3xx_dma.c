@@ -24,6 +24,26 @@
 
 struct cc3xx_dma_state_t dma_state;
 
+#if defined(CC3XX_CONFIG_HW_VERSION_CC310)
+/* DOUT_TO_MEM_INT if the transfer writes output, otherwise MEM_TO_DIN_INT */
+#define DMA_COMPLETION_INT(has_output) ((has_output) ? 0x80U : 0x40U)
+#else
+/* SYM_DMA_COMPLETED */
+#define DMA_COMPLETION_INT(has_output) (0x800U)
+#endif /* CC3XX_CONFIG_HW_VERSION_CC310 */
+
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+/* Kept out of dma_state, as that is saved and restored with the engine state */
+static struct {
+    cc3xx_dma_completion_callback_t callback;
+    void *ctx;
+    volatile bool in_flight;
+    bool has_output;
+    uintptr_t output_addr;
+    size_t output_size;
+} async_state;
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
 #ifdef CC3XX_CONFIG_DMA_REMAP_ENABLE
 static cc3xx_dma_remap_region_t remap_regions[CC3XX_CONFIG_DMA_REMAP_REGION_AM] = {0};
 
@@ -68,48 +88,115 @@ static uintptr_t remap_addr(uintptr_t addr) {
 
 #endif /* CC3XX_CONFIG_DMA_REMAP_ENABLE */
 
-static void wait_for_dma_complete(void) {
-#if defined(CC3XX_CONFIG_HW_VERSION_CC310)
-    if (dma_state.block_buf_needs_output) {
-        /* Wait for DOUT_TO_MEM_INT */
-        while (!(P_CC3XX->host_rgf.host_rgf_irr & 0x80U)) {
-#ifdef CC3XX_CONFIG_DMA_WFI_WAIT_ENABLE
-            __asm("WFI");
-#endif /* CC3XX_CONFIG_WFI_WAIT_ENABLE */
-        }
+static void wait_for_dma_complete(bool has_output) {
+    uint32_t completion_int = DMA_COMPLETION_INT(has_output);
 
-        /* Reset DOUT_TO_MEM_INT interrupt */
-        P_CC3XX->host_rgf.host_rgf_icr = 0x80U;
-    } else {
-        /* Wait for MEM_TO_DIN_INT */
-        while (!(P_CC3XX->host_rgf.host_rgf_irr & 0x40U)) {
-#ifdef CC3XX_CONFIG_DMA_WFI_WAIT_ENABLE
-            __asm("WFI");
-#endif /* CC3XX_CONFIG_WFI_WAIT_ENABLE */
-        }
+    /* Only used to select the completion interrupt on CC310 */
+    (void)has_output;
 
-        /* Reset MEM_TO_DIN_INT interrupt */
-        P_CC3XX->host_rgf.host_rgf_icr = 0x40U;
-    }
-#else
     /* Wait for the DMA to complete (The SYM_DMA_COMPLETED interrupt to be
-     * asserted)
+     * asserted, or on CC310 DOUT_TO_MEM_INT or MEM_TO_DIN_INT)
      */
-    while (!(P_CC3XX->host_rgf.host_rgf_irr & 0x800U)) {
+    while (!(P_CC3XX->host_rgf.host_rgf_irr & completion_int)) {
 #ifdef CC3XX_CONFIG_DMA_WFI_WAIT_ENABLE
         __asm("WFI");
 #endif /* CC3XX_CONFIG_WFI_WAIT_ENABLE */
     }
 
-    /* Reset the SYM_DMA_COMPLETED interrupt */
-    P_CC3XX->host_rgf.host_rgf_icr = 0x800U;
-#endif /* CC3XX_CONFIG_HW_VERSION_CC310 */
+    /* Reset the interrupt */
+    P_CC3XX->host_rgf.host_rgf_icr = completion_int;
+}
+
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+static void complete_async_transfer(void)
+{
+    /* Mask the completion interrupt again */
+    P_CC3XX->host_rgf.host_rgf_imr |= DMA_COMPLETION_INT(async_state.has_output);
+
+#ifdef CC3XX_CONFIG_DMA_CACHE_FLUSH_ENABLE
+    /* The CPU kept running during the transfer, so may have speculatively
+     * loaded lines of the output region. Discard them now that the DMA has
+     * written it.
+     */
+    if (async_state.has_output) {
+        SCB_CleanInvalidateDCache_by_Addr((volatile void *)async_state.output_addr,
+                                          async_state.output_size);
+    }
+#endif /* CC3XX_CONFIG_DMA_CACHE_FLUSH_ENABLE */
+
+    /* Disable the DMA clock */
+    P_CC3XX->misc.dma_clk_enable = 0x0U;
+
+    async_state.in_flight = false;
+}
+
+void cc3xx_lowlevel_dma_set_async(cc3xx_dma_completion_callback_t callback,
+                                  void *ctx)
+{
+    cc3xx_lowlevel_dma_wait_for_completion();
+
+    async_state.callback = callback;
+    async_state.ctx = ctx;
+}
+
+void cc3xx_lowlevel_dma_irq_handler(void)
+{
+    uint32_t completion_int = DMA_COMPLETION_INT(async_state.has_output);
+
+    /* The interrupt is masked while the transfer is being waited for, in which
+     * case the waiter completes it.
+     */
+    if (!async_state.in_flight
+        || (P_CC3XX->host_rgf.host_rgf_imr & completion_int)
+        || !(P_CC3XX->host_rgf.host_rgf_irr & completion_int)) {
+        return;
+    }
+
+    /* Reset the interrupt */
+    P_CC3XX->host_rgf.host_rgf_icr = completion_int;
+
+    complete_async_transfer();
+
+    async_state.callback(async_state.ctx);
+}
+
+bool cc3xx_lowlevel_dma_is_busy(void)
+{
+    return async_state.in_flight;
+}
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
+void cc3xx_lowlevel_dma_wait_for_completion(void)
+{
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+    if (!async_state.in_flight) {
+        return;
+    }
+
+    /* Mask the interrupt first so that the handler can't complete the transfer
+     * concurrently. As the interrupt is then masked, WFI can't be used.
+     */
+    P_CC3XX->host_rgf.host_rgf_imr |= DMA_COMPLETION_INT(async_state.has_output);
+
+    if (async_state.in_flight) {
+        while (!(P_CC3XX->host_rgf.host_rgf_irr
+                 & DMA_COMPLETION_INT(async_state.has_output))) {}
+
+        /* Reset the interrupt */
+        P_CC3XX->host_rgf.host_rgf_icr = DMA_COMPLETION_INT(async_state.has_output);
+
+        complete_async_transfer();
+    }
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
 }
 
 static void process_data(const void* buf, size_t length)
 {
     uintptr_t remapped_buf;
 
+    /* Only one transfer can be in flight */
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     /* Enable the DMA clock */
     P_CC3XX->misc.dma_clk_enable = 0x1U;
 
@@ -129,12 +216,10 @@ static void process_data(const void* buf, size_t length)
         P_CC3XX->dout.dst_lli_word1 = length;
 
 #ifdef CC3XX_CONFIG_DMA_CACHE_FLUSH_ENABLE
-        /* Flush the output data. Note that this is only enough to avoid cache
-         * issues if the CPU is is a busy-wait loop while the access completes.
-         * If the DMA is used asynchronously via an interrupt and the CPU
-         * continues running while the DMA is operating, it will be necessary to
-         * set up an MPU covering the input and output regions so they can be
-         * marked as SHAREABLE (which is not currently implemented).
+        /* Flush the output data. If the DMA is used asynchronously, the CPU
+         * continues running while the DMA is operating and may pull lines of
+         * the output back into the cache, so they are invalidated again once
+         * the transfer completes.
          */
         SCB_CleanInvalidateDCache_by_Addr((volatile void *)dma_state.output_addr, length);
 #endif /* CC3XX_CONFIG_DMA_CACHE_FLUSH_ENABLE */
@@ -144,22 +229,38 @@ static void process_data(const void* buf, size_t length)
     }
 
 #ifdef CC3XX_CONFIG_DMA_CACHE_FLUSH_ENABLE
-    /* Flush the input data. Note that this is only enough to avoid cache
-     * issues if the CPU is is a busy-wait loop while the access completes.
-     * If the DMA is used asynchronously via an interrupt and the CPU
-     * continues running while the DMA is operating, it will be necessary to
-     * set up an MPU covering the input and output regions so they can be
-     * marked as SHAREABLE (which is not currently implemented).
+    /* Flush the input data. The caller must not write to the input until the
+     * transfer completes, so this is enough even if the DMA is used
+     * asynchronously.
      */
     SCB_CleanInvalidateDCache_by_Addr((volatile void *)remapped_buf, length);
 #endif /* CC3XX_CONFIG_DMA_CACHE_FLUSH_ENABLE */
 
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+    if (async_state.callback != NULL) {
+        async_state.has_output = dma_state.block_buf_needs_output;
+        async_state.output_addr = dma_state.output_addr - length;
+        async_state.output_size = length;
+        async_state.in_flight = true;
+
+        /* Unmask the completion interrupt, the handler finishes the transfer */
+        P_CC3XX->host_rgf.host_rgf_imr &= ~DMA_COMPLETION_INT(async_state.has_output);
+
+        /* Set the data source */
+        P_CC3XX->din.src_lli_word0 = remapped_buf;
+        /* Writing the length triggers the DMA */
+        P_CC3XX->din.src_lli_word1 = length;
+
+        return;
+    }
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
     /* Set the data source */
     P_CC3XX->din.src_lli_word0 = remapped_buf;
     /* Writing the length triggers the DMA */
     P_CC3XX->din.src_lli_word1 = length;
 
-    wait_for_dma_complete();
+    wait_for_dma_complete(dma_state.block_buf_needs_output);
 
     /* Disable the DMA clock */
     P_CC3XX->misc.dma_clk_enable = 0x0U;
@@ -167,6 +268,9 @@ static void process_data(const void* buf, size_t length)
 
 void cc3xx_lowlevel_dma_copy_data(void* dest, const void* src, size_t length)
 {
+    /* The copy goes through dma_state, which may hold a loaded context */
+    cc3xx_lowlevel_engine_evict();
+
     /* Set to PASSTHROUGH engine */
     cc3xx_lowlevel_set_engine(CC3XX_ENGINE_NONE);
 
@@ -181,70 +285,113 @@ void cc3xx_lowlevel_dma_copy_data(void* dest, const void* src, size_t length)
 cc3xx_err_t cc3xx_lowlevel_dma_buffered_input_data(const void* buf, size_t length,
                                                    bool write_output)
 {
-    size_t block_buf_size_free =
-        dma_state.block_buf_size - dma_state.block_buf_size_in_use;
-    size_t data_to_process_length = 0;
-    size_t dma_input_length = 0;
+    const struct cc3xx_dma_iovec_t iov = {
+        .buf = buf,
+        .len = length,
+    };
+
+    return cc3xx_lowlevel_dma_buffered_input_iovec(&iov, 1, write_output);
+}
+
+cc3xx_err_t cc3xx_lowlevel_dma_buffered_input_iovec(const struct cc3xx_dma_iovec_t *iov,
+                                                    size_t iov_len,
+                                                    bool write_output)
+{
+    size_t remaining = 0;
+    size_t data_to_process_length;
+    size_t dma_input_length;
+    size_t idx;
+
+    for (idx = 0; idx < iov_len; idx++) {
+        remaining += iov[idx].len;
+    }
 
     if (write_output) {
-        if (length > dma_state.output_size) {
+        if (remaining > dma_state.output_size) {
             FATAL_ERR(CC3XX_ERR_DMA_OUTPUT_BUFFER_TOO_SMALL);
             return CC3XX_ERR_DMA_OUTPUT_BUFFER_TOO_SMALL;
         }
-        dma_state.output_size -= length;
+        dma_state.output_size -= remaining;
     }
 
-    /* The DMA block buf will hold a block (to allow GCM and Hashing which both
-     * require a last-block special case to work). First, fill this block.
+    /* If we need to output the block buffer, and then new data shouldn't be
+     * output (or vice versa), then the block buffer needs to be flushed. If
+     * the buffer is empty, this is a no-op.
      */
-    if (dma_state.block_buf_size_in_use != 0) {
-        /* If we need to output the block buffer, and then new data shouldn't be
-         * output, then the block buffer needs to be flushed
+    if (dma_state.block_buf_needs_output != write_output) {
+        cc3xx_lowlevel_dma_flush_buffer(false);
+    }
+
+    if (remaining == 0) {
+        return CC3XX_ERR_SUCCESS;
+    }
+
+    dma_state.block_buf_needs_output = write_output;
+
+    for (idx = 0; idx < iov_len; idx++) {
+        const uint8_t *buf = iov[idx].buf;
+        size_t length = iov[idx].len;
+
+        /* The DMA block buf will hold a block (to allow GCM and Hashing which
+         * both require a last-block special case to work). If it holds part of
+         * a block, complete it from the start of this fragment. This is the
+         * only block which is staged, as it straddles the previous input.
          */
-        if (dma_state.block_buf_needs_output != write_output) {
-            cc3xx_lowlevel_dma_flush_buffer(false);
-        } else {
-            data_to_process_length =
-                length < block_buf_size_free ? length : block_buf_size_free;
+        if (dma_state.block_buf_size_in_use != 0 && length != 0) {
+            data_to_process_length = dma_state.block_buf_size
+                                     - dma_state.block_buf_size_in_use;
+            if (length < data_to_process_length) {
+                data_to_process_length = length;
+            }
+
             memcpy(dma_state.block_buf + dma_state.block_buf_size_in_use, buf,
-                   block_buf_size_free);
+                   data_to_process_length);
             dma_state.block_buf_size_in_use += data_to_process_length;
             buf += data_to_process_length;
             length -= data_to_process_length;
-        }
-    }
+            remaining -= data_to_process_length;
 
-    if (length == 0) {
-        return CC3XX_ERR_SUCCESS;
-    }
+            /* Only dispatch the block buf if there is data to follow it */
+            if (dma_state.block_buf_size_in_use == dma_state.block_buf_size
+                && remaining != 0) {
+                cc3xx_lowlevel_dma_flush_buffer(false);
+            }
+        }
 
-    dma_state.block_buf_needs_output = write_output;
+        if (length == 0) {
+            continue;
+        }
 
-    /* The block buf is now full, and we have remaining data. First dispatch the
-     * block buf. If the buffer is empty, this is a no-op.
-     */
-    cc3xx_lowlevel_dma_flush_buffer(false);
+        /* The block buf is now empty. Input the whole blocks of this fragment
+         * directly, but if it is the last fragment then make sure at least some
+         * data always remains to insert into the block buf.
+         */
+        if (remaining > length) {
+            data_to_process_length = length;
+        } else {
+            data_to_process_length = length - 1;
+        }
+        data_to_process_length = (data_to_process_length / dma_state.block_buf_size)
+                                 * dma_state.block_buf_size;
+
+        while (data_to_process_length > 0) {
+            dma_input_length = data_to_process_length < 0x10000 ? data_to_process_length
+                                                                : 0x10000 - dma_state.block_buf_size;
+            process_data(buf, dma_input_length);
+            data_to_process_length -= dma_input_length;
+            length -= dma_input_length;
+            remaining -= dma_input_length;
+            buf += dma_input_length;
+        }
 
-    /* If we have any whole blocks left, flush them (but make sure at least some
-     * data always remains to insert into the block buf.
-     */
-    data_to_process_length = ((length - 1) / dma_state.block_buf_size) * dma_state.block_buf_size;
-    while (data_to_process_length > 0) {
-        dma_input_length = data_to_process_length < 0x10000 ? data_to_process_length
-                                                            : 0x10000 - dma_state.block_buf_size;
-        process_data(buf, dma_input_length);
-        data_to_process_length -= dma_input_length;
-        length -= dma_input_length;
-        buf += dma_input_length;
+        /* Write the tail of the fragment into the block buffer. It is empty, and
+         * there is less than a block of data left, so this can't overflow.
+         */
+        memcpy(dma_state.block_buf, buf, length);
+        dma_state.block_buf_size_in_use = length;
+        remaining -= length;
     }
 
-    /* Write the remaining data into the block buffer. The previous flush means
-     * the buffer is empty, and we have less than a block of input data left, so
-     * this can't overflow.
-     */
-    memcpy(dma_state.block_buf, buf, length);
-    dma_state.block_buf_size_in_use += length;
-
     return CC3XX_ERR_SUCCESS;
 }
 
@@ -258,6 +405,8 @@ void cc3xx_lowlevel_dma_flush_buffer(bool zero_pad_first)
         }
 
         process_data(dma_state.block_buf, dma_state.block_buf_size_in_use);
+        /* The block buf is reused as soon as this returns */
+        cc3xx_lowlevel_dma_wait_for_completion();
         dma_state.block_buf_size_in_use = 0;
     }
 }
@@ -276,5 +425,10 @@ void cc3xx_lowlevel_dma_set_output(void* buf, size_t length)
 
 void cc3xx_lowlevel_dma_uninit(void)
 {
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     memset(&dma_state, 0, sizeof(dma_state));
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+    memset(&async_state, 0, sizeof(async_state));
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
 }
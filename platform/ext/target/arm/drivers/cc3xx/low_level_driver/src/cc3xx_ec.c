@@ -466,10 +466,91 @@ static bool split_scalar(cc3xx_ec_curve_t *curve, cc3xx_pka_reg_id_t scalar,
 }
 #endif /* CC3XX_CONFIG_DPA_MITIGATIONS_ENABLE */
 
-cc3xx_err_t cc3xx_lowlevel_ec_multiply_point_by_scalar(cc3xx_ec_curve_t *curve,
-                                                       cc3xx_ec_point_affine *p,
-                                                       cc3xx_pka_reg_id_t scalar,
-                                                       cc3xx_ec_point_affine *res)
+#if defined(CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE) \
+    && defined(CC3XX_CONFIG_EC_CURVE_TYPE_WEIERSTRASS_ENABLE)
+#if defined(CC3XX_CONFIG_DPA_MITIGATIONS_ENABLE) \
+    && (CC3XX_CONFIG_EC_DPA_MAX_BLIND_MULTIPLE > 254)
+/* The comb tables are 8 bits wider than the curve order, which has to hold the
+ * blinded scalar plus one more multiple of the order.
+ */
+#error "CC3XX_CONFIG_EC_DPA_MAX_BLIND_MULTIPLE is too large for the comb tables"
+#endif
+
+static bool point_is_generator(cc3xx_ec_curve_t *curve, cc3xx_ec_point_affine *p)
+{
+    return p->x == curve->generator.x && p->y == curve->generator.y;
+}
+
+/* The comb always runs over the full width of its table, so unlike the generic
+ * multiplication the scalar doesn't need padding to a fixed length. The table
+ * entries are fixed, so the scalar splitting done for DPA in the generic path
+ * would only cost two extra multiplications, instead the blinded scalar and the
+ * random Z of the accumulator are relied on.
+ */
+static cc3xx_err_t multiply_generator_by_scalar(cc3xx_ec_curve_t *curve,
+                                                const cc3xx_ec_comb_table_t *comb,
+                                                cc3xx_pka_reg_id_t scalar,
+                                                cc3xx_ec_point_affine *res)
+{
+    cc3xx_pka_reg_id_t blinded_scalar = cc3xx_lowlevel_pka_allocate_reg();
+    cc3xx_err_t err = CC3XX_ERR_SUCCESS;
+
+#ifdef CC3XX_CONFIG_DPA_MITIGATIONS_ENABLE
+    err = blind_scalar(curve, scalar, blinded_scalar);
+    if (err != CC3XX_ERR_SUCCESS) {
+        goto out;
+    }
+#else
+    cc3xx_lowlevel_pka_copy(scalar, blinded_scalar);
+#endif /* CC3XX_CONFIG_DPA_MITIGATIONS_ENABLE */
+
+    set_modulus_to_curve_modulus(curve);
+
+    err = cc3xx_lowlevel_ec_weierstrass_multiply_generator_by_scalar(curve, comb,
+                                                                     blinded_scalar,
+                                                                     res);
+
+#ifdef CC3XX_CONFIG_DFA_MITIGATIONS_ENABLE
+    /* The generator registers aren't used by the comb, but are still checked
+     * so that a fault in them is reported in the same way.
+     */
+    if (!validate_curve(curve)) {
+        err = CC3XX_ERR_DFA_VIOLATION;
+    }
+
+    if (!validate_point(curve, &curve->generator)) {
+        err = CC3XX_ERR_DFA_VIOLATION;
+    }
+
+    if (!validate_point(curve, res)) {
+        err = CC3XX_ERR_DFA_VIOLATION;
+    }
+#endif /* CC3XX_CONFIG_DFA_MITIGATIONS_ENABLE */
+
+#ifdef CC3XX_CONFIG_DPA_MITIGATIONS_ENABLE
+out:
+#endif /* CC3XX_CONFIG_DPA_MITIGATIONS_ENABLE */
+    if (err != CC3XX_ERR_SUCCESS) {
+        /* If an error has occurred, then scrub the result */
+        cc3xx_lowlevel_pka_set_to_random(res->x, curve->modulus_size * 8);
+        cc3xx_lowlevel_pka_set_to_random(res->y, curve->modulus_size * 8);
+    }
+
+    set_modulus_to_curve_order(curve);
+
+    cc3xx_lowlevel_pka_clear(blinded_scalar);
+    cc3xx_lowlevel_pka_free_reg(blinded_scalar);
+
+    cc3xx_lowlevel_pka_unmap_physical_registers();
+
+    return err;
+}
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE && CC3XX_CONFIG_EC_CURVE_TYPE_WEIERSTRASS_ENABLE */
+
+static cc3xx_err_t multiply_point_by_scalar(cc3xx_ec_curve_t *curve,
+                                            cc3xx_ec_point_affine *p,
+                                            cc3xx_pka_reg_id_t scalar,
+                                            cc3xx_ec_point_affine *res)
 {
     cc3xx_pka_reg_id_t padded_scalar = cc3xx_lowlevel_pka_allocate_reg();
     cc3xx_pka_reg_id_t scalar_to_input = padded_scalar;
@@ -598,6 +679,24 @@ out:
     return err;
 }
 
+cc3xx_err_t cc3xx_lowlevel_ec_multiply_point_by_scalar(cc3xx_ec_curve_t *curve,
+                                                       cc3xx_ec_point_affine *p,
+                                                       cc3xx_pka_reg_id_t scalar,
+                                                       cc3xx_ec_point_affine *res)
+{
+#if defined(CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE) \
+    && defined(CC3XX_CONFIG_EC_CURVE_TYPE_WEIERSTRASS_ENABLE)
+    const cc3xx_ec_comb_table_t *comb = curve_data_map[curve->id]->generator_comb;
+
+    if (curve->type == CC3XX_EC_CURVE_TYPE_WEIERSTRASS && comb != NULL
+        && point_is_generator(curve, p)) {
+        return multiply_generator_by_scalar(curve, comb, scalar, res);
+    }
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE && CC3XX_CONFIG_EC_CURVE_TYPE_WEIERSTRASS_ENABLE */
+
+    return multiply_point_by_scalar(curve, p, scalar, res);
+}
+
 /* Despite the name, this might or might not use the Shamir trick, as that
  * is controlled eventually by CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE
  */
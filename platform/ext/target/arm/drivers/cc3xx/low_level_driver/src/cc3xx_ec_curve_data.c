@@ -76,6 +76,96 @@ const cc3xx_ec_curve_data_t secp_224_r1 = {
 #endif
 
 #ifdef CC3XX_CONFIG_EC_CURVE_SECP_256_R1_ENABLE
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+static const uint32_t secp_256_r1_generator_comb_points[] = {
+    /*  0 */
+    0x5F0E19FB, 0x85E1522C, 0xBA45EC76, 0x4D6A2A04,
+    0xCDBF5A1D, 0xEF959AF6, 0x45503482, 0xC4C51F23,
+    0xB61326AB, 0x61973BE8, 0x049A7914, 0x07CD6BDF,
+    0x0F2BA0E8, 0xFFD82FBA, 0xF0C017E1, 0x8F136AC8,
+    /*  1 */
+    0x65171677, 0xD3580816, 0x10B575DB, 0xB55EF73B,
+    0x113C738A, 0x6B9732A0, 0x55FF6247, 0x6A4C6ED8,
+    0x81AA06C0, 0x05A79A2B, 0x6D2CC428, 0xEFDB77F3,
+    0xB47ED66D, 0x121953E0, 0x3C22072A, 0x24BA9231,
+    /*  2 */
+    0xDA92E958, 0x7842B941, 0x70A0A4AF, 0xB1F4388F,
+    0x030AD335, 0xAFFC601D, 0xE2F0E500, 0xB59CAA4F,
+    0xBA1270CE, 0xBB3201EE, 0xC2A0A147, 0x2B71AAA7,
+    0xB6367418, 0x4F304404, 0xA7461680, 0x5B6381AA,
+    /*  3 */
+    0x05E5C375, 0xEEE99570, 0x01E4637B, 0x1F21EB16,
+    0xEA07F5C8, 0x35DF57B1, 0xA10A46C2, 0xB6D61E93,
+    0x460D0067, 0x8CA9E553, 0x1E845856, 0xBC13632E,
+    0x0743C8F7, 0xD18AA284, 0x15AC0853, 0xBEDBC919,
+    /*  4 */
+    0xBBE93265, 0x0BA1D979, 0xF447F197, 0xF421EE5C,
+    0xF590D881, 0x92F7EAF0, 0x8BA20A31, 0x25FFE936,
+    0x4FBA91AB, 0x0611B340, 0x910B85BD, 0x2A1B4319,
+    0x42C625B8, 0x8B1BE633, 0x62ADFF0C, 0xAE7EAAF1,
+    /*  5 */
+    0xC15127E8, 0xC9D7279A, 0xDBA5B7E2, 0x585B6589,
+    0xAA1EFE18, 0xF162EE8B, 0xFE89219B, 0x17132D95,
+    0xB93CE002, 0x5D8C7A18, 0x39178FEE, 0xF6FC3EB8,
+    0xA84C096F, 0x208E7C8E, 0xA524C956, 0x35B0E8BB,
+    /*  6 */
+    0x2F0F4E81, 0x230D70F5, 0xD0EA5D55, 0xC30490DB,
+    0xF196EEA6, 0xF221954A, 0x9E1462F3, 0x3DC14A9E,
+    0x045B53DB, 0xAF26CDBE, 0x480D7B60, 0x6BDA8F63,
+    0x1643F7AC, 0x164F4F46, 0xB00663CD, 0x3B0BB193,
+    /*  7 */
+    0x65DD3829, 0x14DBF4F1, 0x1E5B0551, 0xE21EE9E1,
+    0xA4D6874F, 0x6EB61F03, 0xB86F98D6, 0x85868A63,
+    0xEA589079, 0x62799C7E, 0x9E6F95ED, 0x18D78F12,
+    0x3A923EBF, 0xFA1FAD9E, 0x5AFD5E03, 0x543E83C3,
+    /*  8 */
+    0x65DD3829, 0x14DBF4F1, 0x1E5B0551, 0xE21EE9E1,
+    0xA4D6874F, 0x6EB61F03, 0xB86F98D6, 0x85868A63,
+    0x15A76F86, 0x9D866381, 0x61906A12, 0xE72870EE,
+    0xC56DC140, 0x05E05261, 0xA502A1FD, 0xABC17C3B,
+    /*  9 */
+    0x2F0F4E81, 0x230D70F5, 0xD0EA5D55, 0xC30490DB,
+    0xF196EEA6, 0xF221954A, 0x9E1462F3, 0x3DC14A9E,
+    0xFBA4AC24, 0x50D93241, 0xB7F2849F, 0x9425709D,
+    0xE9BC0853, 0xE9B0B0B9, 0x4FF99C33, 0xC4F44E6B,
+    /* 10 */
+    0xC15127E8, 0xC9D7279A, 0xDBA5B7E2, 0x585B6589,
+    0xAA1EFE18, 0xF162EE8B, 0xFE89219B, 0x17132D95,
+    0x46C31FFD, 0xA27385E7, 0xC6E87011, 0x0903C148,
+    0x57B3F690, 0xDF718371, 0x5ADB36AA, 0xCA4F1743,
+    /* 11 */
+    0xBBE93265, 0x0BA1D979, 0xF447F197, 0xF421EE5C,
+    0xF590D881, 0x92F7EAF0, 0x8BA20A31, 0x25FFE936,
+    0xB0456E54, 0xF9EE4CBF, 0x6EF47A42, 0xD5E4BCE7,
+    0xBD39DA47, 0x74E419CC, 0x9D5200F4, 0x5181550D,
+    /* 12 */
+    0x05E5C375, 0xEEE99570, 0x01E4637B, 0x1F21EB16,
+    0xEA07F5C8, 0x35DF57B1, 0xA10A46C2, 0xB6D61E93,
+    0xB9F2FF98, 0x73561AAC, 0xE17BA7A9, 0x43EC9CD2,
+    0xF8BC3708, 0x2E755D7B, 0xEA53F7AD, 0x412436E5,
+    /* 13 */
+    0xDA92E958, 0x7842B941, 0x70A0A4AF, 0xB1F4388F,
+    0x030AD335, 0xAFFC601D, 0xE2F0E500, 0xB59CAA4F,
+    0x45ED8F31, 0x44CDFE11, 0x3D5F5EB8, 0xD48E5559,
+    0x49C98BE7, 0xB0CFBBFB, 0x58B9E980, 0xA49C7E54,
+    /* 14 */
+    0x65171677, 0xD3580816, 0x10B575DB, 0xB55EF73B,
+    0x113C738A, 0x6B9732A0, 0x55FF6247, 0x6A4C6ED8,
+    0x7E55F93F, 0xFA5865D4, 0x92D33BD7, 0x1024880D,
+    0x4B812992, 0xEDE6AC1F, 0xC3DDF8D6, 0xDB456DCD,
+    /* 15 */
+    0x5F0E19FB, 0x85E1522C, 0xBA45EC76, 0x4D6A2A04,
+    0xCDBF5A1D, 0xEF959AF6, 0x45503482, 0xC4C51F23,
+    0x49ECD954, 0x9E68C417, 0xFB6586EB, 0xF8329421,
+    0xF0D45F17, 0x0027D045, 0x0F3FE81F, 0x70EC9536,
+};
+
+static const cc3xx_ec_comb_table_t secp_256_r1_generator_comb = {
+    .spacing = 66,
+    .points = secp_256_r1_generator_comb_points,
+};
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
+
 const cc3xx_ec_curve_data_t secp_256_r1 = {
     .type = CC3XX_EC_CURVE_TYPE_WEIERSTRASS,
     .register_size = 32,
@@ -103,10 +193,136 @@ const cc3xx_ec_curve_data_t secp_256_r1 = {
 
     .cofactor = 1,
     .recommended_bits_for_generation = 352,
+
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+    .generator_comb = &secp_256_r1_generator_comb,
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
 };
 #endif
 
 #ifdef CC3XX_CONFIG_EC_CURVE_SECP_384_R1_ENABLE
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+static const uint32_t secp_384_r1_generator_comb_points[] = {
+    /*  0 */
+    0xC4C8BEBF, 0xE8CAEC07, 0xFEC5EA9D, 0xA92497A9,
+    0x58E84F2B, 0xE1DA3BA3, 0x2BA1A6BD, 0xC3CAA444,
+    0xFBDAB180, 0x2B5F1C35, 0x495ACFFC, 0x6D1FC754,
+    0x10D645F5, 0x1BC14A8C, 0x7D689F1E, 0x7AC371C3,
+    0xAC2E3E81, 0x1427B124, 0x4041F7DA, 0x77A1E780,
+    0x3B181FC7, 0xB92D6C93, 0x89D78D66, 0x2CBC6C09,
+    /*  1 */
+    0xA6A0D882, 0x13CA6CE0, 0x0B8C0486, 0xC7F79819,
+    0xEAE70D8A, 0xC24A5B19, 0x3F7FBC5F, 0x6F59EE54,
+    0x21005E72, 0xF621EE13, 0xDDE5F63A, 0xAB2F96BE,
+    0xFF62BA18, 0x99E5AB3B, 0xB71518C5, 0xD323261B,
+    0xE826EB7D, 0xD41FFF91, 0x51010437, 0xCE43625C,
+    0xCE5B5558, 0x0A5F460F, 0x1C02F079, 0xB72DAFA7,
+    /*  2 */
+    0xF5A1BDD2, 0x0E3753BD, 0xECD38747, 0xED186E25,
+    0x6C46A611, 0xFAD9FA8C, 0x0DC4438D, 0xD98017F0,
+    0x5F32E885, 0x1185D7CA, 0x2A531469, 0x60B92609,
+    0xF1731578, 0x31841DC7, 0x8B1B89BD, 0x8D10A48A,
+    0x09DE9976, 0x3DD7BE30, 0x4709D03C, 0x160DC52B,
+    0x5F35912C, 0x65DFD13F, 0x4E64CF6E, 0x7C2AC6F6,
+    /*  3 */
+    0xC16A6DBE, 0x57CD197C, 0x00839DF8, 0xAF0C2E71,
+    0x6C97C8F9, 0x203FE986, 0xE226D7A5, 0xF269BDD5,
+    0x512D697B, 0xD4A36E63, 0xB32ABE5E, 0xB9B0E4FD,
+    0x5EBC5472, 0x089E0C76, 0xC0043E82, 0x481AA69C,
+    0xB6B04030, 0x4CB6C1B6, 0x9C73315E, 0xF4665167,
+    0x44664051, 0x5913B73D, 0x7CDED4DE, 0xD12B5569,
+    /*  4 */
+    0x1C879BCC, 0x4B52E8AA, 0x241A024F, 0xEE9B3D94,
+    0xFF7A16D4, 0x89DC54A5, 0x4A3C004B, 0x0F6C0AC2,
+    0x0EE2A63C, 0x95524672, 0x048270DA, 0xD22B12E8,
+    0x9D90985D, 0x63233C05, 0x418DB60C, 0x60D4D6A0,
+    0x0402241A, 0x17FEA160, 0xBE1106F0, 0x79EDCAAC,
+    0x63B333AE, 0x32ED4B5A, 0x1618162E, 0x38D4FAD7,
+    /*  5 */
+    0xCBA79424, 0x3E599793, 0x6062F0F0, 0x0E2B8433,
+    0xD6F980B3, 0xF2174A7F, 0xF691DA7D, 0xF9036547,
+    0x37386F6B, 0x7D23392F, 0x9F682B6D, 0xE7134174,
+    0x41CD51ED, 0x37C44545, 0xD4D79CEE, 0x7E07F139,
+    0x2B082560, 0x9FC6EA96, 0x75C62993, 0xD66F0C52,
+    0x28B9DBDE, 0xB62CF74D, 0xC7D61F1D, 0x3C876268,
+    /*  6 */
+    0xB83F3BF7, 0x59FFCE62, 0xA5A5CB64, 0x6DE33DCE,
+    0x07A345A5, 0x8F5B4035, 0xC03DB993, 0x2FB16B09,
+    0x8DAC46E9, 0x1AE0A84F, 0x6EB5761C, 0x3798EF6F,
+    0x508C88C7, 0xF81B80E8, 0x8D68CFC0, 0x5275C52C,
+    0x8C100D4F, 0x223C0139, 0x2E763914, 0xBAF711A0,
+    0x7C23493C, 0x57936029, 0x34B551FB, 0xE07B6A70,
+    /*  7 */
+    0xDA8E1496, 0x35882CBC, 0x86201BD9, 0x034747F6,
+    0x9E99A26D, 0xF048950F, 0xA3C891F3, 0xD1E21646,
+    0x73B46BBA, 0x730BF68E, 0x8A53911A, 0x2129102E,
+    0xA167C43C, 0xC497D017, 0xCB409A47, 0x59561174,
+    0x65BCCA18, 0x9A0D9A03, 0x99D2FAD7, 0xDA2D4099,
+    0xA403907E, 0x72FEB2A7, 0xF6384A29, 0xF97DF4AF,
+    /*  8 */
+    0xDA8E1496, 0x35882CBC, 0x86201BD9, 0x034747F6,
+    0x9E99A26D, 0xF048950F, 0xA3C891F3, 0xD1E21646,
+    0x73B46BBA, 0x730BF68E, 0x8A53911A, 0x2129102E,
+    0x5E983BC3, 0x3B682FE9, 0x34BF65B8, 0xA6A9EE8A,
+    0x9A4335E6, 0x65F265FC, 0x662D0528, 0x25D2BF66,
+    0x5BFC6F81, 0x8D014D58, 0x09C7B5D6, 0x06820B50,
+    /*  9 */
+    0xB83F3BF7, 0x59FFCE62, 0xA5A5CB64, 0x6DE33DCE,
+    0x07A345A5, 0x8F5B4035, 0xC03DB993, 0x2FB16B09,
+    0x8DAC46E9, 0x1AE0A84F, 0x6EB5761C, 0x3798EF6F,
+    0xAF737738, 0x07E47F18, 0x7297303F, 0xAD8A3AD2,
+    0x73EFF2AF, 0xDDC3FEC6, 0xD189C6EB, 0x4508EE5F,
+    0x83DCB6C3, 0xA86C9FD6, 0xCB4AAE04, 0x1F84958F,
+    /* 10 */
+    0xCBA79424, 0x3E599793, 0x6062F0F0, 0x0E2B8433,
+    0xD6F980B3, 0xF2174A7F, 0xF691DA7D, 0xF9036547,
+    0x37386F6B, 0x7D23392F, 0x9F682B6D, 0xE7134174,
+    0xBE32AE12, 0xC83BBABB, 0x2B286311, 0x81F80EC5,
+    0xD4F7DA9E, 0x60391569, 0x8A39D66C, 0x2990F3AD,
+    0xD7462421, 0x49D308B2, 0x3829E0E2, 0xC3789D97,
+    /* 11 */
+    0x1C879BCC, 0x4B52E8AA, 0x241A024F, 0xEE9B3D94,
+    0xFF7A16D4, 0x89DC54A5, 0x4A3C004B, 0x0F6C0AC2,
+    0x0EE2A63C, 0x95524672, 0x048270DA, 0xD22B12E8,
+    0x626F67A2, 0x9CDCC3FB, 0xBE7249F3, 0x9F2B295E,
+    0xFBFDDBE4, 0xE8015E9F, 0x41EEF90F, 0x86123553,
+    0x9C4CCC51, 0xCD12B4A5, 0xE9E7E9D1, 0xC72B0528,
+    /* 12 */
+    0xC16A6DBE, 0x57CD197C, 0x00839DF8, 0xAF0C2E71,
+    0x6C97C8F9, 0x203FE986, 0xE226D7A5, 0xF269BDD5,
+    0x512D697B, 0xD4A36E63, 0xB32ABE5E, 0xB9B0E4FD,
+    0xA143AB8D, 0xF761F38A, 0x3FFBC17D, 0xB7E55962,
+    0x494FBFCE, 0xB3493E49, 0x638CCEA1, 0x0B99AE98,
+    0xBB99BFAE, 0xA6EC48C2, 0x83212B21, 0x2ED4AA96,
+    /* 13 */
+    0xF5A1BDD2, 0x0E3753BD, 0xECD38747, 0xED186E25,
+    0x6C46A611, 0xFAD9FA8C, 0x0DC4438D, 0xD98017F0,
+    0x5F32E885, 0x1185D7CA, 0x2A531469, 0x60B92609,
+    0x0E8CEA87, 0xCE7BE239, 0x74E47642, 0x72EF5B74,
+    0xF6216688, 0xC22841CF, 0xB8F62FC3, 0xE9F23AD4,
+    0xA0CA6ED3, 0x9A202EC0, 0xB19B3091, 0x83D53909,
+    /* 14 */
+    0xA6A0D882, 0x13CA6CE0, 0x0B8C0486, 0xC7F79819,
+    0xEAE70D8A, 0xC24A5B19, 0x3F7FBC5F, 0x6F59EE54,
+    0x21005E72, 0xF621EE13, 0xDDE5F63A, 0xAB2F96BE,
+    0x009D45E7, 0x661A54C5, 0x48EAE73A, 0x2CDCD9E3,
+    0x17D91481, 0x2BE0006E, 0xAEFEFBC8, 0x31BC9DA3,
+    0x31A4AAA7, 0xF5A0B9F0, 0xE3FD0F86, 0x48D25058,
+    /* 15 */
+    0xC4C8BEBF, 0xE8CAEC07, 0xFEC5EA9D, 0xA92497A9,
+    0x58E84F2B, 0xE1DA3BA3, 0x2BA1A6BD, 0xC3CAA444,
+    0xFBDAB180, 0x2B5F1C35, 0x495ACFFC, 0x6D1FC754,
+    0xEF29BA0A, 0xE43EB574, 0x829760E1, 0x853C8E3B,
+    0x53D1C17D, 0xEBD84EDB, 0xBFBE0825, 0x885E187F,
+    0xC4E7E038, 0x46D2936C, 0x76287299, 0xD34393F6,
+};
+
+static const cc3xx_ec_comb_table_t secp_384_r1_generator_comb = {
+    .spacing = 98,
+    .points = secp_384_r1_generator_comb_points,
+};
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
+
 const cc3xx_ec_curve_data_t secp_384_r1 = {
     .type = CC3XX_EC_CURVE_TYPE_WEIERSTRASS,
     .register_size = 48,
@@ -140,6 +356,10 @@ const cc3xx_ec_curve_data_t secp_384_r1 = {
 
     .cofactor = 1,
     .recommended_bits_for_generation = 384,
+
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+    .generator_comb = &secp_384_r1_generator_comb,
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
 };
 #endif
 
@@ -19,6 +19,10 @@
 
 #include "fatal_error.h"
 
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+#include "cc3xx_stdlib.h"
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
+
 #if defined(CC3XX_CONFIG_ECDSA_VERIFY_ENABLE)     \
     && !defined(CC3XX_CONFIG_ECDSA_SIGN_ENABLE)   \
     && !defined(CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE) \
@@ -454,7 +458,145 @@ static cc3xx_err_t multiply_point_by_scalar_side_channel_protected(
 }
 #endif /* !CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE */
 
-#if defined(CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE)
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+#define COMB_TEETH 4
+#define COMB_TABLE_SIZE (1 << COMB_TEETH)
+
+/* Returns the comb table index for a column of an odd scalar. The scalar is
+ * recoded into all-nonzero digits s_i = 2 * k_(i + 1) - 1, with the top digit
+ * always +1, so bit r of the index is set when the digit of row r is +1.
+ */
+static uint32_t get_comb_column(cc3xx_pka_reg_id_t scalar, uint32_t spacing,
+                                uint32_t column)
+{
+    const uint32_t top_bit = COMB_TEETH * spacing - 1;
+    uint32_t table_select = 0;
+    uint32_t bit_idx;
+    uint32_t row;
+
+    for (row = 0; row < COMB_TEETH; row++) {
+        bit_idx = column + row * spacing;
+
+        if (bit_idx == top_bit) {
+            table_select |= 1 << row;
+        } else {
+            table_select |= cc3xx_lowlevel_pka_test_bits_ui(scalar, bit_idx + 1,
+                                                            1) << row;
+        }
+    }
+
+    return table_select;
+}
+
+/* Loads a comb table entry into the x and y coordinates of res. Every entry is
+ * read, so that the memory access pattern doesn't depend on the secret index.
+ */
+static void load_comb_point(cc3xx_ec_curve_t *curve,
+                            const cc3xx_ec_comb_table_t *comb,
+                            uint32_t table_select,
+                            cc3xx_ec_point_projective *res)
+{
+    const size_t coord_words = curve->modulus_size / sizeof(uint32_t);
+    uint32_t point[2 * CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)] = {0};
+    const uint32_t *entry;
+    uint32_t mask;
+    uint32_t idx;
+    size_t word;
+
+    for (idx = 0; idx < COMB_TABLE_SIZE; idx++) {
+        /* All-ones if idx == table_select, zero otherwise */
+        mask = 0 - (((idx ^ table_select) - 1) >> 31);
+        entry = comb->points + idx * 2 * coord_words;
+
+        for (word = 0; word < 2 * coord_words; word++) {
+            point[word] |= entry[word] & mask;
+        }
+    }
+
+    cc3xx_lowlevel_pka_write_reg(res->x, point, curve->modulus_size);
+    cc3xx_lowlevel_pka_write_reg(res->y, point + coord_words,
+                                 curve->modulus_size);
+
+    cc3xx_secure_erase_buffer(point, 2 * coord_words);
+}
+
+static cc3xx_err_t multiply_generator_by_scalar_comb(
+                                             cc3xx_ec_curve_t *curve,
+                                             const cc3xx_ec_comb_table_t *comb,
+                                             cc3xx_pka_reg_id_t scalar,
+                                             cc3xx_ec_point_affine *res)
+{
+    int32_t idx;
+    uint32_t table_select;
+    uint32_t parity;
+    cc3xx_err_t err = CC3XX_ERR_SUCCESS;
+
+    cc3xx_pka_reg_id_t odd_scalar = cc3xx_lowlevel_pka_allocate_reg();
+    cc3xx_pka_reg_id_t scalar_plus_order = cc3xx_lowlevel_pka_allocate_reg();
+    cc3xx_ec_point_projective accumulator = cc3xx_lowlevel_ec_allocate_projective_point();
+    cc3xx_ec_point_projective comb_point = cc3xx_lowlevel_ec_allocate_projective_point();
+    cc3xx_ec_point_affine comb_point_affine = {comb_point.x, comb_point.y};
+
+    /* The recoding needs an odd scalar. Adding the order doesn't change the
+     * result, so select between k and k + n by the parity of k without
+     * branching on it.
+     */
+    cc3xx_pka_reg_id_t odd_scalar_table[2] = {scalar_plus_order, scalar};
+
+    cc3xx_lowlevel_pka_add(scalar, curve->order, scalar_plus_order);
+    parity = cc3xx_lowlevel_pka_test_bits_ui(scalar, 0, 1);
+    cc3xx_lowlevel_pka_copy(odd_scalar_table[parity], odd_scalar);
+
+    assert(cc3xx_lowlevel_pka_get_bit_size(odd_scalar)
+           <= COMB_TEETH * comb->spacing);
+
+    cc3xx_lowlevel_pka_unmap_physical_registers();
+
+    table_select = get_comb_column(odd_scalar, comb->spacing, comb->spacing - 1);
+    load_comb_point(curve, comb, table_select, &comb_point);
+    cc3xx_lowlevel_ec_affine_to_jacobian_with_random_z(curve, &comb_point_affine,
+                                                       &accumulator);
+
+    /* The table entries are affine, so Z stays at 1 for the rest of the loop */
+    cc3xx_lowlevel_pka_clear(comb_point.z);
+    cc3xx_lowlevel_pka_add_si(comb_point.z, 1, comb_point.z);
+
+    for (idx = comb->spacing - 2; idx >= 0; idx--) {
+        double_point(curve, &accumulator, &accumulator);
+
+        table_select = get_comb_column(odd_scalar, comb->spacing, idx);
+        load_comb_point(curve, comb, table_select, &comb_point);
+
+        add_points(curve, &accumulator, &comb_point, &accumulator);
+
+        if (cc3xx_lowlevel_ec_projective_point_is_infinity(&accumulator)) {
+            FATAL_ERR(CC3XX_ERR_EC_POINT_IS_INFINITY);
+            err |= CC3XX_ERR_EC_POINT_IS_INFINITY;
+        }
+    }
+
+    err |= cc3xx_lowlevel_ec_jacobian_to_affine(curve, &accumulator, res);
+
+    if (err != CC3XX_ERR_SUCCESS) {
+        cc3xx_lowlevel_pka_clear(res->x);
+        cc3xx_lowlevel_pka_clear(res->y);
+    }
+
+    cc3xx_lowlevel_ec_free_projective_point(&comb_point);
+    cc3xx_lowlevel_ec_free_projective_point(&accumulator);
+    cc3xx_lowlevel_pka_clear(scalar_plus_order);
+    cc3xx_lowlevel_pka_free_reg(scalar_plus_order);
+    cc3xx_lowlevel_pka_clear(odd_scalar);
+    cc3xx_lowlevel_pka_free_reg(odd_scalar);
+
+    cc3xx_lowlevel_pka_unmap_physical_registers();
+
+    return err;
+}
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
+
+#if defined(CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE) \
+    && !defined(CC3XX_CONFIG_EC_SHAMIR_TRICK_JSF_ENABLE)
 static cc3xx_err_t shamir_multiply_points_by_scalars_and_add(
                                              cc3xx_ec_curve_t *curve,
                                              cc3xx_ec_point_affine *p1,
@@ -537,7 +679,183 @@ static cc3xx_err_t shamir_multiply_points_by_scalars_and_add(
 
     return err;
 }
-#endif /* CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE */
+#endif /* CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE && !CC3XX_CONFIG_EC_SHAMIR_TRICK_JSF_ENABLE */
+
+#if defined(CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE) \
+    && defined(CC3XX_CONFIG_EC_SHAMIR_TRICK_JSF_ENABLE)
+#define JSF_MAX_SCALAR_WORDS ((CC3XX_EC_MAX_POINT_SIZE + sizeof(uint32_t) - 1) \
+                              / sizeof(uint32_t))
+#define JSF_MAX_DIGITS (JSF_MAX_SCALAR_WORDS * 32 + 1)
+
+static uint32_t get_low_three_bits(const uint32_t *words, size_t word_am,
+                                   uint32_t idx)
+{
+    const uint32_t word_idx = idx / 32;
+    const uint32_t bit_idx = idx % 32;
+    uint32_t val = 0;
+
+    if (word_idx < word_am) {
+        val = words[word_idx] >> bit_idx;
+    }
+
+    if (bit_idx > 29 && word_idx + 1 < word_am) {
+        val |= words[word_idx + 1] << (32 - bit_idx);
+    }
+
+    return val & 0b111;
+}
+
+/* Computes the joint sparse form of two scalars, as per Guide to Elliptic Curve
+ * Cryptography Algorithm 3.50. The digits are in {-1, 0, 1}, and on average
+ * only half of the digit pairs are non-zero, compared to three quarters for the
+ * plain binary representation.
+ */
+static void compute_jsf(const uint32_t *k0, const uint32_t *k1, size_t word_am,
+                        size_t digit_am, int8_t *u0, int8_t *u1)
+{
+    uint32_t d0 = 0;
+    uint32_t d1 = 0;
+    uint32_t l0;
+    uint32_t l1;
+    size_t idx;
+
+    for (idx = 0; idx < digit_am; idx++) {
+        l0 = (d0 + get_low_three_bits(k0, word_am, idx)) & 0b111;
+        l1 = (d1 + get_low_three_bits(k1, word_am, idx)) & 0b111;
+
+        u0[idx] = 0;
+        if (l0 & 1) {
+            u0[idx] = (l0 & 0b11) == 1 ? 1 : -1;
+            if ((l0 == 3 || l0 == 5) && (l1 & 0b11) == 2) {
+                u0[idx] = -u0[idx];
+            }
+        }
+
+        u1[idx] = 0;
+        if (l1 & 1) {
+            u1[idx] = (l1 & 0b11) == 1 ? 1 : -1;
+            if ((l1 == 3 || l1 == 5) && (l0 & 0b11) == 2) {
+                u1[idx] = -u1[idx];
+            }
+        }
+
+        if (2 * (int32_t)d0 == 1 + u0[idx]) {
+            d0 = 1 - d0;
+        }
+        if (2 * (int32_t)d1 == 1 + u1[idx]) {
+            d1 = 1 - d1;
+        }
+    }
+}
+
+/* Not side-channel protected, both the digits and the table selection are
+ * visible in the timing. Only used on public data.
+ */
+static cc3xx_err_t shamir_multiply_points_by_scalars_and_add(
+                                             cc3xx_ec_curve_t *curve,
+                                             cc3xx_ec_point_affine *p1,
+                                             cc3xx_pka_reg_id_t    scalar1,
+                                             cc3xx_ec_point_affine *p2,
+                                             cc3xx_pka_reg_id_t    scalar2,
+                                             cc3xx_ec_point_affine *res)
+{
+    const size_t word_am = (curve->modulus_size + sizeof(uint32_t) - 1)
+                           / sizeof(uint32_t);
+    const size_t digit_am = word_am * 32 + 1;
+    uint32_t scalar1_words[JSF_MAX_SCALAR_WORDS];
+    uint32_t scalar2_words[JSF_MAX_SCALAR_WORDS];
+    int8_t u0[JSF_MAX_DIGITS];
+    int8_t u1[JSF_MAX_DIGITS];
+    int32_t idx;
+    uint32_t table_select;
+    cc3xx_ec_point_projective *table_point;
+    cc3xx_err_t err = CC3XX_ERR_SUCCESS;
+    cc3xx_ec_point_projective proj_p1 = cc3xx_lowlevel_ec_allocate_projective_point();
+    cc3xx_ec_point_projective proj_p2 = cc3xx_lowlevel_ec_allocate_projective_point();
+    cc3xx_ec_point_projective p1_plus_p2 = cc3xx_lowlevel_ec_allocate_projective_point();
+    cc3xx_ec_point_projective p1_minus_p2 = cc3xx_lowlevel_ec_allocate_projective_point();
+    cc3xx_ec_point_projective accumulator = cc3xx_lowlevel_ec_allocate_projective_point();
+
+    /* Indexed by (u0 + 1) * 3 + (u1 + 1). The first four entries are the
+     * negations of the last four, which are done in place on the y coordinate
+     * rather than taking up more PKA registers.
+     */
+    cc3xx_ec_point_projective *point_add_table[9] = {
+        &p1_plus_p2, &proj_p1, &p1_minus_p2,
+        &proj_p2,    NULL,     &proj_p2,
+        &p1_minus_p2, &proj_p1, &p1_plus_p2,
+    };
+
+    assert(cc3xx_lowlevel_pka_greater_than_si(scalar1, 0)
+           || cc3xx_lowlevel_pka_greater_than_si(scalar2, 0));
+    assert(cc3xx_lowlevel_pka_get_bit_size(scalar1) <= word_am * 32);
+    assert(cc3xx_lowlevel_pka_get_bit_size(scalar2) <= word_am * 32);
+
+    cc3xx_lowlevel_pka_read_reg(scalar1, scalar1_words, word_am * sizeof(uint32_t));
+    cc3xx_lowlevel_pka_read_reg(scalar2, scalar2_words, word_am * sizeof(uint32_t));
+
+    compute_jsf(scalar1_words, scalar2_words, word_am, digit_am, u0, u1);
+
+    cc3xx_lowlevel_pka_unmap_physical_registers();
+
+    cc3xx_lowlevel_ec_affine_to_jacobian(curve, p1, &proj_p1);
+    cc3xx_lowlevel_ec_affine_to_jacobian(curve, p2, &proj_p2);
+
+    add_points(curve, &proj_p1, &proj_p2, &p1_plus_p2);
+
+    cc3xx_lowlevel_pka_mod_neg(proj_p2.y, proj_p2.y);
+    add_points(curve, &proj_p1, &proj_p2, &p1_minus_p2);
+    cc3xx_lowlevel_pka_mod_neg(proj_p2.y, proj_p2.y);
+
+    for (idx = digit_am - 1; idx > 0; idx--) {
+        if (u0[idx] != 0 || u1[idx] != 0) {
+            break;
+        }
+    }
+
+    table_select = (u0[idx] + 1) * 3 + (u1[idx] + 1);
+    cc3xx_lowlevel_ec_copy_projective_point(point_add_table[table_select],
+                                            &accumulator);
+    if (table_select < 4) {
+        cc3xx_lowlevel_pka_mod_neg(accumulator.y, accumulator.y);
+    }
+
+    for (idx -= 1; idx >= 0; idx--) {
+        double_point(curve, &accumulator, &accumulator);
+
+        table_select = (u0[idx] + 1) * 3 + (u1[idx] + 1);
+        table_point = point_add_table[table_select];
+        if (table_point == NULL) {
+            continue;
+        }
+
+        if (table_select < 4) {
+            cc3xx_lowlevel_pka_mod_neg(table_point->y, table_point->y);
+            add_points(curve, &accumulator, table_point, &accumulator);
+            cc3xx_lowlevel_pka_mod_neg(table_point->y, table_point->y);
+        } else {
+            add_points(curve, &accumulator, table_point, &accumulator);
+        }
+
+        if (cc3xx_lowlevel_ec_projective_point_is_infinity(&accumulator)) {
+            FATAL_ERR(CC3XX_ERR_EC_POINT_IS_INFINITY);
+            err |= CC3XX_ERR_EC_POINT_IS_INFINITY;
+        }
+    }
+
+    err |= cc3xx_lowlevel_ec_jacobian_to_affine(curve, &accumulator, res);
+
+    cc3xx_lowlevel_ec_free_projective_point(&accumulator);
+    cc3xx_lowlevel_ec_free_projective_point(&p1_minus_p2);
+    cc3xx_lowlevel_ec_free_projective_point(&p1_plus_p2);
+    cc3xx_lowlevel_ec_free_projective_point(&proj_p2);
+    cc3xx_lowlevel_ec_free_projective_point(&proj_p1);
+
+    cc3xx_lowlevel_pka_unmap_physical_registers();
+
+    return err;
+}
+#endif /* CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE && CC3XX_CONFIG_EC_SHAMIR_TRICK_JSF_ENABLE */
 
 cc3xx_err_t cc3xx_lowlevel_ec_weierstrass_multiply_point_by_scalar(
                                              cc3xx_ec_curve_t *curve,
@@ -562,6 +880,17 @@ cc3xx_err_t cc3xx_lowlevel_ec_weierstrass_multiply_point_by_scalar(
 #endif
 }
 
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+cc3xx_err_t cc3xx_lowlevel_ec_weierstrass_multiply_generator_by_scalar(
+                                             cc3xx_ec_curve_t *curve,
+                                             const cc3xx_ec_comb_table_t *comb,
+                                             cc3xx_pka_reg_id_t scalar,
+                                             cc3xx_ec_point_affine *res)
+{
+    return multiply_generator_by_scalar_comb(curve, comb, scalar, res);
+}
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
+
 cc3xx_err_t cc3xx_lowlevel_ec_weierstrass_shamir_multiply_points_by_scalars_and_add(
                                              cc3xx_ec_curve_t *curve,
                                              cc3xx_ec_point_affine *p1,
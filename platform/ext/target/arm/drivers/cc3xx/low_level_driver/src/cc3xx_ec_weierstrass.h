@@ -102,6 +102,33 @@ cc3xx_err_t cc3xx_lowlevel_ec_weierstrass_multiply_point_by_scalar(
                                              cc3xx_pka_reg_id_t scalar,
                                              cc3xx_ec_point_affine *res);
 
+#ifdef CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE
+/**
+ * @brief                        Multiply the curve generator by a scalar value,
+ *                               using a precomputed comb table
+ *
+ * @note                         This function is side-channel protected and
+ *                               may be used on secret values, in the same way
+ *                               as the generic point multiplication.
+ *
+ * @param[in]  curve             A pointer to an initialized weierstrass curve
+ *                               object.
+ * @param[in]  comb              The comb table for the generator of the curve.
+ * @param[in]  scalar            The scalar value to multiply the generator by.
+ *                               Must be below 2^(4 * comb->spacing) - n.
+ * @param[out] res               A pointer to the affine point object which the
+ *                               result will be written to.
+ *
+ * @return                       CC3XX_ERR_SUCCESS on success, another
+ *                               cc3xx_err_t on error.
+ */
+cc3xx_err_t cc3xx_lowlevel_ec_weierstrass_multiply_generator_by_scalar(
+                                             cc3xx_ec_curve_t *curve,
+                                             const cc3xx_ec_comb_table_t *comb,
+                                             cc3xx_pka_reg_id_t scalar,
+                                             cc3xx_ec_point_affine *res);
+#endif /* CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
+
 /**
  * @brief                        Multiply two scalar by two separate affine
  *                               values, and then add the points. This function
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023, The TrustedFirmware-M Contributors. All rights reserved.
+ * Copyright (c) 2021-2024, The TrustedFirmware-M Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,8 +8,18 @@
 #include "cc3xx_engine_state.h"
 #include "cc3xx_dev.h"
 
+#include <assert.h>
+#include <stddef.h>
+
 enum cc3xx_engine_t cc3xx_engine_in_use = CC3XX_ENGINE_NONE;
 
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+static struct {
+    void *ctx;
+    cc3xx_engine_evict_fn_t evict;
+} resident;
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+
 void cc3xx_lowlevel_set_engine(enum cc3xx_engine_t engine)
 {
     /* Wait for the crypto engine to be ready */
@@ -24,3 +34,55 @@ void cc3xx_lowlevel_set_engine(enum cc3xx_engine_t engine)
     /* Wait for the crypto engine to be ready */
     while (P_CC3XX->cc_ctl.crypto_busy) {}
 }
+
+void cc3xx_lowlevel_engine_set_resident(void *ctx, cc3xx_engine_evict_fn_t evict)
+{
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+    /* The previous context must have been evicted, or picked up by its owner,
+     * before the engine was loaded with this one.
+     */
+    assert(resident.ctx == NULL);
+
+    resident.ctx = ctx;
+    resident.evict = evict;
+#else
+    (void)ctx;
+    (void)evict;
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+}
+
+bool cc3xx_lowlevel_engine_is_resident(const void *ctx)
+{
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+    return ctx != NULL && resident.ctx == ctx;
+#else
+    (void)ctx;
+    return false;
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+}
+
+void cc3xx_lowlevel_engine_clear_resident(void)
+{
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+    resident.ctx = NULL;
+    resident.evict = NULL;
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+}
+
+void cc3xx_lowlevel_engine_evict(void)
+{
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+    void *ctx = resident.ctx;
+    cc3xx_engine_evict_fn_t evict = resident.evict;
+
+    if (ctx == NULL) {
+        return;
+    }
+
+    /* Cleared first, as the evict function goes through the uninit functions
+     * which evict in turn.
+     */
+    cc3xx_lowlevel_engine_clear_resident();
+    evict(ctx);
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+}
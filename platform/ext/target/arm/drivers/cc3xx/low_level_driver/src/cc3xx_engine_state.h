@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023, The TrustedFirmware-M Contributors. All rights reserved.
+ * Copyright (c) 2021-2024, The TrustedFirmware-M Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -36,6 +36,52 @@ extern enum cc3xx_engine_t cc3xx_engine_in_use;
  */
 void cc3xx_lowlevel_set_engine(enum cc3xx_engine_t engine);
 
+/**
+ * @brief Function which writes the context left loaded in the engine back to
+ *        its state struct, and uninitializes the engine.
+ */
+typedef void (*cc3xx_engine_evict_fn_t)(void *ctx);
+
+/**
+ * @brief Records that the state struct at ctx is still loaded in the engine
+ *        after the current operation step returned. Only has an effect if
+ *        CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE is set.
+ *
+ * @note  The evict function writes into the state struct, from whichever
+ *        caller next uses the engine. The owner of the contexts must
+ *        therefore call cc3xx_lowlevel_uninit() before any caller which can't
+ *        access that memory runs, and no other context may be resident when
+ *        this is called. The TF-M runtime crypto service can't guarantee
+ *        the former, so it doesn't support this.
+ *
+ * @param ctx   State struct the loaded context belongs to
+ * @param evict Function to write the context back, called when another user
+ *              needs the engine
+ */
+void cc3xx_lowlevel_engine_set_resident(void *ctx, cc3xx_engine_evict_fn_t evict);
+
+/**
+ * @brief Whether the state struct at ctx is the context loaded in the engine.
+ *
+ * @param ctx State struct to check
+ *
+ * @return true if the engine holds the context of ctx, false otherwise
+ */
+bool cc3xx_lowlevel_engine_is_resident(const void *ctx);
+
+/**
+ * @brief Forgets the resident context without writing it back. Used when the
+ *        owner of the context picks it up again, or discards it.
+ */
+void cc3xx_lowlevel_engine_clear_resident(void);
+
+/**
+ * @brief Writes back the resident context, if there is one, so that the
+ *        caller can use the engine and the DMA. Must be called by every
+ *        entry point that configures an engine or overwrites the DMA state.
+ */
+void cc3xx_lowlevel_engine_evict(void);
+
 #ifdef __cplusplus
 }
 #endif
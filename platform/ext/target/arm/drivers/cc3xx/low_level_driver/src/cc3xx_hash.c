@@ -83,6 +83,7 @@ static void init_without_iv_set(cc3xx_hash_alg_t alg)
 
 cc3xx_err_t cc3xx_lowlevel_hash_init(cc3xx_hash_alg_t alg)
 {
+    /* This also writes back any context left loaded in the engine */
     cc3xx_lowlevel_hash_uninit();
 
     const uint32_t *iv;
@@ -127,6 +128,9 @@ cc3xx_err_t cc3xx_lowlevel_hash_init(cc3xx_hash_alg_t alg)
 void cc3xx_lowlevel_hash_uninit(void)
 {
     static const uint32_t zero_buf[9] = {0};
+
+    cc3xx_lowlevel_engine_evict();
+
     cc3xx_lowlevel_dma_uninit();
 
     set_hash_h(zero_buf, sizeof(zero_buf));
@@ -147,8 +151,16 @@ cc3xx_err_t cc3xx_lowlevel_hash_update(const uint8_t *buf, size_t length)
     return cc3xx_lowlevel_dma_buffered_input_data(buf, length, false);
 }
 
+cc3xx_err_t cc3xx_lowlevel_hash_update_iovec(const struct cc3xx_dma_iovec_t *iov,
+                                             size_t iov_len)
+{
+    return cc3xx_lowlevel_dma_buffered_input_iovec(iov, iov_len, false);
+}
+
 void cc3xx_lowlevel_hash_get_state(struct cc3xx_hash_state_t *state)
 {
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     state->curr_len = P_CC3XX->hash.hash_cur_len[0];
     state->curr_len |= (uint64_t)P_CC3XX->hash.hash_cur_len[1] << 32;
     state->alg = P_CC3XX->hash.hash_control & 0b1111 ;
@@ -159,6 +171,10 @@ void cc3xx_lowlevel_hash_get_state(struct cc3xx_hash_state_t *state)
 
 void cc3xx_lowlevel_hash_set_state(const struct cc3xx_hash_state_t *state)
 {
+    cc3xx_lowlevel_engine_evict();
+
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     init_without_iv_set(state->alg);
     size_t hash_h_len = state->alg != CC3XX_HASH_ALG_SHA1 ? SHA256_OUTPUT_SIZE
                                                           : SHA1_OUTPUT_SIZE;
@@ -170,6 +186,53 @@ void cc3xx_lowlevel_hash_set_state(const struct cc3xx_hash_state_t *state)
     memcpy(&dma_state, &state->dma_state, sizeof(dma_state));
 }
 
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+static void hash_evict(void *ctx)
+{
+    cc3xx_lowlevel_hash_get_state(ctx);
+    cc3xx_lowlevel_hash_uninit();
+}
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+
+void cc3xx_lowlevel_hash_load_state(struct cc3xx_hash_state_t *state)
+{
+    if (cc3xx_lowlevel_engine_is_resident(state)) {
+        /* Still loaded, and owned by the caller until it puts it back */
+        cc3xx_lowlevel_engine_clear_resident();
+        return;
+    }
+
+    cc3xx_lowlevel_hash_set_state(state);
+}
+
+void cc3xx_lowlevel_hash_put_state(struct cc3xx_hash_state_t *state)
+{
+#ifdef CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE
+    cc3xx_lowlevel_engine_set_resident(state, hash_evict);
+#else
+    cc3xx_lowlevel_hash_get_state(state);
+    cc3xx_lowlevel_hash_uninit();
+#endif /* CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+}
+
+void cc3xx_lowlevel_hash_copy_state(struct cc3xx_hash_state_t *dst,
+                                    const struct cc3xx_hash_state_t *src)
+{
+    if (cc3xx_lowlevel_engine_is_resident(src)) {
+        cc3xx_lowlevel_hash_get_state(dst);
+    } else if (dst != src) {
+        memcpy(dst, src, sizeof(*dst));
+    }
+}
+
+void cc3xx_lowlevel_hash_discard_state(const struct cc3xx_hash_state_t *state)
+{
+    if (cc3xx_lowlevel_engine_is_resident(state)) {
+        cc3xx_lowlevel_engine_clear_resident();
+        cc3xx_lowlevel_hash_uninit();
+    }
+}
+
 void cc3xx_lowlevel_hash_finish(uint32_t *res, size_t length)
 {
 #ifdef CC3XX_CONFIG_STRICT_UINT32_T_ALIGNMENT
@@ -177,6 +240,8 @@ void cc3xx_lowlevel_hash_finish(uint32_t *res, size_t length)
     assert(((uintptr_t)res & 0b11) == 0);
 #endif
 
+    cc3xx_lowlevel_dma_wait_for_completion();
+
     /* Check size */
     switch (P_CC3XX->hash.hash_control & 0b1111) {
     case CC3XX_HASH_ALG_SHA256:
@@ -160,5 +160,7 @@ cc3xx_err_t cc3xx_lowlevel_init(void)
 
 cc3xx_err_t cc3xx_lowlevel_uninit(void)
 {
+    cc3xx_lowlevel_engine_evict();
+
     return CC3XX_ERR_SUCCESS;
 }
@@ -126,6 +126,15 @@ static cc3xx_pka_reg_id_t phys_reg_mapping_list[CC3XX_PKA_PHYS_REG_AMOUNT];
 
 static struct cc3xx_pka_state_t pka_state;
 
+#ifdef CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE
+static uint32_t phys_reg_last_use[CC3XX_PKA_PHYS_REG_AMOUNT];
+static uint32_t phys_reg_use_count;
+#endif /* CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE */
+
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+static struct cc3xx_pka_reg_stats_t pka_reg_stats;
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
+
 static inline uint32_t pka_addr_from_byte_addr(uint32_t offset)
 {
     return offset / sizeof(uint32_t);
@@ -150,6 +159,10 @@ void cc3xx_lowlevel_pka_unmap_physical_registers(void)
     /* Wait for the pipeline to finish */
     while(!P_CC3XX->pka.pka_done){}
 
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+    pka_reg_stats.flushes += 1;
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
+
     for (idx = PKA_PHYS_REG_FIRST_MAPPABLE; idx <= PKA_PHYS_REG_LAST_MAPPABLE; idx++) {
         virt_reg = phys_reg_mapping_list[idx];
         if (virt_reg != 0 && virt_reg_is_mapped[virt_reg]) {
@@ -256,16 +269,76 @@ void cc3xx_lowlevel_pka_init(uint32_t size)
     pka_init_from_state();
 }
 
+#ifdef CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE
+/* Frees up a physical register by unmapping the virtual register that is
+ * mapped onto it. A virtual register which has been freed is picked first,
+ * since its value won't be used again, and otherwise the one that was least
+ * recently used. The registers used by the operation being constructed have
+ * just been used, so they are never picked.
+ */
+static uint32_t evict_phys_reg(void)
+{
+    uint32_t idx;
+    uint32_t victim = PKA_PHYS_REG_FIRST_MAPPABLE;
+    cc3xx_pka_reg_id_t virt_reg;
+
+    for (idx = PKA_PHYS_REG_FIRST_MAPPABLE; idx <= PKA_PHYS_REG_LAST_MAPPABLE; idx++) {
+        if (!virt_reg_in_use[phys_reg_mapping_list[idx]]) {
+            victim = idx;
+            break;
+        }
+
+        /* Compare ages rather than timestamps so that wrapping is harmless */
+        if (phys_reg_use_count - phys_reg_last_use[idx]
+            > phys_reg_use_count - phys_reg_last_use[victim]) {
+            victim = idx;
+        }
+    }
+
+    virt_reg = phys_reg_mapping_list[victim];
+
+    /* The address in the memory map may have been swapped with a temporary
+     * register by an operation, so it has to be read back after the pipeline
+     * is finished, in the same way as in unmap.
+     */
+    while(!P_CC3XX->pka.pka_done) {}
+    virt_reg_sram_addr[virt_reg] = P_CC3XX->pka.memory_map[victim];
+    virt_reg_phys_reg[virt_reg] = 0;
+    virt_reg_is_mapped[virt_reg] = false;
+    phys_reg_mapping_list[victim] = 0;
+
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+    pka_reg_stats.evictions += 1;
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
+
+    return victim;
+}
+#endif /* CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE */
+
 static void allocate_phys_reg(cc3xx_pka_reg_id_t virt_reg)
 {
     uint32_t phys_reg;
 
-    assert(phys_reg_next_mapped <= PKA_PHYS_REG_LAST_MAPPABLE);
     assert(phys_reg_mapping_list[PKA_PHYS_REG_TEMP_0] == 0);
     assert(phys_reg_mapping_list[PKA_PHYS_REG_TEMP_1] == 0);
 
+#ifdef CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE
+    if (phys_reg_next_mapped > PKA_PHYS_REG_LAST_MAPPABLE) {
+        phys_reg = evict_phys_reg();
+    } else {
+        phys_reg = phys_reg_next_mapped;
+        phys_reg_next_mapped += 1;
+    }
+#else
+    assert(phys_reg_next_mapped <= PKA_PHYS_REG_LAST_MAPPABLE);
+
     phys_reg = phys_reg_next_mapped;
     phys_reg_next_mapped += 1;
+#endif /* CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE */
+
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+    pka_reg_stats.maps += 1;
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
 
     while(!P_CC3XX->pka.pka_done) {}
     P_CC3XX->pka.memory_map[phys_reg] = virt_reg_sram_addr[virt_reg];
@@ -310,6 +383,11 @@ static void CC3XX_ATTRIBUTE_INLINE ensure_virt_reg_is_mapped(cc3xx_pka_reg_id_t
     if (!virt_reg_is_mapped[reg_id]) {
         allocate_phys_reg(reg_id);
     }
+
+#ifdef CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE
+    phys_reg_use_count += 1;
+    phys_reg_last_use[virt_reg_phys_reg[reg_id]] = phys_reg_use_count;
+#endif /* CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE */
 }
 
 static void pka_write_reg(cc3xx_pka_reg_id_t reg_id, const uint32_t *data,
@@ -605,6 +683,18 @@ void cc3xx_lowlevel_pka_set_state(const struct cc3xx_pka_state_t *state,
     }
 }
 
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+void cc3xx_lowlevel_pka_get_reg_stats(struct cc3xx_pka_reg_stats_t *stats)
+{
+    memcpy(stats, &pka_reg_stats, sizeof(*stats));
+}
+
+void cc3xx_lowlevel_pka_reset_reg_stats(void)
+{
+    memset(&pka_reg_stats, 0, sizeof(pka_reg_stats));
+}
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
+
 void cc3xx_lowlevel_pka_uninit(void)
 {
     memset(&pka_state, 0, sizeof(pka_state));
@@ -281,6 +281,33 @@ static struct {
     .reseed = cc3xx_lowlevel_drbg_hash_reseed};
 #endif /* CC3XX_CONFIG_RNG_DRBG_HMAC */
 
+#ifdef CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE
+#if (CC3XX_CONFIG_RNG_ENTROPY_POOL_SIZE % CC3XX_RNG_ENTROPY_SIZE) != 0
+#error "cc3xx_config: RNG entropy pool size must be a multiple of CC3XX_RNG_ENTROPY_SIZE"
+#endif
+#if CC3XX_CONFIG_RNG_ENTROPY_POOL_LOW_WATER_MARK > CC3XX_CONFIG_RNG_ENTROPY_POOL_SIZE
+#error "cc3xx_config: RNG entropy pool low water mark must not exceed the pool size"
+#endif
+
+/**
+ * @brief Entropy collected from the TRNG ahead of time. Only the first
+ *        \a available bytes of \a buf hold entropy, which has already been
+ *        through the same health tests as entropy collected on demand. The
+ *        pool is consumed from the end, so what is left stays contiguous.
+ */
+static struct {
+    uint32_t buf[CC3XX_CONFIG_RNG_ENTROPY_POOL_SIZE / sizeof(uint32_t)];
+    size_t available;
+} g_entropy_pool;
+
+static void entropy_pool_flush(void)
+{
+    cc3xx_secure_erase_buffer(g_entropy_pool.buf,
+                              sizeof(g_entropy_pool.buf) / sizeof(uint32_t));
+    g_entropy_pool.available = 0;
+}
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE */
+
 #ifndef CC3XX_CONFIG_RNG_EXTERNAL_TRNG
 /**
  * @brief The ROSC config holds the parameters for a ring oscillator (ROSC) from
@@ -534,6 +561,9 @@ cc3xx_err_t cc3xx_lowlevel_rng_sp800_90b_mode(bool enable)
 
     g_trng_tests.continuous = enable;
 
+    /* With the entropy pool enabled, this also drops what was pooled
+     * under the previous mode
+     */
     cc3xx_lowlevel_rng_set_hw_test_bypass(true, false, true);
 
     return CC3XX_ERR_SUCCESS;
@@ -553,6 +583,11 @@ cc3xx_err_t cc3xx_lowlevel_rng_set_config(enum cc3xx_rng_rosc_id_t rosc_id,
     g_trng_config.rosc.id = rosc_id;
     g_trng_config.rosc.subsampling_rate = subsampling_rate;
 
+#ifdef CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE
+    /* Pooled entropy was collected under the previous configuration */
+    entropy_pool_flush();
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE */
+
     return CC3XX_ERR_SUCCESS;
 }
 
@@ -568,10 +603,15 @@ void cc3xx_lowlevel_rng_set_hw_test_bypass(
     hw_entropy_tests_control |= bypass_vnc ? (1UL << 1) : 0x0UL;
 
     g_trng_config.debug_control = hw_entropy_tests_control;
+
+#ifdef CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE
+    /* Pooled entropy was collected under the previous configuration */
+    entropy_pool_flush();
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE */
 }
 #endif /* !CC3XX_CONFIG_RNG_EXTERNAL_TRNG */
 
-cc3xx_err_t cc3xx_lowlevel_rng_get_entropy(uint32_t *entropy, size_t entropy_len)
+static cc3xx_err_t trng_get_entropy(uint32_t *entropy, size_t entropy_len)
 {
     cc3xx_err_t err;
     size_t num_words = 0;
@@ -609,6 +649,60 @@ cleanup:
     return err;
 }
 
+#ifdef CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE
+cc3xx_err_t cc3xx_lowlevel_rng_refill_entropy_pool(void)
+{
+    cc3xx_err_t err;
+    size_t refill_len = sizeof(g_entropy_pool.buf) - g_entropy_pool.available;
+
+    if (refill_len == 0) {
+        return CC3XX_ERR_SUCCESS;
+    }
+
+    err = trng_get_entropy(&g_entropy_pool.buf[g_entropy_pool.available / sizeof(uint32_t)],
+                           refill_len);
+    if (err != CC3XX_ERR_SUCCESS) {
+        /* Don't keep anything from a collection that failed its tests */
+        entropy_pool_flush();
+        return err;
+    }
+
+    g_entropy_pool.available += refill_len;
+
+    return CC3XX_ERR_SUCCESS;
+}
+
+bool cc3xx_lowlevel_rng_entropy_pool_needs_refill(void)
+{
+    return g_entropy_pool.available < CC3XX_CONFIG_RNG_ENTROPY_POOL_LOW_WATER_MARK;
+}
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE */
+
+cc3xx_err_t cc3xx_lowlevel_rng_get_entropy(uint32_t *entropy, size_t entropy_len)
+{
+#ifdef CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE
+    uint32_t *pooled;
+
+    assert((entropy_len % sizeof(P_CC3XX->rng.ehr_data)) == 0);
+
+    /* A request that the pool can't satisfy in full is collected from the TRNG
+     * directly, rather than partly from the pool, so the pool is kept for the
+     * small seeding requests on the hot path.
+     */
+    if (entropy_len <= g_entropy_pool.available) {
+        g_entropy_pool.available -= entropy_len;
+        pooled = &g_entropy_pool.buf[g_entropy_pool.available / sizeof(uint32_t)];
+
+        memcpy(entropy, pooled, entropy_len);
+        cc3xx_secure_erase_buffer(pooled, entropy_len / sizeof(uint32_t));
+
+        return CC3XX_ERR_SUCCESS;
+    }
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE */
+
+    return trng_get_entropy(entropy, entropy_len);
+}
+
 cc3xx_err_t cc3xx_lowlevel_rng_get_random(uint8_t* buf, size_t length,
                                           enum cc3xx_rng_quality_t quality)
 {
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Runs the cc3xx test suite against the register model on the host, and
+ * prints the modelled hardware work done by each test.
+ */
+
+#include "cc3xx_model.h"
+#include "cc3xx_init.h"
+#include "cc3xx_tests.h"
+#include "test_framework.h"
+#include "tfm_hal_device_header.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TEST_AMOUNT 128
+
+static struct test_t test_list[MAX_TEST_AMOUNT];
+
+static DCB_Type dcb;
+static DWT_Type dwt;
+static uint64_t cyccnt_base;
+
+DCB_Type *cc3xx_model_host_dcb(void)
+{
+    return &dcb;
+}
+
+DWT_Type *cc3xx_model_host_dwt(void)
+{
+    static uint32_t last_cyccnt;
+    uint64_t cycles = cc3xx_model_get_cycles();
+
+    /* A value different to the one last published was written by the test */
+    if (dwt.CYCCNT != last_cyccnt) {
+        cyccnt_base = cycles - dwt.CYCCNT;
+    }
+
+    dwt.CYCCNT = (uint32_t)(cycles - cyccnt_base);
+    last_cyccnt = dwt.CYCCNT;
+
+    return &dwt;
+}
+
+void printf_set_color(enum serial_color_t color_id)
+{
+    if (color_id == DEFAULT) {
+        printf("\33[0m");
+    } else {
+        printf("\33[3%dm", (int)color_id - 1);
+    }
+}
+
+static void print_stats(const struct cc3xx_model_stats_t *stats)
+{
+    printf("    regs r/w %" PRIu64 "/%" PRIu64 ", dma %" PRIu64 " (%" PRIu64
+           " in, %" PRIu64 " out), aes %" PRIu64 ", hash %" PRIu64
+           ", ghash %" PRIu64 ", chacha %" PRIu64 ", pka %" PRIu64
+           ", rng %" PRIu64 ", cycles %" PRIu64 "\r\n",
+           stats->reg_reads, stats->reg_writes, stats->dma_transfers,
+           stats->dma_bytes_in, stats->dma_bytes_out, stats->aes_blocks,
+           stats->hash_blocks, stats->ghash_blocks, stats->chacha_blocks,
+           stats->pka_ops, stats->rng_words, stats->cycles);
+}
+
+static int run_tests(void *arg)
+{
+    struct test_suite_t suite = {
+        .list_size = 0,
+        .test_list = test_list,
+        .name = "CC3XX model",
+    };
+    struct cc3xx_model_stats_t stats;
+    uint32_t failed = 0;
+    uint32_t idx;
+
+    (void)arg;
+
+    if (cc3xx_lowlevel_init() != CC3XX_ERR_SUCCESS) {
+        printf("cc3xx_lowlevel_init failed\r\n");
+        return 1;
+    }
+
+    add_cc3xx_tests_to_testsuite(&suite, MAX_TEST_AMOUNT);
+
+    for (idx = 0; idx < suite.list_size; idx++) {
+        struct test_result_t ret = {TEST_PASSED, NULL, NULL, 0};
+
+        printf("> %s: %s\r\n", suite.test_list[idx].name,
+               suite.test_list[idx].desc);
+
+        cc3xx_model_reset_stats();
+        suite.test_list[idx].test(&ret);
+        cc3xx_model_get_stats(&stats);
+
+        if (ret.val == TEST_FAILED) {
+            failed++;
+            printf("  FAILED: %s (%s:%" PRIu32 ")\r\n",
+                   ret.info_msg ? ret.info_msg : "", ret.filename ? ret.filename : "",
+                   ret.line);
+        } else {
+            printf("  %s\r\n", ret.val == TEST_SKIPPED ? "SKIPPED" : "PASSED");
+        }
+        print_stats(&stats);
+    }
+
+    printf("%" PRIu32 " of %" PRIu32 " tests failed\r\n", failed, suite.list_size);
+
+    return failed != 0;
+}
+
+int main(void)
+{
+    const char *seed = getenv("CC3XX_MODEL_RNG_SEED");
+
+    if (cc3xx_model_init(NULL) != 0) {
+        fprintf(stderr, "Failed to set up the CC3XX model\n");
+        return 1;
+    }
+
+    if (seed != NULL) {
+        cc3xx_model_set_rng_seed(strtoull(seed, NULL, 0));
+    }
+
+    return cc3xx_model_run(run_tests, NULL);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * The subset of the tf-m-tests framework used by the cc3xx tests, so that they
+ * can run in the host model runner without the rest of the regression suite.
+ */
+
+#ifndef __TEST_FRAMEWORK_H__
+#define __TEST_FRAMEWORK_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum test_status_t {
+    TEST_PASSED = 0,
+    TEST_FAILED = 1,
+    TEST_SKIPPED = 2,
+};
+
+struct test_result_t {
+    enum test_status_t val;
+    const char *info_msg;
+    const char *filename;
+    uint32_t line;
+};
+
+typedef void TEST_FUN(struct test_result_t *ret);
+
+struct test_t {
+    TEST_FUN * const test;
+    const char *name;
+    const char *desc;
+};
+
+struct test_suite_t {
+    void (*freg)(struct test_suite_t *);
+    uint32_t list_size;
+    struct test_t *test_list;
+    const char *name;
+    enum test_status_t val;
+};
+
+enum serial_color_t {
+    DEFAULT = 0,
+    BLACK,
+    RED,
+    GREEN,
+    YELLOW,
+    BLUE,
+    MAGENTA,
+    CYAN,
+    WHITE,
+};
+
+#define TEST_LOG(...) printf(__VA_ARGS__)
+
+#define TEST_FAIL(msg) do {       \
+        ret->val = TEST_FAILED;   \
+        ret->info_msg = (msg);    \
+        ret->filename = __FILE__; \
+        ret->line = __LINE__;     \
+    } while (0)
+
+void printf_set_color(enum serial_color_t color_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TEST_FRAMEWORK_H__ */
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Host stand-in for the device header, providing just the DWT cycle counter
+ * that the cc3xx tests use. CYCCNT reads back the cycles of the CC3XX model,
+ * so cycle count tests report modelled hardware time rather than host time.
+ */
+
+#ifndef __TFM_HAL_DEVICE_HEADER_H__
+#define __TFM_HAL_DEVICE_HEADER_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DCB_DEMCR_TRCENA_Msk     (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk   (1UL << 0)
+
+typedef struct {
+    uint32_t DEMCR;
+} DCB_Type;
+
+typedef struct {
+    uint32_t CTRL;
+    uint32_t CYCCNT;
+} DWT_Type;
+
+DCB_Type *cc3xx_model_host_dcb(void);
+DWT_Type *cc3xx_model_host_dwt(void);
+
+#define DCB (cc3xx_model_host_dcb())
+#define DWT (cc3xx_model_host_dwt())
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_HAL_DEVICE_HEADER_H__ */
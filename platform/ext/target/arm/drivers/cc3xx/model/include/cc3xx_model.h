@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef CC3XX_MODEL_H
+#define CC3XX_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Total size of the modelled OTP, starting at the HUK */
+#define CC3XX_MODEL_OTP_SIZE 0x800
+
+/* Register blocks which have their accesses counted separately */
+enum cc3xx_model_block_t {
+    CC3XX_MODEL_BLOCK_PKA = 0,
+    CC3XX_MODEL_BLOCK_RNG,
+    CC3XX_MODEL_BLOCK_CHACHA,
+    CC3XX_MODEL_BLOCK_AES,
+    CC3XX_MODEL_BLOCK_HASH,
+    CC3XX_MODEL_BLOCK_MISC,
+    CC3XX_MODEL_BLOCK_CC_CTL,
+    CC3XX_MODEL_BLOCK_GHASH,
+    CC3XX_MODEL_BLOCK_HOST_RGF,
+    CC3XX_MODEL_BLOCK_AHB,
+    CC3XX_MODEL_BLOCK_DIN,
+    CC3XX_MODEL_BLOCK_DOUT,
+    CC3XX_MODEL_BLOCK_HOST_SRAM,
+    CC3XX_MODEL_BLOCK_ID,
+    CC3XX_MODEL_BLOCK_AO,
+    CC3XX_MODEL_BLOCK_NVM,
+    CC3XX_MODEL_BLOCK_OTP,
+    CC3XX_MODEL_BLOCK_AMOUNT,
+};
+
+/**
+ * @brief Counters of the work done by the modelled hardware. All the counters
+ *        are cumulative since the last \a cc3xx_model_reset_stats.
+ */
+struct cc3xx_model_stats_t {
+    uint64_t reg_reads;        /*!< Register reads made by the driver */
+    uint64_t reg_writes;       /*!< Register writes made by the driver */
+    uint64_t block_accesses[CC3XX_MODEL_BLOCK_AMOUNT]; /*!< Accesses per block */
+    uint64_t dma_transfers;    /*!< DMA transfers started */
+    uint64_t dma_bytes_in;     /*!< Bytes read by the DMA */
+    uint64_t dma_bytes_out;    /*!< Bytes written by the DMA */
+    uint64_t aes_blocks;       /*!< AES block cipher invocations */
+    uint64_t hash_blocks;      /*!< SHA compression function invocations */
+    uint64_t ghash_blocks;     /*!< GHASH multiplications */
+    uint64_t chacha_blocks;    /*!< ChaCha20 block function invocations */
+    uint64_t pka_ops;          /*!< PKA opcodes executed */
+    uint64_t pka_sram_accesses; /*!< Words moved through the PKA SRAM port */
+    uint64_t rng_words;        /*!< Words read from the TRNG EHR */
+    uint64_t cycles;           /*!< Modelled cycles, see cc3xx_model_timing_t */
+};
+
+/**
+ * @brief The cost in cycles of each modelled operation. The defaults are rough
+ *        approximations of a CC-312 clocked with the CPU, intended to make
+ *        relative comparisons between driver changes meaningful, not to
+ *        predict absolute hardware numbers.
+ */
+struct cc3xx_model_timing_t {
+    uint32_t reg_access;       /*!< Per register read or write */
+    uint32_t dma_setup;        /*!< Per DMA transfer */
+    uint32_t dma_bytes_per_cycle; /*!< DMA bus throughput */
+    uint32_t aes_block;        /*!< Per AES block, 128 bit key. Larger keys add 2 cycles per 2 rounds */
+    uint32_t hash_block;       /*!< Per SHA-1/SHA-2 64-byte block */
+    uint32_t ghash_block;      /*!< Per GHASH 16-byte block */
+    uint32_t chacha_block;     /*!< Per ChaCha20 64-byte block */
+    uint32_t pka_op;           /*!< Fixed overhead of each PKA opcode */
+    uint32_t pka_digit;        /*!< Per 64-bit digit for linear PKA opcodes */
+    uint32_t pka_mul_digit;    /*!< Per digit squared for PKA multiplications */
+};
+
+/**
+ * @brief                      Sets up the model: maps the trapping register
+ *                             window, installs the signal handlers and resets
+ *                             all registers to their reset values. Must be
+ *                             called before any cc3xx driver function.
+ *
+ * @param[in]  timing          The cycle costs to use, or NULL for the defaults.
+ *
+ * @return                     0 on success, -1 if the host can't run the model.
+ */
+int cc3xx_model_init(const struct cc3xx_model_timing_t *timing);
+
+/**
+ * @brief                      Puts every register, the PKA SRAM and the engine
+ *                             state back to their reset values. The OTP
+ *                             contents and the statistics are preserved.
+ */
+void cc3xx_model_reset(void);
+
+/**
+ * @brief                      Runs a function with a stack placed below 4GiB.
+ *                             The DMA address registers are 32 bits wide, so
+ *                             every buffer handed to the driver (which includes
+ *                             stack buffers) must be 32-bit addressable. The
+ *                             program must also be linked as non-PIE so that
+ *                             its static data is.
+ *
+ * @param[in]  fn              The function to run.
+ * @param[in]  arg             The argument passed to fn.
+ *
+ * @return                     The return value of fn, or -1 if the stack could
+ *                             not be allocated.
+ */
+int cc3xx_model_run(int (*fn)(void *arg), void *arg);
+
+/**
+ * @brief                      Copies the counters accumulated so far.
+ *
+ * @param[out] stats           The buffer to fill.
+ */
+void cc3xx_model_get_stats(struct cc3xx_model_stats_t *stats);
+
+/**
+ * @brief                      Clears all the counters.
+ */
+void cc3xx_model_reset_stats(void);
+
+/**
+ * @brief                      Returns the current modelled cycle count. This
+ *                             is the value behind the host DWT CYCCNT shim.
+ */
+uint64_t cc3xx_model_get_cycles(void);
+
+/**
+ * @brief                      Writes the modelled OTP directly, bypassing the
+ *                             fuse semantics (bits can be cleared). Used to set
+ *                             up keys and flags before a test.
+ *
+ * @param[in]  offset          Byte offset from the start of the OTP (the HUK).
+ * @param[in]  buf             The data to write.
+ * @param[in]  size            Size of the data in bytes.
+ *
+ * @return                     0 on success, -1 if the range is outside the OTP.
+ */
+int cc3xx_model_otp_write(size_t offset, const void *buf, size_t size);
+
+/**
+ * @brief                      Sets the lifecycle state reported in LCS_REG.
+ *
+ * @param[in]  lcs             The raw LCS value (CM 0, DM 1, SE 5, RMA 7).
+ */
+void cc3xx_model_set_lcs(uint32_t lcs);
+
+/**
+ * @brief                      Sets the keys that are not held in the OTP and
+ *                             so can't be provisioned through it.
+ *
+ * @param[in]  krtl            The 128-bit RTL key, or NULL to leave unchanged.
+ * @param[in]  guk             The 256-bit group unique key, or NULL to leave
+ *                             unchanged.
+ */
+void cc3xx_model_set_fixed_keys(const uint32_t *krtl, const uint32_t *guk);
+
+/**
+ * @brief                      Seeds the deterministic generator behind the
+ *                             TRNG EHR registers, so runs are reproducible.
+ *
+ * @param[in]  seed            The seed.
+ */
+void cc3xx_model_set_rng_seed(uint64_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC3XX_MODEL_H */
@@ -0,0 +1,691 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Register-level model of the CC3XX for host builds of the low-level driver.
+ *
+ * The driver is unmodified: P_CC3XX points at a window which is mapped with no
+ * access rights, so that every register access faults. The SIGSEGV handler
+ * performs the side effects of a read, fills the page with the current register
+ * values, makes it accessible and single-steps the faulting instruction with
+ * the trap flag. The SIGTRAP handler which follows then compares the page with
+ * the register values to find what was written, performs the side effects of
+ * the write and removes the access rights again. As each of those steps is a
+ * kernel round trip, plain 32-bit MOV loads and stores, which are nearly all of
+ * the accesses the driver makes, are instead decoded and completed in the
+ * SIGSEGV handler on x86-64 hosts. This needs the x86 page fault
+ * error code and trap flag, so only x86 Linux hosts are supported, the model is
+ * not thread-safe, and a debugger will need to be told to pass SIGSEGV and
+ * SIGTRAP through to the program.
+ */
+
+#define _GNU_SOURCE
+
+#include "cc3xx_model_private.h"
+
+#include <assert.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#if !defined(__linux__) || !(defined(__x86_64__) || defined(__i386__))
+#error "The CC3XX model register trapping needs an x86 Linux host"
+#endif
+
+/* x86 page fault error code bit for a write access */
+#define X86_PF_WRITE      (1UL << 1)
+/* x86 EFLAGS trap flag, which single-steps the next instruction */
+#define X86_EFLAGS_TF     (1UL << 8)
+
+#define MODEL_PAGE_SIZE   0x1000
+#define MODEL_STACK_SIZE  (8 * 1024 * 1024)
+
+/* LCS register values */
+#define MODEL_LCS_SE      0x5U
+
+/* host_rgf_irr bits */
+#define MODEL_IRR_MEM_TO_DIN    (1U << 6)
+#define MODEL_IRR_DOUT_TO_MEM   (1U << 7)
+#define MODEL_IRR_DMA_COMPLETED (1U << 11)
+
+_Static_assert(offsetof(struct _cc3xx_reg_map_t, otp) + CC3XX_MODEL_OTP_SIZE
+               <= CC3XX_MODEL_REG_SPACE_SIZE,
+               "The OTP does not fit in the modelled register space");
+
+struct cc3xx_model_t cc3xx_model;
+uintptr_t cc3xx_model_base_address;
+
+static const struct cc3xx_model_timing_t default_timing = {
+    .reg_access = 2,
+    .dma_setup = 24,
+    .dma_bytes_per_cycle = 4,
+    .aes_block = 14,
+    .hash_block = 68,
+    .ghash_block = 8,
+    .chacha_block = 40,
+    .pka_op = 10,
+    .pka_digit = 2,
+    .pka_mul_digit = 1,
+};
+
+static const struct {
+    size_t offset;
+    enum cc3xx_model_block_t block;
+} block_offsets[] = {
+    { offsetof(struct _cc3xx_reg_map_t, pka),       CC3XX_MODEL_BLOCK_PKA },
+    { offsetof(struct _cc3xx_reg_map_t, rng),       CC3XX_MODEL_BLOCK_RNG },
+    { offsetof(struct _cc3xx_reg_map_t, chacha),    CC3XX_MODEL_BLOCK_CHACHA },
+    { offsetof(struct _cc3xx_reg_map_t, aes),       CC3XX_MODEL_BLOCK_AES },
+    { offsetof(struct _cc3xx_reg_map_t, hash),      CC3XX_MODEL_BLOCK_HASH },
+    { offsetof(struct _cc3xx_reg_map_t, misc),      CC3XX_MODEL_BLOCK_MISC },
+    { offsetof(struct _cc3xx_reg_map_t, cc_ctl),    CC3XX_MODEL_BLOCK_CC_CTL },
+    { offsetof(struct _cc3xx_reg_map_t, ghash),     CC3XX_MODEL_BLOCK_GHASH },
+    { offsetof(struct _cc3xx_reg_map_t, host_rgf),  CC3XX_MODEL_BLOCK_HOST_RGF },
+    { offsetof(struct _cc3xx_reg_map_t, ahb),       CC3XX_MODEL_BLOCK_AHB },
+    { offsetof(struct _cc3xx_reg_map_t, din),       CC3XX_MODEL_BLOCK_DIN },
+    { offsetof(struct _cc3xx_reg_map_t, dout),      CC3XX_MODEL_BLOCK_DOUT },
+    { offsetof(struct _cc3xx_reg_map_t, host_sram), CC3XX_MODEL_BLOCK_HOST_SRAM },
+    { offsetof(struct _cc3xx_reg_map_t, id),        CC3XX_MODEL_BLOCK_ID },
+    { offsetof(struct _cc3xx_reg_map_t, ao),        CC3XX_MODEL_BLOCK_AO },
+    { offsetof(struct _cc3xx_reg_map_t, nvm),       CC3XX_MODEL_BLOCK_NVM },
+    { offsetof(struct _cc3xx_reg_map_t, otp),       CC3XX_MODEL_BLOCK_OTP },
+};
+
+/* Registers which can't be changed by the host. A write to them is dropped. */
+static const size_t read_only_regs[] = {
+    CC3XX_MODEL_IDX(pka.pka_status),
+    CC3XX_MODEL_IDX(pka.pka_pipe_rdy),
+    CC3XX_MODEL_IDX(pka.pka_done),
+    CC3XX_MODEL_IDX(rng.rng_isr),
+    CC3XX_MODEL_IDX(aes.aes_busy),
+    CC3XX_MODEL_IDX(aes.aes_hw_flags),
+    CC3XX_MODEL_IDX(aes.aes_dfa_err_status),
+    CC3XX_MODEL_IDX(aes.aes_rbg_seeding_rdy),
+    CC3XX_MODEL_IDX(chacha.chacha_busy),
+    CC3XX_MODEL_IDX(chacha.chacha_hw_flags),
+    CC3XX_MODEL_IDX(cc_ctl.crypto_busy),
+    CC3XX_MODEL_IDX(cc_ctl.hash_busy),
+    CC3XX_MODEL_IDX(ghash.ghash_busy),
+    CC3XX_MODEL_IDX(host_rgf.host_rgf_irr),
+    CC3XX_MODEL_IDX(host_rgf.host_boot),
+    CC3XX_MODEL_IDX(host_rgf.host_remove_ghash_engine),
+    CC3XX_MODEL_IDX(host_rgf.host_remove_chacha_engine),
+    CC3XX_MODEL_IDX(id.peripheral_id_0),
+    CC3XX_MODEL_IDX(nvm.aib_fuse_prog_completed),
+    CC3XX_MODEL_IDX(nvm.lcs_is_valid),
+    CC3XX_MODEL_IDX(nvm.nvm_is_idle),
+    CC3XX_MODEL_IDX(nvm.lcs_reg),
+};
+
+/* State carried from the fault to the single-step trap */
+static struct {
+    bool pending;
+    bool is_write;
+    uintptr_t page;
+    size_t idx;
+} trap;
+
+static uint32_t window_snapshot[MODEL_PAGE_SIZE / sizeof(uint32_t)];
+
+void cc3xx_model_fatal(const char *msg)
+{
+    /* Only async-signal-safe calls, as this can be called from the handlers */
+    (void)write(STDERR_FILENO, "cc3xx_model: ", 13);
+    (void)write(STDERR_FILENO, msg, strlen(msg));
+    (void)write(STDERR_FILENO, "\n", 1);
+    abort();
+}
+
+static uint32_t rng_next(void)
+{
+    /* splitmix64, which is plenty for a model */
+    uint64_t z = (cc3xx_model.rng_state += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (uint32_t)(z ^ (z >> 31));
+}
+
+static void count_access(size_t idx, bool is_write)
+{
+    size_t offset = idx * sizeof(uint32_t);
+    size_t block;
+
+    for (block = CC3XX_MODEL_BLOCK_AMOUNT - 1; block > 0; block--) {
+        if (offset >= block_offsets[block].offset) {
+            break;
+        }
+    }
+
+    cc3xx_model.stats.block_accesses[block_offsets[block].block]++;
+    if (is_write) {
+        cc3xx_model.stats.reg_writes++;
+    } else {
+        cc3xx_model.stats.reg_reads++;
+    }
+    cc3xx_model_add_cycles(cc3xx_model.timing.reg_access);
+}
+
+static void dma_transfer(uint32_t length)
+{
+    const uint8_t *in = (const uint8_t *)(uintptr_t)CC3XX_MODEL_REG(din.src_lli_word0);
+    uint8_t *out = (uint8_t *)(uintptr_t)CC3XX_MODEL_REG(dout.dst_lli_word0);
+    uint32_t engine = CC3XX_MODEL_REG(cc_ctl.crypto_ctl);
+    static uint8_t scratch[0x10000];
+    uint8_t *result = scratch;
+    bool has_output = true;
+    uint64_t start_cycles = cc3xx_model.stats.cycles;
+    uint64_t engine_cycles;
+    uint64_t xfer_cycles;
+
+    if (length > sizeof(scratch)) {
+        cc3xx_model_fatal("DMA transfer longer than the 16-bit length field");
+    }
+
+    switch (engine) {
+    case 0x0: /* Passthrough */
+        memcpy(scratch, in, length);
+        break;
+    case 0x1: /* AES */
+        cc3xx_model_aes_process(in, scratch, length);
+        break;
+    case 0x2: /* AES to hash */
+        cc3xx_model_aes_process(in, scratch, length);
+        cc3xx_model_hash_process(scratch, length);
+        has_output = false;
+        break;
+    case 0x3: /* AES and hash, the hash taking the input */
+        cc3xx_model_hash_process(in, length);
+        cc3xx_model_aes_process(in, scratch, length);
+        break;
+    case 0x7: /* Hash */
+        cc3xx_model_hash_process(in, length);
+        has_output = false;
+        break;
+    case 0x9: /* AES MAC and bypass */
+        cc3xx_model_aes_process(in, scratch, length);
+        result = (uint8_t *)in;
+        break;
+    case 0xA: /* AES to hash and DOUT */
+        cc3xx_model_aes_process(in, scratch, length);
+        cc3xx_model_hash_process(scratch, length);
+        break;
+    case 0x10: /* ChaCha */
+        cc3xx_model_chacha_process(in, scratch, length);
+        break;
+    default:
+        cc3xx_model_fatal("DMA started with an unsupported engine selected");
+    }
+
+    /* The engine writes to DOUT, which is discarded if no destination was
+     * programmed for this transfer.
+     */
+    if (has_output && cc3xx_model.dout_armed) {
+        memmove(out, result, length);
+        cc3xx_model.stats.dma_bytes_out += length;
+    }
+
+    cc3xx_model.stats.dma_transfers++;
+    cc3xx_model.stats.dma_bytes_in += length;
+
+    /* The DMA streams while the engine works, so the slower of the two sets
+     * the duration of the transfer.
+     */
+    engine_cycles = cc3xx_model.stats.cycles - start_cycles;
+    xfer_cycles = length / cc3xx_model.timing.dma_bytes_per_cycle;
+    cc3xx_model.stats.cycles = start_cycles + cc3xx_model.timing.dma_setup
+                             + (engine_cycles > xfer_cycles ? engine_cycles
+                                                            : xfer_cycles);
+
+    /* Raise both the CC312 completion interrupt and the CC310 ones, so that
+     * either build of the driver sees the transfer finish.
+     */
+    CC3XX_MODEL_REG(host_rgf.host_rgf_irr) |= MODEL_IRR_DMA_COMPLETED
+                                            | MODEL_IRR_MEM_TO_DIN;
+    if (cc3xx_model.dout_armed) {
+        CC3XX_MODEL_REG(host_rgf.host_rgf_irr) |= MODEL_IRR_DOUT_TO_MEM;
+    }
+
+    cc3xx_model.dout_armed = false;
+}
+
+static bool is_read_only(size_t idx)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(read_only_regs) / sizeof(read_only_regs[0]); i++) {
+        if (read_only_regs[i] == idx) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void handle_read(size_t idx)
+{
+    if (idx == CC3XX_MODEL_IDX(pka.pka_sram_rdata)) {
+        cc3xx_model.regs[idx] = cc3xx_model.pka_sram[cc3xx_model.pka_sram_raddr
+                                % (CC3XX_MODEL_PKA_SRAM_SIZE / sizeof(uint32_t))];
+        cc3xx_model.pka_sram_raddr++;
+        cc3xx_model.stats.pka_sram_accesses++;
+    } else if (idx == CC3XX_MODEL_IDX(rng.rng_isr)) {
+        /* The EHR is refilled instantly, so is valid whenever the source is
+         * enabled, and the statistical tests never fail.
+         */
+        cc3xx_model.regs[idx] = CC3XX_MODEL_REG(rng.rnd_source_enable) & 0x1U;
+    } else if (idx >= CC3XX_MODEL_IDX(rng.ehr_data[0])
+               && idx <= CC3XX_MODEL_IDX(rng.ehr_data[5])) {
+        cc3xx_model.regs[idx] = rng_next();
+        cc3xx_model.stats.rng_words++;
+    }
+}
+
+static void handle_write(size_t idx, uint32_t old_val, uint32_t val)
+{
+    if (is_read_only(idx)) {
+        cc3xx_model.regs[idx] = old_val;
+        return;
+    }
+
+    if (idx >= CC3XX_MODEL_IDX(otp)) {
+        /* Fuses can only be blown, never restored */
+        cc3xx_model.regs[idx] = old_val | val;
+        return;
+    }
+
+    if (idx == CC3XX_MODEL_IDX(pka.opcode)) {
+        cc3xx_model_pka_execute(val);
+    } else if (idx == CC3XX_MODEL_IDX(pka.pka_sram_addr)) {
+        cc3xx_model.pka_sram_waddr = val;
+    } else if (idx == CC3XX_MODEL_IDX(pka.pka_sram_wdata)) {
+        cc3xx_model.pka_sram[cc3xx_model.pka_sram_waddr
+                             % (CC3XX_MODEL_PKA_SRAM_SIZE / sizeof(uint32_t))] = val;
+        cc3xx_model.pka_sram_waddr++;
+        cc3xx_model.stats.pka_sram_accesses++;
+    } else if (idx == CC3XX_MODEL_IDX(pka.pka_sram_raddr)) {
+        cc3xx_model.pka_sram_raddr = val;
+    } else if (idx == CC3XX_MODEL_IDX(rng.rng_sw_reset)) {
+        CC3XX_MODEL_REG(rng.sample_cnt1) = 0xFFFFU;
+    } else if (idx == CC3XX_MODEL_IDX(rng.rng_icr)) {
+        cc3xx_model.regs[idx] = 0;
+    } else if (idx == CC3XX_MODEL_IDX(aes.aes_sk)) {
+        cc3xx_model_aes_load_hw_key(false);
+    } else if (idx == CC3XX_MODEL_IDX(aes.aes_sk1)) {
+        cc3xx_model_aes_load_hw_key(true);
+    } else if (idx == CC3XX_MODEL_IDX(aes.aes_cmac_init)) {
+        cc3xx_model_aes_cmac_init();
+    } else if (idx == CC3XX_MODEL_IDX(aes.aes_cmac_size0_kick)) {
+        cc3xx_model_aes_cmac_size0_kick();
+    } else if (idx == CC3XX_MODEL_IDX(hash.hash_pad_cfg)) {
+        if (val & (0x1U << 2)) {
+            cc3xx_model_hash_pad_empty();
+        }
+    } else if (idx == CC3XX_MODEL_IDX(host_rgf.host_rgf_icr)) {
+        CC3XX_MODEL_REG(host_rgf.host_rgf_irr) &= ~val;
+        cc3xx_model.regs[idx] = 0;
+    } else if (idx == CC3XX_MODEL_IDX(dout.dst_lli_word1)) {
+        cc3xx_model.dout_armed = true;
+    } else if (idx == CC3XX_MODEL_IDX(din.src_lli_word1)) {
+        dma_transfer(val);
+    }
+}
+
+#if defined(__x86_64__)
+/* Completes a 32-bit MOV to or from a register without single-stepping it.
+ * Returns false for anything else, which then takes the single-step path.
+ */
+static bool emulate_access(ucontext_t *uc, uintptr_t addr)
+{
+    static const int gregs_idx[] = {
+        REG_RAX, REG_RCX, REG_RDX, REG_RBX, REG_RSP, REG_RBP, REG_RSI, REG_RDI,
+        REG_R8,  REG_R9,  REG_R10, REG_R11, REG_R12, REG_R13, REG_R14, REG_R15,
+    };
+    const uint8_t *insn = (const uint8_t *)uc->uc_mcontext.gregs[REG_RIP];
+    size_t idx = (addr - cc3xx_model_base_address) / sizeof(uint32_t);
+    uint8_t rex = 0;
+    uint8_t opcode;
+    uint8_t modrm;
+    uint8_t mod;
+    size_t len;
+    uint32_t old_val;
+    uint32_t val;
+    greg_t *reg;
+
+    if (addr & (sizeof(uint32_t) - 1)) {
+        return false;
+    }
+
+    if ((insn[0] & 0xF0) == 0x40) {
+        rex = insn[0];
+        insn++;
+    }
+
+    /* Only 32-bit operands: no REX.W, and MOV r32,m32 / m32,r32 / m32,imm32 */
+    opcode = insn[0];
+    modrm = insn[1];
+    mod = modrm >> 6;
+    if ((rex & 0x8) || mod == 3
+        || !(opcode == 0x8B || opcode == 0x89
+             || (opcode == 0xC7 && ((modrm >> 3) & 0x7) == 0))) {
+        return false;
+    }
+
+    len = 2;
+    if ((modrm & 0x7) == 4) {
+        /* SIB byte, with a disp32 and no base if the base is 5 and mod 0 */
+        if (mod == 0 && (insn[2] & 0x7) == 5) {
+            len += 4;
+        }
+        len++;
+    } else if (mod == 0 && (modrm & 0x7) == 5) {
+        /* RIP-relative */
+        len += 4;
+    }
+    if (mod == 1) {
+        len += 1;
+    } else if (mod == 2) {
+        len += 4;
+    }
+
+    reg = &uc->uc_mcontext.gregs[gregs_idx[((modrm >> 3) & 0x7)
+                                           | ((rex & 0x4) << 1)]];
+
+    if (opcode == 0x8B) {
+        handle_read(idx);
+        /* A 32-bit load zero-extends into the 64-bit register */
+        *reg = cc3xx_model.regs[idx];
+        count_access(idx, false);
+    } else {
+        if (opcode == 0xC7) {
+            memcpy(&val, insn + len, sizeof(val));
+            len += sizeof(val);
+        } else {
+            val = (uint32_t)*reg;
+        }
+        count_access(idx, true);
+        old_val = cc3xx_model.regs[idx];
+        cc3xx_model.regs[idx] = val;
+        handle_write(idx, old_val, val);
+    }
+
+    uc->uc_mcontext.gregs[REG_RIP] += len + (rex != 0);
+
+    return true;
+}
+#endif /* defined(__x86_64__) */
+
+static void segv_handler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = context;
+    uintptr_t addr = (uintptr_t)info->si_addr;
+    size_t page_idx;
+
+    (void)sig;
+
+    if (addr < cc3xx_model_base_address
+        || addr >= cc3xx_model_base_address + CC3XX_MODEL_REG_SPACE_SIZE) {
+        /* A genuine crash, so let it happen as it would without the model */
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    if (trap.pending) {
+        cc3xx_model_fatal("register access spans two pages");
+    }
+
+#if defined(__x86_64__)
+    if (emulate_access(uc, addr)) {
+        return;
+    }
+#endif /* defined(__x86_64__) */
+
+    trap.page = addr & ~((uintptr_t)MODEL_PAGE_SIZE - 1);
+    trap.idx = (addr - cc3xx_model_base_address) / sizeof(uint32_t);
+    trap.is_write = (uc->uc_mcontext.gregs[REG_ERR] & X86_PF_WRITE) != 0;
+    trap.pending = true;
+
+    if (!trap.is_write) {
+        handle_read(trap.idx);
+    }
+
+    page_idx = (trap.page - cc3xx_model_base_address) / sizeof(uint32_t);
+    memcpy(window_snapshot, &cc3xx_model.regs[page_idx], MODEL_PAGE_SIZE);
+
+    if (mprotect((void *)trap.page, MODEL_PAGE_SIZE, PROT_READ | PROT_WRITE)) {
+        cc3xx_model_fatal("failed to open the register window");
+    }
+    memcpy((void *)trap.page, window_snapshot, MODEL_PAGE_SIZE);
+
+    uc->uc_mcontext.gregs[REG_EFL] |= X86_EFLAGS_TF;
+}
+
+static void trap_handler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = context;
+    const uint32_t *window = (const uint32_t *)trap.page;
+    size_t page_idx;
+    size_t i;
+
+    (void)sig;
+    (void)info;
+
+    if (!trap.pending) {
+        /* Not ours, so behave as if there was no handler */
+        signal(SIGTRAP, SIG_DFL);
+        raise(SIGTRAP);
+        return;
+    }
+
+    uc->uc_mcontext.gregs[REG_EFL] &= ~X86_EFLAGS_TF;
+    trap.pending = false;
+
+    memcpy(window_snapshot, window, MODEL_PAGE_SIZE);
+    if (mprotect((void *)trap.page, MODEL_PAGE_SIZE, PROT_NONE)) {
+        cc3xx_model_fatal("failed to close the register window");
+    }
+
+    count_access(trap.idx, trap.is_write);
+
+    if (!trap.is_write) {
+        return;
+    }
+
+    /* Writes of the same value are still writes, so the faulting word is
+     * always handled even if it is unchanged.
+     */
+    page_idx = (trap.page - cc3xx_model_base_address) / sizeof(uint32_t);
+    for (i = 0; i < MODEL_PAGE_SIZE / sizeof(uint32_t); i++) {
+        uint32_t old_val = cc3xx_model.regs[page_idx + i];
+
+        if (window_snapshot[i] != old_val || page_idx + i == trap.idx) {
+            cc3xx_model.regs[page_idx + i] = window_snapshot[i];
+            handle_write(page_idx + i, old_val, window_snapshot[i]);
+        }
+    }
+}
+
+void cc3xx_model_reset(void)
+{
+    uint8_t otp[CC3XX_MODEL_OTP_SIZE];
+    size_t otp_idx = CC3XX_MODEL_IDX(otp);
+
+    memcpy(otp, &cc3xx_model.regs[otp_idx], sizeof(otp));
+    memset(cc3xx_model.regs, 0, sizeof(cc3xx_model.regs));
+    memcpy(&cc3xx_model.regs[otp_idx], otp, sizeof(otp));
+
+    memset(cc3xx_model.pka_sram, 0, sizeof(cc3xx_model.pka_sram));
+    cc3xx_model.pka_sram_waddr = 0;
+    cc3xx_model.pka_sram_raddr = 0;
+    memset(cc3xx_model.cmac_k1, 0, sizeof(cc3xx_model.cmac_k1));
+    memset(cc3xx_model.cmac_k2, 0, sizeof(cc3xx_model.cmac_k2));
+    cc3xx_model.dout_armed = false;
+
+    CC3XX_MODEL_REG(pka.pka_pipe_rdy) = 0x1U;
+    CC3XX_MODEL_REG(pka.pka_done) = 0x1U;
+
+    CC3XX_MODEL_REG(rng.sample_cnt1) = 0xFFFFU;
+
+    /* SUPPORT_256_192_KEY, CTR, DFA and the tunnelling engine */
+    CC3XX_MODEL_REG(aes.aes_hw_flags) = (1U << 0) | (1U << 3) | (1U << 10)
+                                      | (1U << 12);
+    CC3XX_MODEL_REG(aes.aes_rbg_seeding_rdy) = 0x1U;
+    CC3XX_MODEL_REG(chacha.chacha_hw_flags) = 0x1U;
+
+    /* Every engine and feature the driver checks for is present */
+    CC3XX_MODEL_REG(host_rgf.host_boot) = (1U << 11) | (1U << 15) | (1U << 17)
+                                        | (1U << 21) | (1U << 22) | (1U << 25)
+                                        | (1U << 27) | (1U << 28) | (1U << 30);
+
+    /* A CC312 revision with the DPA countermeasures */
+    CC3XX_MODEL_REG(id.peripheral_id_0) = 0xC1U;
+
+    CC3XX_MODEL_REG(nvm.aib_fuse_prog_completed) = 0x1U;
+    CC3XX_MODEL_REG(nvm.lcs_is_valid) = 0x1U;
+    CC3XX_MODEL_REG(nvm.nvm_is_idle) = 0x1U;
+    CC3XX_MODEL_REG(nvm.lcs_reg) = MODEL_LCS_SE;
+}
+
+int cc3xx_model_init(const struct cc3xx_model_timing_t *timing)
+{
+    struct sigaction sa;
+    void *window;
+
+    /* Buffers are handed to the DMA through 32-bit registers */
+    if ((uintptr_t)&cc3xx_model > UINT32_MAX) {
+        fprintf(stderr, "cc3xx_model: static data above 4GiB, link with -no-pie\n");
+        return -1;
+    }
+
+    if (cc3xx_model_base_address == 0) {
+        window = mmap(NULL, CC3XX_MODEL_REG_SPACE_SIZE, PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (window == MAP_FAILED) {
+            return -1;
+        }
+        cc3xx_model_base_address = (uintptr_t)window;
+
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_flags = SA_SIGINFO;
+        sigemptyset(&sa.sa_mask);
+
+        sa.sa_sigaction = segv_handler;
+        if (sigaction(SIGSEGV, &sa, NULL)) {
+            return -1;
+        }
+
+        sa.sa_sigaction = trap_handler;
+        if (sigaction(SIGTRAP, &sa, NULL)) {
+            return -1;
+        }
+    }
+
+    memset(cc3xx_model.regs, 0, sizeof(cc3xx_model.regs));
+    cc3xx_model.timing = timing != NULL ? *timing : default_timing;
+    if (cc3xx_model.timing.dma_bytes_per_cycle == 0) {
+        cc3xx_model.timing.dma_bytes_per_cycle = 1;
+    }
+
+    cc3xx_model_reset();
+    cc3xx_model_reset_stats();
+
+    return 0;
+}
+
+static struct {
+    ucontext_t caller;
+    int (*fn)(void *arg);
+    void *arg;
+    int ret;
+} run_ctx;
+
+static void run_trampoline(void)
+{
+    run_ctx.ret = run_ctx.fn(run_ctx.arg);
+}
+
+int cc3xx_model_run(int (*fn)(void *arg), void *arg)
+{
+    ucontext_t callee;
+    void *stack;
+
+    stack = mmap(NULL, MODEL_STACK_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if (stack == MAP_FAILED) {
+        return -1;
+    }
+
+    run_ctx.fn = fn;
+    run_ctx.arg = arg;
+
+    if (getcontext(&callee)) {
+        munmap(stack, MODEL_STACK_SIZE);
+        return -1;
+    }
+    callee.uc_stack.ss_sp = stack;
+    callee.uc_stack.ss_size = MODEL_STACK_SIZE;
+    callee.uc_link = &run_ctx.caller;
+    makecontext(&callee, run_trampoline, 0);
+
+    if (swapcontext(&run_ctx.caller, &callee)) {
+        run_ctx.ret = -1;
+    }
+
+    munmap(stack, MODEL_STACK_SIZE);
+
+    return run_ctx.ret;
+}
+
+void cc3xx_model_get_stats(struct cc3xx_model_stats_t *stats)
+{
+    *stats = cc3xx_model.stats;
+}
+
+void cc3xx_model_reset_stats(void)
+{
+    memset(&cc3xx_model.stats, 0, sizeof(cc3xx_model.stats));
+}
+
+uint64_t cc3xx_model_get_cycles(void)
+{
+    return cc3xx_model.stats.cycles;
+}
+
+int cc3xx_model_otp_write(size_t offset, const void *buf, size_t size)
+{
+    if (offset > CC3XX_MODEL_OTP_SIZE || size > CC3XX_MODEL_OTP_SIZE - offset) {
+        return -1;
+    }
+
+    memcpy((uint8_t *)&cc3xx_model.regs[CC3XX_MODEL_IDX(otp)] + offset, buf, size);
+
+    return 0;
+}
+
+void cc3xx_model_set_lcs(uint32_t lcs)
+{
+    CC3XX_MODEL_REG(nvm.lcs_reg) = lcs;
+}
+
+void cc3xx_model_set_fixed_keys(const uint32_t *krtl, const uint32_t *guk)
+{
+    if (krtl != NULL) {
+        memcpy(cc3xx_model.krtl, krtl, sizeof(cc3xx_model.krtl));
+    }
+    if (guk != NULL) {
+        memcpy(cc3xx_model.guk, guk, sizeof(cc3xx_model.guk));
+    }
+}
+
+void cc3xx_model_set_rng_seed(uint64_t seed)
+{
+    cc3xx_model.rng_state = seed;
+}
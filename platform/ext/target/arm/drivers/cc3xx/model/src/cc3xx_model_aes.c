@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "cc3xx_model_private.h"
+
+#include <string.h>
+
+#define AES_BLOCK_SIZE    16
+#define AES_MAX_ROUNDS    14
+
+/* aes_control fields */
+#define AES_CTRL_DECRYPT              (1U << 0)
+#define AES_CTRL_GCTR                 (1U << 1)
+#define AES_CTRL_MODE_KEY0_POS        2
+#define AES_CTRL_TUNNEL_IS_ON         (1U << 10)
+#define AES_CTRL_NK_KEY0_POS          12
+#define AES_CTRL_NK_KEY1_POS          14
+#define AES_CTRL_B1_USES_PADDED_IN    (1U << 23)
+
+enum aes_mode_t {
+    AES_MODE_ECB     = 0x0,
+    AES_MODE_CBC     = 0x1,
+    AES_MODE_CTR     = 0x2,
+    AES_MODE_CBC_MAC = 0x3,
+    AES_MODE_CMAC    = 0x7,
+};
+
+struct aes_ctx_t {
+    uint8_t rk[(AES_MAX_ROUNDS + 1) * AES_BLOCK_SIZE];
+    size_t nr;
+};
+
+static const uint8_t sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+static uint8_t inv_sbox[256];
+
+static uint8_t xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0x00));
+}
+
+static uint8_t gmul(uint8_t a, uint8_t b)
+{
+    uint8_t p = 0;
+
+    while (b) {
+        if (b & 1) {
+            p ^= a;
+        }
+        a = xtime(a);
+        b >>= 1;
+    }
+
+    return p;
+}
+
+static void aes_expand_key(struct aes_ctx_t *ctx, const uint8_t *key,
+                           size_t key_len)
+{
+    size_t nk = key_len / 4;
+    size_t total = (key_len / 4 + 7) * 4;
+    uint8_t rcon = 0x01;
+    uint8_t tmp[4];
+    size_t i;
+
+    ctx->nr = nk + 6;
+    memcpy(ctx->rk, key, key_len);
+
+    for (i = nk; i < total; i++) {
+        memcpy(tmp, &ctx->rk[(i - 1) * 4], 4);
+
+        if (i % nk == 0) {
+            uint8_t t = tmp[0];
+
+            tmp[0] = sbox[tmp[1]] ^ rcon;
+            tmp[1] = sbox[tmp[2]];
+            tmp[2] = sbox[tmp[3]];
+            tmp[3] = sbox[t];
+            rcon = xtime(rcon);
+        } else if (nk > 6 && i % nk == 4) {
+            tmp[0] = sbox[tmp[0]];
+            tmp[1] = sbox[tmp[1]];
+            tmp[2] = sbox[tmp[2]];
+            tmp[3] = sbox[tmp[3]];
+        }
+
+        ctx->rk[i * 4 + 0] = ctx->rk[(i - nk) * 4 + 0] ^ tmp[0];
+        ctx->rk[i * 4 + 1] = ctx->rk[(i - nk) * 4 + 1] ^ tmp[1];
+        ctx->rk[i * 4 + 2] = ctx->rk[(i - nk) * 4 + 2] ^ tmp[2];
+        ctx->rk[i * 4 + 3] = ctx->rk[(i - nk) * 4 + 3] ^ tmp[3];
+    }
+}
+
+static void add_round_key(uint8_t *s, const uint8_t *rk)
+{
+    size_t i;
+
+    for (i = 0; i < AES_BLOCK_SIZE; i++) {
+        s[i] ^= rk[i];
+    }
+}
+
+static void aes_encrypt(const struct aes_ctx_t *ctx, const uint8_t *in,
+                        uint8_t *out)
+{
+    uint8_t s[AES_BLOCK_SIZE];
+    uint8_t t[AES_BLOCK_SIZE];
+    size_t round;
+    size_t c;
+    size_t i;
+
+    memcpy(s, in, AES_BLOCK_SIZE);
+    add_round_key(s, ctx->rk);
+
+    for (round = 1; round <= ctx->nr; round++) {
+        /* SubBytes and ShiftRows */
+        for (i = 0; i < AES_BLOCK_SIZE; i++) {
+            t[i] = sbox[s[(i + 4 * (i % 4)) % AES_BLOCK_SIZE]];
+        }
+
+        /* MixColumns, skipped in the last round */
+        if (round != ctx->nr) {
+            for (c = 0; c < 4; c++) {
+                uint8_t *col = &t[c * 4];
+                uint8_t all = col[0] ^ col[1] ^ col[2] ^ col[3];
+                uint8_t first = col[0];
+
+                col[0] ^= all ^ xtime(col[0] ^ col[1]);
+                col[1] ^= all ^ xtime(col[1] ^ col[2]);
+                col[2] ^= all ^ xtime(col[2] ^ col[3]);
+                col[3] ^= all ^ xtime(col[3] ^ first);
+            }
+        }
+
+        memcpy(s, t, AES_BLOCK_SIZE);
+        add_round_key(s, &ctx->rk[round * AES_BLOCK_SIZE]);
+    }
+
+    memcpy(out, s, AES_BLOCK_SIZE);
+}
+
+static void aes_decrypt(const struct aes_ctx_t *ctx, const uint8_t *in,
+                        uint8_t *out)
+{
+    uint8_t s[AES_BLOCK_SIZE];
+    uint8_t t[AES_BLOCK_SIZE];
+    size_t round;
+    size_t c;
+    size_t i;
+
+    if (inv_sbox[sbox[1]] != 1) {
+        for (i = 0; i < 256; i++) {
+            inv_sbox[sbox[i]] = (uint8_t)i;
+        }
+    }
+
+    memcpy(s, in, AES_BLOCK_SIZE);
+    add_round_key(s, &ctx->rk[ctx->nr * AES_BLOCK_SIZE]);
+
+    for (round = ctx->nr; round > 0; round--) {
+        /* InvShiftRows and InvSubBytes */
+        for (i = 0; i < AES_BLOCK_SIZE; i++) {
+            t[(i + 4 * (i % 4)) % AES_BLOCK_SIZE] = inv_sbox[s[i]];
+        }
+
+        add_round_key(t, &ctx->rk[(round - 1) * AES_BLOCK_SIZE]);
+
+        /* InvMixColumns, skipped after the first round key */
+        if (round != 1) {
+            for (c = 0; c < 4; c++) {
+                uint8_t *col = &t[c * 4];
+                uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+
+                col[0] = gmul(a0, 14) ^ gmul(a1, 11) ^ gmul(a2, 13) ^ gmul(a3, 9);
+                col[1] = gmul(a0, 9) ^ gmul(a1, 14) ^ gmul(a2, 11) ^ gmul(a3, 13);
+                col[2] = gmul(a0, 13) ^ gmul(a1, 9) ^ gmul(a2, 14) ^ gmul(a3, 11);
+                col[3] = gmul(a0, 11) ^ gmul(a1, 13) ^ gmul(a2, 9) ^ gmul(a3, 14);
+            }
+        }
+
+        memcpy(s, t, AES_BLOCK_SIZE);
+    }
+
+    memcpy(out, s, AES_BLOCK_SIZE);
+}
+
+static size_t key_len_from_control(uint32_t pos)
+{
+    return 16 + ((CC3XX_MODEL_REG(aes.aes_control) >> pos) & 0x3U) * 8;
+}
+
+static void count_block(const struct aes_ctx_t *ctx)
+{
+    cc3xx_model.stats.aes_blocks++;
+    /* Each pair of extra rounds for the larger keys costs two cycles */
+    cc3xx_model_add_cycles(cc3xx_model.timing.aes_block + ctx->nr - 10);
+}
+
+static void xor_block(uint8_t *out, const uint8_t *a, const uint8_t *b,
+                      size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+static void ctr_increment(uint8_t *ctr, bool inc32)
+{
+    size_t stop = inc32 ? AES_BLOCK_SIZE - 4 : 0;
+    size_t i;
+
+    for (i = AES_BLOCK_SIZE; i > stop; i--) {
+        if (++ctr[i - 1] != 0) {
+            break;
+        }
+    }
+}
+
+/* Shifts a block left by one bit, and conditionally reduces, for the CMAC
+ * subkey derivation.
+ */
+static void cmac_dbl(uint8_t *out, const uint8_t *in)
+{
+    uint8_t carry = 0;
+    size_t i;
+
+    for (i = AES_BLOCK_SIZE; i > 0; i--) {
+        out[i - 1] = (uint8_t)((in[i - 1] << 1) | carry);
+        carry = in[i - 1] >> 7;
+    }
+
+    if (in[0] & 0x80) {
+        out[AES_BLOCK_SIZE - 1] ^= 0x87;
+    }
+}
+
+void cc3xx_model_aes_encrypt_block(const uint8_t *key, size_t key_len,
+                                   const uint8_t *in, uint8_t *out)
+{
+    struct aes_ctx_t ctx;
+
+    aes_expand_key(&ctx, key, key_len);
+    aes_encrypt(&ctx, in, out);
+    count_block(&ctx);
+}
+
+void cc3xx_model_aes_load_hw_key(bool is_key1)
+{
+    const uint32_t *src;
+    uint8_t *dst = is_key1 ? CC3XX_MODEL_REG_BYTES(aes.aes_key_1)
+                           : CC3XX_MODEL_REG_BYTES(aes.aes_key_0);
+    size_t key_len = key_len_from_control(is_key1 ? AES_CTRL_NK_KEY1_POS
+                                                  : AES_CTRL_NK_KEY0_POS);
+    size_t avail;
+
+    switch (CC3XX_MODEL_REG(host_rgf.host_cryptokey_sel)) {
+    case 0x0:
+        src = &CC3XX_MODEL_REG(otp.huk[0]);
+        avail = 32;
+        break;
+    case 0x1:
+        src = cc3xx_model.krtl;
+        avail = sizeof(cc3xx_model.krtl);
+        break;
+    case 0x2:
+        src = &CC3XX_MODEL_REG(otp.oem_provisioning_secret[0]);
+        avail = 16;
+        break;
+    case 0x3:
+        src = &CC3XX_MODEL_REG(otp.oem_code_encryption_key[0]);
+        avail = 16;
+        break;
+    case 0x4:
+        src = &CC3XX_MODEL_REG(otp.icv_provisioning_key[0]);
+        avail = 16;
+        break;
+    case 0x5:
+        src = &CC3XX_MODEL_REG(otp.icv_code_encryption_key[0]);
+        avail = 16;
+        break;
+    case 0xF:
+        src = cc3xx_model.guk;
+        avail = sizeof(cc3xx_model.guk);
+        break;
+    default:
+        return;
+    }
+
+    /* Keys shorter than the requested size are zero-extended */
+    memset(dst, 0, 32);
+    memcpy(dst, src, key_len < avail ? key_len : avail);
+}
+
+void cc3xx_model_aes_cmac_init(void)
+{
+    struct aes_ctx_t ctx;
+    uint8_t zero[AES_BLOCK_SIZE] = {0};
+    uint8_t l[AES_BLOCK_SIZE];
+
+    aes_expand_key(&ctx, CC3XX_MODEL_REG_BYTES(aes.aes_key_0),
+                   key_len_from_control(AES_CTRL_NK_KEY0_POS));
+    aes_encrypt(&ctx, zero, l);
+    count_block(&ctx);
+
+    cmac_dbl(cc3xx_model.cmac_k1, l);
+    cmac_dbl(cc3xx_model.cmac_k2, cc3xx_model.cmac_k1);
+
+    memset(CC3XX_MODEL_REG_BYTES(aes.aes_iv_0), 0, AES_BLOCK_SIZE);
+}
+
+void cc3xx_model_aes_cmac_size0_kick(void)
+{
+    struct aes_ctx_t ctx;
+    uint8_t block[AES_BLOCK_SIZE] = {0x80};
+
+    aes_expand_key(&ctx, CC3XX_MODEL_REG_BYTES(aes.aes_key_0),
+                   key_len_from_control(AES_CTRL_NK_KEY0_POS));
+    xor_block(block, block, cc3xx_model.cmac_k2, AES_BLOCK_SIZE);
+    aes_encrypt(&ctx, block, CC3XX_MODEL_REG_BYTES(aes.aes_iv_0));
+    count_block(&ctx);
+}
+
+static void process_tunnel(const struct aes_ctx_t *ctx0, const uint8_t *in,
+                           uint8_t *out, size_t len, bool inc32)
+{
+    uint32_t ctrl = CC3XX_MODEL_REG(aes.aes_control);
+    uint8_t *ctr = CC3XX_MODEL_REG_BYTES(aes.aes_ctr_0);
+    uint8_t *mac = CC3XX_MODEL_REG_BYTES(aes.aes_iv_1);
+    struct aes_ctx_t ctx1;
+    uint8_t ks[AES_BLOCK_SIZE];
+    uint8_t block[AES_BLOCK_SIZE];
+    size_t chunk;
+    size_t off;
+
+    aes_expand_key(&ctx1, CC3XX_MODEL_REG_BYTES(aes.aes_key_1),
+                   key_len_from_control(AES_CTRL_NK_KEY1_POS));
+
+    /* Tunnel 0 is CTR, and tunnel 1 CBC-MACs either the input (encryption) or
+     * the output of tunnel 0 (decryption), so the MAC is always over the
+     * plaintext.
+     */
+    for (off = 0; off < len; off += chunk) {
+        chunk = len - off < AES_BLOCK_SIZE ? len - off : AES_BLOCK_SIZE;
+
+        aes_encrypt(ctx0, ctr, ks);
+        count_block(ctx0);
+        ctr_increment(ctr, inc32);
+
+        memset(block, 0, sizeof(block));
+        memcpy(block, in + off, chunk);
+        xor_block(out + off, in + off, ks, chunk);
+        if (!(ctrl & AES_CTRL_B1_USES_PADDED_IN)) {
+            memcpy(block, out + off, chunk);
+        }
+
+        xor_block(mac, mac, block, AES_BLOCK_SIZE);
+        aes_encrypt(&ctx1, mac, mac);
+        count_block(&ctx1);
+    }
+}
+
+static void process_cmac(const struct aes_ctx_t *ctx, const uint8_t *in,
+                         size_t len)
+{
+    uint8_t *iv = CC3XX_MODEL_REG_BYTES(aes.aes_iv_0);
+    uint32_t remaining = CC3XX_MODEL_REG(aes.aes_remaining_bytes);
+    uint8_t block[AES_BLOCK_SIZE];
+    size_t chunk;
+    size_t off;
+
+    /* The last block of the message is only known when aes_remaining_bytes
+     * says so, which the driver sets before the final DMA.
+     */
+    for (off = 0; off < len; off += chunk) {
+        bool is_last = (off + AES_BLOCK_SIZE >= len) && remaining != 0
+                       && remaining <= AES_BLOCK_SIZE;
+
+        chunk = len - off < AES_BLOCK_SIZE ? len - off : AES_BLOCK_SIZE;
+
+        memset(block, 0, sizeof(block));
+        memcpy(block, in + off, chunk);
+
+        if (is_last) {
+            if (chunk == AES_BLOCK_SIZE) {
+                xor_block(block, block, cc3xx_model.cmac_k1, AES_BLOCK_SIZE);
+            } else {
+                block[chunk] = 0x80;
+                xor_block(block, block, cc3xx_model.cmac_k2, AES_BLOCK_SIZE);
+            }
+        }
+
+        xor_block(iv, iv, block, AES_BLOCK_SIZE);
+        aes_encrypt(ctx, iv, iv);
+        count_block(ctx);
+    }
+}
+
+void cc3xx_model_aes_process(const uint8_t *in, uint8_t *out, size_t len)
+{
+    uint32_t ctrl = CC3XX_MODEL_REG(aes.aes_control);
+    uint8_t *iv = CC3XX_MODEL_REG_BYTES(aes.aes_iv_0);
+    uint8_t *ctr = CC3XX_MODEL_REG_BYTES(aes.aes_ctr_0);
+    bool decrypt = (ctrl & AES_CTRL_DECRYPT) != 0;
+    bool inc32 = (ctrl & AES_CTRL_GCTR) != 0;
+    struct aes_ctx_t ctx;
+    uint8_t block[AES_BLOCK_SIZE];
+    uint8_t tmp[AES_BLOCK_SIZE];
+    size_t chunk;
+    size_t off;
+
+    aes_expand_key(&ctx, CC3XX_MODEL_REG_BYTES(aes.aes_key_0),
+                   key_len_from_control(AES_CTRL_NK_KEY0_POS));
+
+    if (ctrl & AES_CTRL_TUNNEL_IS_ON) {
+        process_tunnel(&ctx, in, out, len, inc32);
+        return;
+    }
+
+    if (((ctrl >> AES_CTRL_MODE_KEY0_POS) & 0x7U) == AES_MODE_CMAC) {
+        process_cmac(&ctx, in, len);
+        memcpy(out, in, len);
+        return;
+    }
+
+    for (off = 0; off < len; off += chunk) {
+        chunk = len - off < AES_BLOCK_SIZE ? len - off : AES_BLOCK_SIZE;
+
+        /* Partial blocks are zero-padded by the engine */
+        memset(block, 0, sizeof(block));
+        memcpy(block, in + off, chunk);
+
+        switch ((ctrl >> AES_CTRL_MODE_KEY0_POS) & 0x7U) {
+        case AES_MODE_ECB:
+            if (decrypt) {
+                aes_decrypt(&ctx, block, tmp);
+            } else {
+                aes_encrypt(&ctx, block, tmp);
+            }
+            break;
+        case AES_MODE_CBC:
+            if (decrypt) {
+                aes_decrypt(&ctx, block, tmp);
+                xor_block(tmp, tmp, iv, AES_BLOCK_SIZE);
+                memcpy(iv, block, AES_BLOCK_SIZE);
+            } else {
+                xor_block(block, block, iv, AES_BLOCK_SIZE);
+                aes_encrypt(&ctx, block, tmp);
+                memcpy(iv, tmp, AES_BLOCK_SIZE);
+            }
+            break;
+        case AES_MODE_CTR:
+            aes_encrypt(&ctx, ctr, tmp);
+            xor_block(tmp, tmp, block, AES_BLOCK_SIZE);
+            ctr_increment(ctr, inc32);
+            break;
+        case AES_MODE_CBC_MAC:
+            xor_block(iv, iv, block, AES_BLOCK_SIZE);
+            aes_encrypt(&ctx, iv, iv);
+            memcpy(tmp, block, AES_BLOCK_SIZE);
+            break;
+        default:
+            memcpy(tmp, block, AES_BLOCK_SIZE);
+            break;
+        }
+
+        count_block(&ctx);
+        memcpy(out + off, tmp, chunk);
+    }
+}
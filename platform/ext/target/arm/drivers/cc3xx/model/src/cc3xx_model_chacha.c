@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "cc3xx_model_private.h"
+
+#include <string.h>
+
+#define CHACHA_BLOCK_SIZE       64
+
+/* chacha_control_reg field selecting the 96-bit IV layout */
+#define CHACHA_CTRL_USE_IV_96   (1U << 10)
+
+static const uint32_t chacha_constants[4] = {
+    0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+};
+
+static inline uint32_t rotl(uint32_t x, uint32_t n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+#define QUARTER_ROUND(a, b, c, d)                   \
+    do {                                            \
+        a += b; d ^= a; d = rotl(d, 16);            \
+        c += d; b ^= c; b = rotl(b, 12);            \
+        a += b; d ^= a; d = rotl(d, 8);             \
+        c += d; b ^= c; b = rotl(b, 7);             \
+    } while (0)
+
+static void chacha_block(const uint32_t *in, uint8_t *out)
+{
+    uint32_t x[16];
+    size_t i;
+
+    memcpy(x, in, sizeof(x));
+
+    for (i = 0; i < 10; i++) {
+        QUARTER_ROUND(x[0], x[4], x[8],  x[12]);
+        QUARTER_ROUND(x[1], x[5], x[9],  x[13]);
+        QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+        QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+        QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+        QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+        QUARTER_ROUND(x[2], x[7], x[8],  x[13]);
+        QUARTER_ROUND(x[3], x[4], x[9],  x[14]);
+    }
+
+    for (i = 0; i < 16; i++) {
+        uint32_t v = x[i] + in[i];
+
+        out[i * 4 + 0] = (uint8_t)v;
+        out[i * 4 + 1] = (uint8_t)(v >> 8);
+        out[i * 4 + 2] = (uint8_t)(v >> 16);
+        out[i * 4 + 3] = (uint8_t)(v >> 24);
+    }
+}
+
+void cc3xx_model_chacha_process(const uint8_t *in, uint8_t *out, size_t len)
+{
+    uint32_t *cnt_lsb = &CC3XX_MODEL_REG(chacha.chacha_block_cnt_lsb);
+    uint32_t *cnt_msb = &CC3XX_MODEL_REG(chacha.chacha_block_cnt_msb);
+    bool iv_is_96_bit = CC3XX_MODEL_REG(chacha.chacha_control_reg)
+                        & CHACHA_CTRL_USE_IV_96;
+    uint32_t state[16];
+    uint8_t ks[CHACHA_BLOCK_SIZE];
+    size_t chunk;
+    size_t off;
+    size_t i;
+
+    memcpy(&state[0], chacha_constants, sizeof(chacha_constants));
+    memcpy(&state[4], &CC3XX_MODEL_REG(chacha.chacha_key[0]), 8 * sizeof(uint32_t));
+    state[14] = CC3XX_MODEL_REG(chacha.chacha_iv[0]);
+    state[15] = CC3XX_MODEL_REG(chacha.chacha_iv[1]);
+
+    /* A partial block still uses up a whole counter value */
+    for (off = 0; off < len; off += chunk) {
+        chunk = len - off < CHACHA_BLOCK_SIZE ? len - off : CHACHA_BLOCK_SIZE;
+
+        state[12] = *cnt_lsb;
+        state[13] = *cnt_msb;
+        chacha_block(state, ks);
+
+        for (i = 0; i < chunk; i++) {
+            out[off + i] = in[off + i] ^ ks[i];
+        }
+
+        /* With a 96-bit IV the MSB word is part of the nonce */
+        if (++(*cnt_lsb) == 0 && !iv_is_96_bit) {
+            (*cnt_msb)++;
+        }
+
+        cc3xx_model.stats.chacha_blocks++;
+        cc3xx_model_add_cycles(cc3xx_model.timing.chacha_block);
+    }
+}
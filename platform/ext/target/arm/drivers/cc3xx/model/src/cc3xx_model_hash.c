@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "cc3xx_model_private.h"
+
+#include <string.h>
+
+#define SHA_BLOCK_SIZE    64
+#define GHASH_BLOCK_SIZE  16
+
+/* hash_control values */
+#define HASH_ALG_SHA1     0x1U
+#define HASH_ALG_SHA224   0xAU
+#define HASH_ALG_SHA256   0x2U
+
+/* hash_sel_aes_mac value selecting the GHASH engine */
+#define HASH_SEL_GHASH    0x2U
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t rotr(uint32_t x, uint32_t n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+static inline uint32_t rotl(uint32_t x, uint32_t n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+static inline uint32_t load_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16)
+         | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void sha256_compress(uint32_t *h, const uint8_t *block)
+{
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, hh;
+    size_t i;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = load_be32(block + i * 4);
+    }
+    for (i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = h[0]; b = h[1]; c = h[2]; d = h[3];
+    e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+
+    for (i = 0; i < 64; i++) {
+        uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = hh + s1 + ch + sha256_k[i] + w[i];
+        uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+
+        hh = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+}
+
+static void sha1_compress(uint32_t *h, const uint8_t *block)
+{
+    uint32_t w[80];
+    uint32_t a, b, c, d, e;
+    size_t i;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = load_be32(block + i * 4);
+    }
+    for (i = 16; i < 80; i++) {
+        w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    a = h[0]; b = h[1]; c = h[2]; d = h[3]; e = h[4];
+
+    for (i = 0; i < 80; i++) {
+        uint32_t f, k, t;
+
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5a827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ed9eba1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8f1bbcdc;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xca62c1d6;
+        }
+
+        t = rotl(a, 5) + f + e + k + w[i];
+        e = d; d = c; c = rotl(b, 30); b = a; a = t;
+    }
+
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+}
+
+static void sha_compress(const uint8_t *block)
+{
+    uint32_t *h = &CC3XX_MODEL_REG(hash.hash_h[0]);
+
+    if ((CC3XX_MODEL_REG(hash.hash_control) & 0xFU) == HASH_ALG_SHA1) {
+        sha1_compress(h, block);
+    } else {
+        sha256_compress(h, block);
+    }
+
+    cc3xx_model.stats.hash_blocks++;
+    cc3xx_model_add_cycles(cc3xx_model.timing.hash_block);
+}
+
+static uint64_t get_cur_len(void)
+{
+    return (uint64_t)CC3XX_MODEL_REG(hash.hash_cur_len[1]) << 32
+           | CC3XX_MODEL_REG(hash.hash_cur_len[0]);
+}
+
+static void set_cur_len(uint64_t len)
+{
+    CC3XX_MODEL_REG(hash.hash_cur_len[0]) = (uint32_t)len;
+    CC3XX_MODEL_REG(hash.hash_cur_len[1]) = (uint32_t)(len >> 32);
+}
+
+/* Pads the final partial block (which may be empty), appending the message
+ * length in bits, and compresses it.
+ */
+static void sha_finalize(const uint8_t *rem, size_t rem_len, uint64_t total)
+{
+    uint8_t block[SHA_BLOCK_SIZE * 2] = {0};
+    size_t pad_len = rem_len < SHA_BLOCK_SIZE - 8 ? SHA_BLOCK_SIZE
+                                                  : SHA_BLOCK_SIZE * 2;
+    uint64_t bits = total * 8;
+    size_t i;
+
+    if (rem_len != 0) {
+        memcpy(block, rem, rem_len);
+    }
+    block[rem_len] = 0x80;
+    for (i = 0; i < 8; i++) {
+        block[pad_len - 1 - i] = (uint8_t)(bits >> (i * 8));
+    }
+
+    for (i = 0; i < pad_len; i += SHA_BLOCK_SIZE) {
+        sha_compress(block + i);
+    }
+}
+
+/* Multiplication in GF(2^128) with the GCM bit order */
+static void ghash_mul(uint8_t *x, const uint8_t *h)
+{
+    uint8_t z[GHASH_BLOCK_SIZE] = {0};
+    uint8_t v[GHASH_BLOCK_SIZE];
+    size_t i, j;
+
+    memcpy(v, h, GHASH_BLOCK_SIZE);
+
+    for (i = 0; i < 128; i++) {
+        uint8_t lsb;
+
+        if (x[i / 8] & (0x80 >> (i % 8))) {
+            for (j = 0; j < GHASH_BLOCK_SIZE; j++) {
+                z[j] ^= v[j];
+            }
+        }
+
+        lsb = v[GHASH_BLOCK_SIZE - 1] & 1;
+        for (j = GHASH_BLOCK_SIZE - 1; j > 0; j--) {
+            v[j] = (uint8_t)((v[j] >> 1) | (v[j - 1] << 7));
+        }
+        v[0] >>= 1;
+        if (lsb) {
+            v[0] ^= 0xE1;
+        }
+    }
+
+    memcpy(x, z, GHASH_BLOCK_SIZE);
+}
+
+static void ghash_process(const uint8_t *in, size_t len)
+{
+    uint8_t *x = CC3XX_MODEL_REG_BYTES(ghash.ghash_iv_0);
+    const uint8_t *h = CC3XX_MODEL_REG_BYTES(ghash.ghash_subkey_0);
+    size_t chunk;
+    size_t off;
+    size_t i;
+
+    /* Partial blocks are zero-padded */
+    for (off = 0; off < len; off += chunk) {
+        chunk = len - off < GHASH_BLOCK_SIZE ? len - off : GHASH_BLOCK_SIZE;
+
+        for (i = 0; i < chunk; i++) {
+            x[i] ^= in[off + i];
+        }
+        ghash_mul(x, h);
+
+        cc3xx_model.stats.ghash_blocks++;
+        cc3xx_model_add_cycles(cc3xx_model.timing.ghash_block);
+    }
+}
+
+void cc3xx_model_hash_process(const uint8_t *in, size_t len)
+{
+    uint64_t cur_len = get_cur_len();
+    size_t off;
+
+    if (CC3XX_MODEL_REG(hash.hash_sel_aes_mac) == HASH_SEL_GHASH) {
+        ghash_process(in, len);
+        return;
+    }
+
+    for (off = 0; off + SHA_BLOCK_SIZE <= len; off += SHA_BLOCK_SIZE) {
+        sha_compress(in + off);
+    }
+    cur_len += off;
+
+    /* A trailing partial block is only valid as the end of the message */
+    if (CC3XX_MODEL_REG(hash.auto_hw_padding) == 0x1U) {
+        sha_finalize(in + off, len - off, cur_len + (len - off));
+        cur_len += len - off;
+    }
+
+    set_cur_len(cur_len);
+}
+
+void cc3xx_model_hash_pad_empty(void)
+{
+    sha_finalize(NULL, 0, get_cur_len());
+}
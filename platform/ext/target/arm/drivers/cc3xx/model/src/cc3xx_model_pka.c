@@ -0,0 +1,660 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * The PKA is modelled functionally: every opcode computes its exact result
+ * with schoolbook arithmetic on 32-bit limbs, instead of the Montgomery and
+ * Barrett machinery of the hardware, so the Np register is never read.
+ * Operands and results are the full register width given by PKA_L[1], and
+ * results are written straight into the SRAM of the result register.
+ */
+
+#include "cc3xx_model_private.h"
+
+#include <string.h>
+
+#define PKA_SRAM_WORDS    (CC3XX_MODEL_PKA_SRAM_SIZE / sizeof(uint32_t))
+#define BN_MAX_WORDS      (CC3XX_MODEL_PKA_MAX_WORDS * 2 + 1)
+
+/* opcode fields */
+#define PKA_OPCODE_RES_POS        6
+#define PKA_OPCODE_DISCARD        (1U << 11)
+#define PKA_OPCODE_R1_POS         12
+#define PKA_OPCODE_R1_IS_IMM      (1U << 17)
+#define PKA_OPCODE_R0_POS         18
+#define PKA_OPCODE_R0_IS_IMM      (1U << 23)
+#define PKA_OPCODE_SIZE_POS       24
+#define PKA_OPCODE_OP_POS         27
+
+/* pka_status fields */
+#define PKA_STATUS_ALU_SIGN_OUT   (1U << 8)
+#define PKA_STATUS_ALU_OUT_ZERO   (1U << 12)
+
+/* The physical register which always holds the modulus */
+#define PKA_PHYS_REG_N            0
+
+enum pka_op_t {
+    PKA_OP_TERMINATE  = 0x00,
+    PKA_OP_ADD        = 0x04,
+    PKA_OP_SUB        = 0x05,
+    PKA_OP_MODADD     = 0x06,
+    PKA_OP_MODSUB     = 0x07,
+    PKA_OP_AND        = 0x08,
+    PKA_OP_OR         = 0x09,
+    PKA_OP_XOR        = 0x0A,
+    PKA_OP_SHR0       = 0x0C,
+    PKA_OP_SHR1       = 0x0D,
+    PKA_OP_SHL0       = 0x0E,
+    PKA_OP_SHL1       = 0x0F,
+    PKA_OP_MULLOW     = 0x10,
+    PKA_OP_MODMUL     = 0x11,
+    PKA_OP_MODEXP     = 0x13,
+    PKA_OP_DIV        = 0x14,
+    PKA_OP_MODINV     = 0x15,
+    PKA_OP_MULHIGH    = 0x17,
+    PKA_OP_REDUCTION  = 0x1B,
+};
+
+struct pka_operand_t {
+    uint32_t val[BN_MAX_WORDS];
+    bool is_imm;
+    int32_t imm;
+    uint32_t phys_reg;
+};
+
+static void read_reg(uint32_t phys_reg, uint32_t *out, size_t nw)
+{
+    uint32_t base = CC3XX_MODEL_REG(pka.memory_map[phys_reg & 0x1F]);
+    size_t i;
+
+    for (i = 0; i < nw; i++) {
+        out[i] = cc3xx_model.pka_sram[(base + i) % PKA_SRAM_WORDS];
+    }
+}
+
+static void write_reg(uint32_t phys_reg, const uint32_t *in, size_t nw)
+{
+    uint32_t base = CC3XX_MODEL_REG(pka.memory_map[phys_reg & 0x1F]);
+    size_t i;
+
+    for (i = 0; i < nw; i++) {
+        cc3xx_model.pka_sram[(base + i) % PKA_SRAM_WORDS] = in[i];
+    }
+}
+
+static bool bn_is_zero(const uint32_t *a, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        if (a[i] != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Number of significant words */
+static size_t bn_len(const uint32_t *a, size_t n)
+{
+    while (n > 0 && a[n - 1] == 0) {
+        n--;
+    }
+
+    return n;
+}
+
+static int bn_cmp(const uint32_t *a, const uint32_t *b, size_t n)
+{
+    size_t i;
+
+    for (i = n; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] > b[i - 1] ? 1 : -1;
+        }
+    }
+
+    return 0;
+}
+
+static uint32_t bn_add(uint32_t *r, const uint32_t *a, const uint32_t *b,
+                       size_t n)
+{
+    uint64_t carry = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        carry += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+
+    return (uint32_t)carry;
+}
+
+static uint32_t bn_sub(uint32_t *r, const uint32_t *a, const uint32_t *b,
+                       size_t n)
+{
+    uint64_t borrow = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        uint64_t t = (uint64_t)a[i] - b[i] - borrow;
+
+        r[i] = (uint32_t)t;
+        borrow = (t >> 32) & 1;
+    }
+
+    return (uint32_t)borrow;
+}
+
+/* r must have room for 2n words and not alias the inputs */
+static void bn_mul(uint32_t *r, const uint32_t *a, const uint32_t *b, size_t n)
+{
+    size_t i, j;
+
+    memset(r, 0, 2 * n * sizeof(uint32_t));
+
+    for (i = 0; i < n; i++) {
+        uint64_t carry = 0;
+
+        if (a[i] == 0) {
+            continue;
+        }
+
+        for (j = 0; j < n; j++) {
+            carry += (uint64_t)a[i] * b[j] + r[i + j];
+            r[i + j] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        r[i + n] = (uint32_t)carry;
+    }
+}
+
+/* Word idx of a, where words outside the register read as the fill value */
+static uint32_t bn_word(const uint32_t *a, size_t n, int64_t idx, bool fill_1)
+{
+    if (idx < 0 || idx >= (int64_t)n) {
+        return fill_1 ? 0xFFFFFFFFU : 0;
+    }
+
+    return a[idx];
+}
+
+static void bn_shr(uint32_t *r, const uint32_t *a, size_t n, uint32_t shift,
+                   bool fill_1)
+{
+    uint32_t tmp[BN_MAX_WORDS];
+    int64_t ws = shift / 32;
+    uint32_t bs = shift % 32;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        tmp[i] = bn_word(a, n, i + ws, fill_1) >> bs;
+        if (bs != 0) {
+            tmp[i] |= bn_word(a, n, i + ws + 1, fill_1) << (32 - bs);
+        }
+    }
+
+    memcpy(r, tmp, n * sizeof(uint32_t));
+}
+
+static void bn_shl(uint32_t *r, const uint32_t *a, size_t n, uint32_t shift,
+                   bool fill_1)
+{
+    uint32_t tmp[BN_MAX_WORDS];
+    int64_t ws = shift / 32;
+    uint32_t bs = shift % 32;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        tmp[i] = bn_word(a, n, (int64_t)i - ws, fill_1) << bs;
+        if (bs != 0) {
+            tmp[i] |= bn_word(a, n, (int64_t)i - ws - 1, fill_1) >> (32 - bs);
+        }
+    }
+
+    memcpy(r, tmp, n * sizeof(uint32_t));
+}
+
+/*
+ * Long division, Knuth's algorithm D (TAOCP vol. 2, 4.3.1). q gets m - n + 1
+ * words and r gets n words, where m and n are the word lengths of u and v. v
+ * must be non-zero.
+ */
+static void bn_divmod(uint32_t *q, uint32_t *r, const uint32_t *u, size_t m,
+                      const uint32_t *v, size_t n)
+{
+    uint32_t un[BN_MAX_WORDS * 2 + 1];
+    uint32_t vn[BN_MAX_WORDS];
+    uint32_t s;
+    size_t i;
+    size_t j;
+
+    m = bn_len(u, m);
+    n = bn_len(v, n);
+
+    if (m < n) {
+        if (q != NULL) {
+            q[0] = 0;
+        }
+        memcpy(r, u, m * sizeof(uint32_t));
+        memset(r + m, 0, (n - m) * sizeof(uint32_t));
+        return;
+    }
+
+    if (n == 1) {
+        uint64_t rem = 0;
+
+        for (j = m; j > 0; j--) {
+            uint64_t cur = (rem << 32) | u[j - 1];
+
+            if (q != NULL) {
+                q[j - 1] = (uint32_t)(cur / v[0]);
+            }
+            rem = cur % v[0];
+        }
+        r[0] = (uint32_t)rem;
+        return;
+    }
+
+    /* Normalise so the top bit of the divisor is set */
+    s = __builtin_clz(v[n - 1]);
+    for (i = n - 1; i > 0; i--) {
+        vn[i] = (v[i] << s) | (s ? v[i - 1] >> (32 - s) : 0);
+    }
+    vn[0] = v[0] << s;
+
+    un[m] = s ? u[m - 1] >> (32 - s) : 0;
+    for (i = m - 1; i > 0; i--) {
+        un[i] = (u[i] << s) | (s ? u[i - 1] >> (32 - s) : 0);
+    }
+    un[0] = u[0] << s;
+
+    for (j = m - n + 1; j > 0; j--) {
+        size_t jj = j - 1;
+        uint64_t num = ((uint64_t)un[jj + n] << 32) | un[jj + n - 1];
+        uint64_t qhat = num / vn[n - 1];
+        uint64_t rhat = num % vn[n - 1];
+        int64_t borrow = 0;
+        int64_t t;
+
+        while (qhat >> 32
+               || qhat * vn[n - 2] > ((rhat << 32) | un[jj + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat >> 32) {
+                break;
+            }
+        }
+
+        /* Multiply and subtract */
+        for (i = 0; i < n; i++) {
+            uint64_t p = qhat * vn[i];
+
+            t = (int64_t)un[i + jj] - borrow - (int64_t)(p & 0xFFFFFFFFU);
+            un[i + jj] = (uint32_t)t;
+            borrow = (int64_t)(p >> 32) - (t >> 32);
+        }
+        t = (int64_t)un[jj + n] - borrow;
+        un[jj + n] = (uint32_t)t;
+
+        /* The estimate was one too large, so add back */
+        if (t < 0) {
+            uint64_t carry = 0;
+
+            qhat--;
+            for (i = 0; i < n; i++) {
+                carry += (uint64_t)un[i + jj] + vn[i];
+                un[i + jj] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            un[jj + n] += (uint32_t)carry;
+        }
+
+        if (q != NULL) {
+            q[jj] = (uint32_t)qhat;
+        }
+    }
+
+    for (i = 0; i < n - 1; i++) {
+        r[i] = (un[i] >> s) | (s ? un[i + 1] << (32 - s) : 0);
+    }
+    r[n - 1] = un[n - 1] >> s;
+}
+
+/* r = a mod N, where a has an words and N and r have n words */
+static void bn_mod(uint32_t *r, const uint32_t *a, size_t an,
+                   const uint32_t *N, size_t n)
+{
+    uint32_t rem[BN_MAX_WORDS];
+    size_t nl = bn_len(N, n);
+
+    memset(r, 0, n * sizeof(uint32_t));
+    if (nl == 0) {
+        memcpy(r, a, (an < n ? an : n) * sizeof(uint32_t));
+        return;
+    }
+
+    bn_divmod(NULL, rem, a, an, N, nl);
+    memcpy(r, rem, nl * sizeof(uint32_t));
+}
+
+static void bn_modmul(uint32_t *r, const uint32_t *a, const uint32_t *b,
+                      const uint32_t *N, size_t n)
+{
+    uint32_t prod[BN_MAX_WORDS * 2];
+
+    bn_mul(prod, a, b, n);
+    bn_mod(r, prod, 2 * n, N, n);
+}
+
+/* Modular inverse by the binary extended Euclidean algorithm. Only odd moduli
+ * are handled, and a result of zero is given if there is no inverse.
+ */
+static void bn_modinv(uint32_t *r, const uint32_t *a, const uint32_t *N,
+                      size_t n)
+{
+    uint32_t u[BN_MAX_WORDS], v[BN_MAX_WORDS];
+    uint32_t x1[BN_MAX_WORDS], x2[BN_MAX_WORDS];
+    uint32_t one[BN_MAX_WORDS] = {1};
+    size_t w = n + 1;
+
+    memset(r, 0, n * sizeof(uint32_t));
+    if (!(N[0] & 1)) {
+        return;
+    }
+
+    memset(u, 0, sizeof(u));
+    memset(v, 0, sizeof(v));
+    bn_mod(u, a, n, N, n);
+    memcpy(v, N, n * sizeof(uint32_t));
+    memset(x1, 0, sizeof(x1));
+    memset(x2, 0, sizeof(x2));
+    x1[0] = 1;
+
+    while (!bn_is_zero(u, w) && !bn_is_zero(v, w)
+           && bn_cmp(u, one, w) != 0 && bn_cmp(v, one, w) != 0) {
+        while (!(u[0] & 1)) {
+            bn_shr(u, u, w, 1, false);
+            if (x1[0] & 1) {
+                bn_add(x1, x1, N, w);
+            }
+            bn_shr(x1, x1, w, 1, false);
+        }
+        while (!(v[0] & 1)) {
+            bn_shr(v, v, w, 1, false);
+            if (x2[0] & 1) {
+                bn_add(x2, x2, N, w);
+            }
+            bn_shr(x2, x2, w, 1, false);
+        }
+
+        if (bn_cmp(u, v, w) >= 0) {
+            bn_sub(u, u, v, w);
+            if (bn_sub(x1, x1, x2, w)) {
+                bn_add(x1, x1, N, w);
+            }
+        } else {
+            bn_sub(v, v, u, w);
+            if (bn_sub(x2, x2, x1, w)) {
+                bn_add(x2, x2, N, w);
+            }
+        }
+    }
+
+    if (bn_cmp(u, one, w) == 0) {
+        bn_mod(r, x1, w, N, n);
+    } else if (bn_cmp(v, one, w) == 0) {
+        bn_mod(r, x2, w, N, n);
+    }
+}
+
+static size_t bn_bit_len(const uint32_t *a, size_t n)
+{
+    n = bn_len(a, n);
+
+    return n == 0 ? 0 : (n - 1) * 32 + (32 - __builtin_clz(a[n - 1]));
+}
+
+static void bn_modexp(uint32_t *r, const uint32_t *base, const uint32_t *exp,
+                      const uint32_t *N, size_t n)
+{
+    uint32_t acc[BN_MAX_WORDS] = {1};
+    uint32_t b[BN_MAX_WORDS];
+    size_t bits = bn_bit_len(exp, n);
+    size_t i;
+
+    bn_mod(b, base, n, N, n);
+    if (bn_len(N, n) == 1 && N[0] == 1) {
+        acc[0] = 0;
+    }
+
+    for (i = bits; i > 0; i--) {
+        bn_modmul(acc, acc, acc, N, n);
+        if (exp[(i - 1) / 32] & (1U << ((i - 1) % 32))) {
+            bn_modmul(acc, acc, b, N, n);
+        }
+    }
+
+    memcpy(r, acc, n * sizeof(uint32_t));
+}
+
+static void decode_operand(struct pka_operand_t *op, uint32_t field,
+                           bool is_imm, bool sign_extend, size_t nw)
+{
+    size_t i;
+
+    memset(op->val, 0, sizeof(op->val));
+    op->is_imm = is_imm;
+    op->phys_reg = field;
+
+    if (!is_imm) {
+        op->imm = 0;
+        read_reg(field, op->val, nw);
+        return;
+    }
+
+    op->imm = sign_extend ? (int32_t)((field ^ 0x10U) - 0x10U) : (int32_t)field;
+    op->val[0] = (uint32_t)op->imm;
+    if (op->imm < 0) {
+        for (i = 1; i < nw; i++) {
+            op->val[i] = 0xFFFFFFFFU;
+        }
+    }
+}
+
+static bool is_signed_imm_op(uint32_t op)
+{
+    return op == PKA_OP_ADD || op == PKA_OP_SUB || op == PKA_OP_MODADD
+           || op == PKA_OP_MODSUB || op == PKA_OP_AND || op == PKA_OP_XOR;
+}
+
+/* r = (a + b) mod N, or (a - b) mod N, for a, b below 2^(32 * n) */
+static void mod_add_sub(uint32_t *r, const uint32_t *a, const uint32_t *b,
+                        bool sub, const uint32_t *N, size_t n)
+{
+    uint32_t tmp[BN_MAX_WORDS] = {0};
+    uint32_t red[BN_MAX_WORDS];
+
+    if (!sub) {
+        tmp[n] = bn_add(tmp, a, b, n);
+        bn_mod(r, tmp, n + 1, N, n);
+        return;
+    }
+
+    if (bn_cmp(a, b, n) >= 0) {
+        bn_sub(tmp, a, b, n);
+        bn_mod(r, tmp, n, N, n);
+    } else {
+        bn_sub(tmp, b, a, n);
+        bn_mod(red, tmp, n, N, n);
+        if (bn_is_zero(red, n)) {
+            memset(r, 0, n * sizeof(uint32_t));
+        } else {
+            bn_sub(r, N, red, n);
+        }
+    }
+}
+
+static uint64_t op_cost(uint32_t op, size_t nw, const uint32_t *N)
+{
+    const struct cc3xx_model_timing_t *t = &cc3xx_model.timing;
+    uint64_t digits = (nw + 1) / 2;
+    uint64_t mul = digits * digits * t->pka_mul_digit;
+
+    switch (op) {
+    case PKA_OP_MULLOW:
+    case PKA_OP_MULHIGH:
+    case PKA_OP_DIV:
+        return t->pka_op + mul;
+    case PKA_OP_MODMUL:
+    case PKA_OP_REDUCTION:
+        /* A multiplication and two for the Barrett reduction */
+        return t->pka_op + 3 * mul;
+    case PKA_OP_MODEXP:
+        return t->pka_op + bn_bit_len(N, nw) * 3 * mul;
+    case PKA_OP_MODINV:
+        return t->pka_op + bn_bit_len(N, nw) * 2 * digits * t->pka_digit;
+    default:
+        return t->pka_op + digits * t->pka_digit;
+    }
+}
+
+void cc3xx_model_pka_execute(uint32_t opcode)
+{
+    static struct pka_operand_t a, b;
+    uint32_t res[BN_MAX_WORDS * 2] = {0};
+    uint32_t N[BN_MAX_WORDS] = {0};
+    uint32_t op = (opcode >> PKA_OPCODE_OP_POS) & 0x1F;
+    uint32_t res_reg = (opcode >> PKA_OPCODE_RES_POS) & 0x1F;
+    bool discard = opcode & PKA_OPCODE_DISCARD;
+    size_t nw = CC3XX_MODEL_REG(pka.pka_l[1]) / 32;
+    bool sign;
+    size_t i;
+
+    if (op == PKA_OP_TERMINATE) {
+        return;
+    }
+
+    if (nw == 0 || nw > CC3XX_MODEL_PKA_MAX_WORDS) {
+        cc3xx_model_fatal("PKA register size not set up");
+    }
+
+    decode_operand(&a, (opcode >> PKA_OPCODE_R0_POS) & 0x1F,
+                   opcode & PKA_OPCODE_R0_IS_IMM, is_signed_imm_op(op), nw);
+    /* The shift amount has no immediate flag */
+    if (op >= PKA_OP_SHR0 && op <= PKA_OP_SHL1) {
+        decode_operand(&b, (opcode >> PKA_OPCODE_R1_POS) & 0x1F, true, false, nw);
+    } else {
+        decode_operand(&b, (opcode >> PKA_OPCODE_R1_POS) & 0x1F,
+                       opcode & PKA_OPCODE_R1_IS_IMM, is_signed_imm_op(op), nw);
+    }
+    read_reg(PKA_PHYS_REG_N, N, nw);
+
+    switch (op) {
+    case PKA_OP_ADD:
+        bn_add(res, a.val, b.val, nw);
+        break;
+    case PKA_OP_SUB:
+        bn_sub(res, a.val, b.val, nw);
+        break;
+    case PKA_OP_MODADD:
+    case PKA_OP_MODSUB:
+    {
+        bool is_sub = (op == PKA_OP_MODSUB);
+        uint32_t mag[BN_MAX_WORDS] = {0};
+        const uint32_t *bv = b.val;
+
+        /* A negative immediate turns an addition into a subtraction */
+        if (b.is_imm && b.imm < 0) {
+            mag[0] = (uint32_t)(-b.imm);
+            bv = mag;
+            is_sub = !is_sub;
+        }
+        mod_add_sub(res, a.val, bv, is_sub, N, nw);
+        break;
+    }
+    case PKA_OP_AND:
+        for (i = 0; i < nw; i++) {
+            res[i] = a.val[i] & b.val[i];
+        }
+        break;
+    case PKA_OP_OR:
+        for (i = 0; i < nw; i++) {
+            res[i] = a.val[i] | b.val[i];
+        }
+        break;
+    case PKA_OP_XOR:
+        for (i = 0; i < nw; i++) {
+            res[i] = a.val[i] ^ b.val[i];
+        }
+        break;
+    case PKA_OP_SHR0:
+    case PKA_OP_SHR1:
+        bn_shr(res, a.val, nw, b.imm + 1, op == PKA_OP_SHR1);
+        break;
+    case PKA_OP_SHL0:
+    case PKA_OP_SHL1:
+        bn_shl(res, a.val, nw, b.imm + 1, op == PKA_OP_SHL1);
+        break;
+    case PKA_OP_MULLOW:
+        bn_mul(res, a.val, b.val, nw);
+        break;
+    case PKA_OP_MULHIGH:
+        bn_mul(res, a.val, b.val, nw);
+        memmove(res, res + nw, nw * sizeof(uint32_t));
+        break;
+    case PKA_OP_MODMUL:
+        bn_modmul(res, a.val, b.val, N, nw);
+        break;
+    case PKA_OP_MODEXP:
+        bn_modexp(res, a.val, b.val, N, nw);
+        break;
+    case PKA_OP_DIV:
+    {
+        uint32_t rem[BN_MAX_WORDS] = {0};
+
+        if (bn_is_zero(b.val, nw)) {
+            cc3xx_model_fatal("PKA division by zero");
+        }
+        bn_divmod(res, rem, a.val, nw, b.val, nw);
+        /* The remainder replaces the dividend */
+        if (!a.is_imm) {
+            write_reg(a.phys_reg, rem, nw);
+        }
+        break;
+    }
+    case PKA_OP_MODINV:
+        bn_modinv(res, b.val, N, nw);
+        break;
+    case PKA_OP_REDUCTION:
+        bn_mod(res, a.val, nw, N, nw);
+        break;
+    default:
+        cc3xx_model_fatal("unsupported PKA opcode");
+    }
+
+    /* Subtraction reports a borrow, which is what comparisons rely on */
+    if (op == PKA_OP_SUB) {
+        sign = bn_cmp(a.val, b.val, nw) < 0;
+    } else {
+        sign = (res[nw - 1] >> 31) & 1;
+    }
+
+    CC3XX_MODEL_REG(pka.pka_status) =
+        (sign ? PKA_STATUS_ALU_SIGN_OUT : 0)
+        | (bn_is_zero(res, nw) ? PKA_STATUS_ALU_OUT_ZERO : 0);
+
+    if (!discard) {
+        write_reg(res_reg, res, nw);
+    }
+
+    cc3xx_model.stats.pka_ops++;
+    cc3xx_model_add_cycles(op_cost(op, nw, N));
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024, The TrustedFirmware-M Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef CC3XX_MODEL_PRIVATE_H
+#define CC3XX_MODEL_PRIVATE_H
+
+#include "cc3xx_model.h"
+#include "cc3xx_reg_defs.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The register space, rounded up to whole host pages */
+#define CC3XX_MODEL_REG_SPACE_SIZE 0x3000
+
+#define CC3XX_MODEL_PKA_SRAM_SIZE 0x1800
+
+/* Largest PKA register, 2048 bits plus overflow, in 32-bit words. Products are
+ * held in twice this.
+ */
+#define CC3XX_MODEL_PKA_MAX_WORDS 72
+
+/* Word index of a register in the register space */
+#define CC3XX_MODEL_IDX(member) \
+    (offsetof(struct _cc3xx_reg_map_t, member) / sizeof(uint32_t))
+
+/* Access to the canonical value of a register */
+#define CC3XX_MODEL_REG(member) (cc3xx_model.regs[CC3XX_MODEL_IDX(member)])
+
+/* Byte view of a run of registers, used where the hardware treats them as a
+ * byte string (IVs, counters, GHASH state). The host is little-endian like the
+ * CC3XX bus, so no swapping is needed.
+ */
+#define CC3XX_MODEL_REG_BYTES(member) \
+    ((uint8_t *)&cc3xx_model.regs[CC3XX_MODEL_IDX(member)])
+
+struct cc3xx_model_t {
+    uint32_t regs[CC3XX_MODEL_REG_SPACE_SIZE / sizeof(uint32_t)];
+    uint32_t pka_sram[CC3XX_MODEL_PKA_SRAM_SIZE / sizeof(uint32_t)];
+    uint32_t pka_sram_waddr;
+    uint32_t pka_sram_raddr;
+    uint8_t cmac_k1[16];
+    uint8_t cmac_k2[16];
+    uint32_t krtl[4];
+    uint32_t guk[8];
+    bool dout_armed;
+    uint64_t rng_state;
+    struct cc3xx_model_stats_t stats;
+    struct cc3xx_model_timing_t timing;
+};
+
+extern struct cc3xx_model_t cc3xx_model;
+
+/* AES */
+void cc3xx_model_aes_load_hw_key(bool is_key1);
+void cc3xx_model_aes_cmac_init(void);
+void cc3xx_model_aes_cmac_size0_kick(void);
+void cc3xx_model_aes_process(const uint8_t *in, uint8_t *out, size_t len);
+void cc3xx_model_aes_encrypt_block(const uint8_t *key, size_t key_len,
+                                   const uint8_t *in, uint8_t *out);
+
+/* Hash and GHASH */
+void cc3xx_model_hash_process(const uint8_t *in, size_t len);
+void cc3xx_model_hash_pad_empty(void);
+
+/* ChaCha */
+void cc3xx_model_chacha_process(const uint8_t *in, uint8_t *out, size_t len);
+
+/* PKA */
+void cc3xx_model_pka_execute(uint32_t opcode);
+
+/* Reports a use of the hardware the model can't handle, and aborts. This is
+ * safe to call from the trap handlers.
+ */
+void cc3xx_model_fatal(const char *msg);
+
+/* Charges cycles to the modelled cycle counter */
+static inline void cc3xx_model_add_cycles(uint64_t cycles)
+{
+    cc3xx_model.stats.cycles += cycles;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC3XX_MODEL_PRIVATE_H */
@@ -466,7 +466,7 @@ psa_status_t cc3xx_internal_cipher_setup_complete(
 #endif /* PSA_WANT_KEY_TYPE_CHACHA20 */
 #if defined(PSA_WANT_KEY_TYPE_AES)
         case PSA_KEY_TYPE_AES:
-            cc3xx_lowlevel_aes_set_state(&(operation->aes));
+            cc3xx_lowlevel_aes_load_state(&(operation->aes));
             break;
 #endif /* PSA_WANT_KEY_TYPE_AES */
         default:
@@ -380,9 +380,7 @@ psa_status_t cc3xx_aead_update_ad(
 
         cc3xx_lowlevel_aes_update_authed_data(input, input_size);
 
-        cc3xx_lowlevel_aes_get_state(&operation->aes);
-
-        cc3xx_lowlevel_aes_uninit();
+        cc3xx_lowlevel_aes_put_state(&operation->aes);
         return PSA_SUCCESS;
 #endif /* PSA_WANT_KEY_TYPE_AES */
 
@@ -510,9 +508,9 @@ out_chacha20:
 
         operation->last_output_num_bytes = current_output_size;
 
-        cc3xx_lowlevel_aes_get_state(&operation->aes);
+        cc3xx_lowlevel_aes_put_state(&operation->aes);
+        return PSA_SUCCESS;
 
-        status = PSA_SUCCESS;
 out_aes:
         cc3xx_lowlevel_aes_uninit();
         return status;
@@ -611,7 +609,7 @@ out_chacha20:
 #if defined(PSA_WANT_KEY_TYPE_AES)
     case PSA_KEY_TYPE_AES:
 
-        cc3xx_lowlevel_aes_set_state(&(operation->aes));
+        cc3xx_lowlevel_aes_load_state(&(operation->aes));
 
         cc3xx_lowlevel_aes_set_output_buffer(ciphertext, ciphertext_size);
 
@@ -743,7 +741,7 @@ out_chacha20:
 #if defined(PSA_WANT_KEY_TYPE_AES)
     case PSA_KEY_TYPE_AES:
 
-        cc3xx_lowlevel_aes_set_state(&(operation->aes));
+        cc3xx_lowlevel_aes_load_state(&(operation->aes));
 
         cc3xx_lowlevel_aes_set_output_buffer(plaintext, plaintext_size);
 
@@ -776,6 +774,8 @@ out_aes:
 
 psa_status_t cc3xx_aead_abort(cc3xx_aead_operation_t *operation)
 {
+    cc3xx_lowlevel_aes_discard_state(&operation->aes);
+
     cc3xx_secure_erase_buffer((uint32_t *)operation, sizeof(cc3xx_aead_operation_t) / sizeof(uint32_t));
     return PSA_SUCCESS;
 }
@@ -83,6 +83,9 @@ psa_status_t cc3xx_hash_clone(const cc3xx_hash_operation_t *source_operation,
 
     memcpy(target_operation, source_operation, sizeof(cc3xx_hash_operation_t));
 
+    /* The source may still be loaded in the engine, ahead of its context */
+    cc3xx_lowlevel_hash_copy_state(&target_operation->ctx, &source_operation->ctx);
+
     return PSA_SUCCESS;
 }
 
@@ -103,7 +106,7 @@ psa_status_t cc3xx_hash_update(cc3xx_hash_operation_t *operation,
     /* if len not zero, but pointer is NULL */
     CC3XX_ASSERT(input != NULL);
 
-    cc3xx_lowlevel_hash_set_state(&operation->ctx);
+    cc3xx_lowlevel_hash_load_state(&operation->ctx);
 
     err = cc3xx_lowlevel_hash_update(input, input_length);
 
@@ -111,9 +114,7 @@ psa_status_t cc3xx_hash_update(cc3xx_hash_operation_t *operation,
         return cc3xx_to_psa_err(err);
     }
 
-    cc3xx_lowlevel_hash_get_state(&operation->ctx);
-
-    cc3xx_lowlevel_hash_uninit();
+    cc3xx_lowlevel_hash_put_state(&operation->ctx);
 
     return PSA_SUCCESS;
 }
@@ -125,7 +126,7 @@ psa_status_t cc3xx_hash_finish(cc3xx_hash_operation_t *operation,
     CC3XX_ASSERT(operation != NULL);
     CC3XX_ASSERT(hash_length != NULL);
 
-    cc3xx_lowlevel_hash_set_state(&operation->ctx);
+    cc3xx_lowlevel_hash_load_state(&operation->ctx);
 
     switch (operation->ctx.alg) {
     case CC3XX_HASH_ALG_SHA1:
@@ -149,6 +150,8 @@ psa_status_t cc3xx_hash_finish(cc3xx_hash_operation_t *operation,
 
 psa_status_t cc3xx_hash_abort(cc3xx_hash_operation_t *operation)
 {
+    cc3xx_lowlevel_hash_discard_state(&operation->ctx);
+
     cc3xx_secure_erase_buffer((uint32_t *)operation, sizeof(cc3xx_hash_operation_t) / sizeof(uint32_t));
     return PSA_SUCCESS;
 }
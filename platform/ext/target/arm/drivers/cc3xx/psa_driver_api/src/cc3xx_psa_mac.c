@@ -130,13 +130,11 @@ static psa_status_t cmac_update(struct cc3xx_aes_state_t *state,
         return PSA_SUCCESS;
     }
 
-    cc3xx_lowlevel_aes_set_state(state);
+    cc3xx_lowlevel_aes_load_state(state);
 
     cc3xx_lowlevel_aes_update_authed_data(input, ilen);
 
-    cc3xx_lowlevel_aes_get_state(state);
-
-    cc3xx_lowlevel_aes_uninit();
+    cc3xx_lowlevel_aes_put_state(state);
     return PSA_SUCCESS;
 }
 
@@ -148,7 +146,7 @@ static psa_status_t cmac_finish(struct cc3xx_aes_state_t *state,
 {
     cc3xx_err_t err;
 
-    cc3xx_lowlevel_aes_set_state(state);
+    cc3xx_lowlevel_aes_load_state(state);
 
     err = cc3xx_lowlevel_aes_finish(output, NULL);
     if (err != CC3XX_ERR_SUCCESS) {
@@ -437,6 +435,8 @@ out:
 
 psa_status_t cc3xx_mac_abort(cc3xx_mac_operation_t *operation)
 {
+    cc3xx_lowlevel_aes_discard_state(&operation->cmac);
+
     cc3xx_secure_erase_buffer((uint32_t *)operation, sizeof(cc3xx_mac_operation_t) / sizeof(uint32_t));
     return PSA_SUCCESS;
 }
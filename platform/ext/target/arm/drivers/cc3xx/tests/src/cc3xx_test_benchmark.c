@@ -0,0 +1,762 @@
+/*
+ * Copyright (c) 2025, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "cc3xx_test_benchmark.h"
+#ifndef CC3XX_CONFIG_FILE
+#include "cc3xx_config.h"
+#else
+#include CC3XX_CONFIG_FILE
+#endif
+#include "cc3xx_test_assert.h"
+#include "cc3xx_test_utils.h"
+
+#include "cc3xx_hash.h"
+#include "cc3xx_aes.h"
+#include "cc3xx_chacha.h"
+#include "cc3xx_ec.h"
+#include "cc3xx_ecdsa.h"
+#include "cc3xx_ecdh.h"
+#include "cc3xx_rng.h"
+
+#ifdef TEST_CC3XX_BENCHMARK_PSA
+#include "psa/crypto.h"
+#endif /* TEST_CC3XX_BENCHMARK_PSA */
+
+#ifdef TEST_CC3XX_BENCHMARK_MBEDTLS
+#include "cc3xx_test_benchmark_mbedtls.h"
+#endif /* TEST_CC3XX_BENCHMARK_MBEDTLS */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * The benchmarks don't check results, the functional tests do that. Each
+ * measurement is logged as a single line of comma separated values:
+ *
+ *   CC3XX_BENCH,<path>,<algorithm>,<bytes>,<cycles>
+ *
+ * so that the results can be grepped out of a test log and compared between
+ * driver revisions. <bytes> is the message size for the bulk algorithms, and 0
+ * for the public key ones. <cycles> covers the whole operation from init to
+ * finish, so the smallest message size gives the per-operation latency and the
+ * largest the streaming throughput. On the host model the cycle counter
+ * reports the modelled hardware time.
+ *
+ * <path> is "lowlevel" for calls straight into the low-level driver. Where the
+ * tests are built into a secure partition which can call the PSA Crypto API,
+ * TEST_CC3XX_BENCHMARK_PSA adds the same operations with <path> "psa". Those
+ * go through the crypto service, the Mbed TLS PSA core and the CC3XX PSA
+ * driver, so the difference between the two paths is the cost of those
+ * layers, which aren't measured separately.
+ *
+ * TEST_CC3XX_BENCHMARK_MBEDTLS adds the symmetric operations with <path>
+ * "mbedtls", run through the software implementations of Mbed TLS, as the
+ * baseline the accelerator is compared against.
+ */
+#define BENCH_PATH_LOWLEVEL "lowlevel"
+#define BENCH_PATH_PSA      "psa"
+#define BENCH_PATH_MBEDTLS  "mbedtls"
+
+/* The input and output buffers are static and sized for the largest message,
+ * so keep the default small enough for on-target builds. Platforms with the
+ * memory to spare, like the host model, measure up to 64KiB.
+ */
+#ifndef CC3XX_TEST_BENCHMARK_MAX_MSG_SIZE
+#define CC3XX_TEST_BENCHMARK_MAX_MSG_SIZE 4096
+#endif /* CC3XX_TEST_BENCHMARK_MAX_MSG_SIZE */
+
+/* Unless the framework maps IOVecs, the crypto service copies the input into a
+ * buffer of CRYPTO_IOVEC_BUFFER_SIZE, so larger messages can't be sent to it.
+ */
+#ifndef CC3XX_TEST_BENCHMARK_PSA_MAX_MSG_SIZE
+#define CC3XX_TEST_BENCHMARK_PSA_MAX_MSG_SIZE 1024
+#endif /* CC3XX_TEST_BENCHMARK_PSA_MAX_MSG_SIZE */
+
+static const size_t bench_msg_sizes[] = {
+    16, 64, 256, 1024, 4096, 16 * 1024, 64 * 1024,
+};
+
+static uint32_t bench_in[CC3XX_TEST_BENCHMARK_MAX_MSG_SIZE / sizeof(uint32_t)];
+static uint32_t bench_out[CC3XX_TEST_BENCHMARK_MAX_MSG_SIZE / sizeof(uint32_t)];
+
+static const uint32_t bench_key[8] = {
+    0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+    0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c,
+};
+
+static const uint32_t bench_iv[4] = {
+    0xcafebabe, 0xfacedbad, 0xdecaf888, 0x00000001,
+};
+
+static void bench_report(const char *path, const char *alg, size_t bytes,
+                         uint32_t cycles)
+{
+    TEST_LOG("CC3XX_BENCH,%s,%s,%u,%u\r\n", path, alg,
+             (unsigned int)bytes, (unsigned int)cycles);
+}
+
+static void bench_fill_input(void)
+{
+    for (size_t idx = 0; idx < ARRAY_SIZE(bench_in); idx++) {
+        bench_in[idx] = idx * 0x9E3779B9U;
+    }
+}
+
+#ifdef CC3XX_CONFIG_HASH_SHA256_ENABLE
+static int bench_hash(void)
+{
+    uint32_t digest[SHA256_OUTPUT_SIZE / sizeof(uint32_t)];
+    uint32_t cyccnt_start;
+    cc3xx_err_t err;
+    int rc;
+
+    for (size_t idx = 0; idx < ARRAY_SIZE(bench_msg_sizes); idx++) {
+        if (bench_msg_sizes[idx] > sizeof(bench_in)) {
+            break;
+        }
+
+        cyccnt_start = get_cycle_count();
+        err = cc3xx_lowlevel_hash_init(CC3XX_HASH_ALG_SHA256);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+        err = cc3xx_lowlevel_hash_update((uint8_t *)bench_in, bench_msg_sizes[idx]);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+        cc3xx_lowlevel_hash_finish(digest, sizeof(digest));
+        bench_report(BENCH_PATH_LOWLEVEL, "sha256", bench_msg_sizes[idx],
+                     get_cycle_count() - cyccnt_start);
+    }
+
+    rc = 0;
+cleanup:
+    cc3xx_lowlevel_hash_uninit();
+
+    return rc;
+}
+#endif /* CC3XX_CONFIG_HASH_SHA256_ENABLE */
+
+static const struct {
+    cc3xx_aes_mode_t mode;
+    const char *name;
+    size_t iv_len;
+    bool mac_only;
+} bench_aes_modes[] = {
+#ifdef CC3XX_CONFIG_AES_ECB_ENABLE
+    {CC3XX_AES_MODE_ECB, "aes128-ecb", 0, false},
+#endif /* CC3XX_CONFIG_AES_ECB_ENABLE */
+#ifdef CC3XX_CONFIG_AES_CBC_ENABLE
+    {CC3XX_AES_MODE_CBC, "aes128-cbc", 16, false},
+#endif /* CC3XX_CONFIG_AES_CBC_ENABLE */
+#ifdef CC3XX_CONFIG_AES_CTR_ENABLE
+    {CC3XX_AES_MODE_CTR, "aes128-ctr", 16, false},
+#endif /* CC3XX_CONFIG_AES_CTR_ENABLE */
+#ifdef CC3XX_CONFIG_AES_GCM_ENABLE
+    {CC3XX_AES_MODE_GCM, "aes128-gcm", 12, false},
+#endif /* CC3XX_CONFIG_AES_GCM_ENABLE */
+#ifdef CC3XX_CONFIG_AES_CCM_ENABLE
+    /* A 12 byte nonce leaves 3 bytes of length, enough for 64KiB messages */
+    {CC3XX_AES_MODE_CCM, "aes128-ccm", 12, false},
+#endif /* CC3XX_CONFIG_AES_CCM_ENABLE */
+#ifdef CC3XX_CONFIG_AES_CMAC_ENABLE
+    /* CMAC only takes input as authenticated data */
+    {CC3XX_AES_MODE_CMAC, "aes128-cmac", 0, true},
+#endif /* CC3XX_CONFIG_AES_CMAC_ENABLE */
+};
+
+static int bench_aes(void)
+{
+    uint32_t tag[AES_TAG_MAX_LEN / sizeof(uint32_t)];
+    uint32_t cyccnt_start;
+    cc3xx_err_t err;
+    int rc;
+
+    for (size_t mode = 0; mode < ARRAY_SIZE(bench_aes_modes); mode++) {
+        for (size_t idx = 0; idx < ARRAY_SIZE(bench_msg_sizes); idx++) {
+            if (bench_msg_sizes[idx] > sizeof(bench_in)) {
+                break;
+            }
+
+            cyccnt_start = get_cycle_count();
+            err = cc3xx_lowlevel_aes_init(CC3XX_AES_DIRECTION_ENCRYPT,
+                                          bench_aes_modes[mode].mode,
+                                          CC3XX_AES_KEY_ID_USER_KEY,
+                                          bench_key, CC3XX_AES_KEYSIZE_128,
+                                          bench_aes_modes[mode].iv_len != 0 ? bench_iv : NULL,
+                                          bench_aes_modes[mode].iv_len);
+            cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+            cc3xx_lowlevel_aes_set_output_buffer((uint8_t *)bench_out, sizeof(bench_out));
+            cc3xx_lowlevel_aes_set_tag_len(16);
+
+            if (bench_aes_modes[mode].mac_only) {
+                cc3xx_lowlevel_aes_set_data_len(0, bench_msg_sizes[idx]);
+                cc3xx_lowlevel_aes_update_authed_data((uint8_t *)bench_in,
+                                                      bench_msg_sizes[idx]);
+            } else {
+                cc3xx_lowlevel_aes_set_data_len(bench_msg_sizes[idx], 0);
+                err = cc3xx_lowlevel_aes_update((uint8_t *)bench_in, bench_msg_sizes[idx]);
+                cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+            }
+
+            err = cc3xx_lowlevel_aes_finish(tag, NULL);
+            cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+            bench_report(BENCH_PATH_LOWLEVEL, bench_aes_modes[mode].name,
+                         bench_msg_sizes[idx], get_cycle_count() - cyccnt_start);
+        }
+    }
+
+    rc = 0;
+cleanup:
+    cc3xx_lowlevel_aes_uninit();
+
+    return rc;
+}
+
+#if defined(CC3XX_CONFIG_CHACHA_ENABLE) && defined(CC3XX_CONFIG_CHACHA_POLY1305_ENABLE)
+static int bench_chacha20_poly1305(void)
+{
+    uint32_t tag[16 / sizeof(uint32_t)];
+    uint32_t cyccnt_start;
+    cc3xx_err_t err;
+    int rc;
+
+    for (size_t idx = 0; idx < ARRAY_SIZE(bench_msg_sizes); idx++) {
+        if (bench_msg_sizes[idx] > sizeof(bench_in)) {
+            break;
+        }
+
+        cyccnt_start = get_cycle_count();
+        err = cc3xx_lowlevel_chacha20_init(CC3XX_CHACHA_DIRECTION_ENCRYPT,
+                                           CC3XX_CHACHA_MODE_CHACHA_POLY1305,
+                                           bench_key, 0, bench_iv, 12);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+        cc3xx_lowlevel_chacha20_set_output_buffer((uint8_t *)bench_out, sizeof(bench_out));
+
+        err = cc3xx_lowlevel_chacha20_update((uint8_t *)bench_in, bench_msg_sizes[idx]);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+        err = cc3xx_lowlevel_chacha20_finish(tag, NULL);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+        bench_report(BENCH_PATH_LOWLEVEL, "chacha20-poly1305",
+                     bench_msg_sizes[idx], get_cycle_count() - cyccnt_start);
+    }
+
+    rc = 0;
+cleanup:
+    cc3xx_lowlevel_chacha20_uninit();
+
+    return rc;
+}
+#endif /* CC3XX_CONFIG_CHACHA_ENABLE && CC3XX_CONFIG_CHACHA_POLY1305_ENABLE */
+
+static const struct {
+    cc3xx_ec_curve_id_t curve_id;
+    const char *name;
+} bench_curves[] = {
+#ifdef CC3XX_CONFIG_EC_CURVE_SECP_256_R1_ENABLE
+    {CC3XX_EC_CURVE_SECP_256_R1, "p256"},
+#endif /* CC3XX_CONFIG_EC_CURVE_SECP_256_R1_ENABLE */
+#ifdef CC3XX_CONFIG_EC_CURVE_SECP_384_R1_ENABLE
+    {CC3XX_EC_CURVE_SECP_384_R1, "p384"},
+#endif /* CC3XX_CONFIG_EC_CURVE_SECP_384_R1_ENABLE */
+};
+
+#if defined(CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE) && \
+    defined(CC3XX_CONFIG_ECDSA_SIGN_ENABLE) && \
+    defined(CC3XX_CONFIG_ECDSA_VERIFY_ENABLE)
+static int bench_ecdsa(void)
+{
+    uint32_t private_key[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t public_key_x[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t public_key_y[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t sig_r[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t sig_s[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    size_t private_key_size, public_key_x_size, public_key_y_size;
+    size_t sig_r_size, sig_s_size;
+    char name[32];
+    uint32_t cyccnt_start;
+    cc3xx_err_t err;
+    int rc;
+
+    for (size_t curve = 0; curve < ARRAY_SIZE(bench_curves); curve++) {
+        err = cc3xx_lowlevel_ecdsa_genkey(bench_curves[curve].curve_id,
+                                          private_key, sizeof(private_key),
+                                          &private_key_size);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+        err = cc3xx_lowlevel_ecdsa_getpub(bench_curves[curve].curve_id,
+                                          private_key, private_key_size,
+                                          public_key_x, sizeof(public_key_x),
+                                          &public_key_x_size,
+                                          public_key_y, sizeof(public_key_y),
+                                          &public_key_y_size);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+        /* The input message is as good a hash as any for timing purposes */
+        cyccnt_start = get_cycle_count();
+        err = cc3xx_lowlevel_ecdsa_sign(bench_curves[curve].curve_id,
+                                        private_key, private_key_size,
+                                        bench_in, SHA256_OUTPUT_SIZE,
+                                        sig_r, sizeof(sig_r), &sig_r_size,
+                                        sig_s, sizeof(sig_s), &sig_s_size);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+        snprintf(name, sizeof(name), "ecdsa-%s-sign", bench_curves[curve].name);
+        bench_report(BENCH_PATH_LOWLEVEL, name, 0, get_cycle_count() - cyccnt_start);
+
+        cyccnt_start = get_cycle_count();
+        err = cc3xx_lowlevel_ecdsa_verify(bench_curves[curve].curve_id,
+                                          public_key_x, public_key_x_size,
+                                          public_key_y, public_key_y_size,
+                                          bench_in, SHA256_OUTPUT_SIZE,
+                                          sig_r, sig_r_size,
+                                          sig_s, sig_s_size);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+        snprintf(name, sizeof(name), "ecdsa-%s-verify", bench_curves[curve].name);
+        bench_report(BENCH_PATH_LOWLEVEL, name, 0, get_cycle_count() - cyccnt_start);
+    }
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+#endif /* CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE && CC3XX_CONFIG_ECDSA_SIGN_ENABLE && CC3XX_CONFIG_ECDSA_VERIFY_ENABLE */
+
+#if defined(CC3XX_CONFIG_ECDH_ENABLE) && defined(CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE)
+static int bench_ecdh(void)
+{
+    uint32_t private_key[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t peer_private_key[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t peer_public_key_x[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t peer_public_key_y[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    uint32_t shared_secret[CC3XX_EC_MAX_POINT_SIZE / sizeof(uint32_t)];
+    size_t private_key_size, peer_private_key_size;
+    size_t peer_public_key_x_size, peer_public_key_y_size;
+    size_t shared_secret_size;
+    char name[32];
+    uint32_t cyccnt_start;
+    cc3xx_err_t err;
+    int rc;
+
+    for (size_t curve = 0; curve < ARRAY_SIZE(bench_curves); curve++) {
+        err = cc3xx_lowlevel_ecdsa_genkey(bench_curves[curve].curve_id,
+                                          private_key, sizeof(private_key),
+                                          &private_key_size);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+        err = cc3xx_lowlevel_ecdsa_genkey(bench_curves[curve].curve_id,
+                                          peer_private_key, sizeof(peer_private_key),
+                                          &peer_private_key_size);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+        err = cc3xx_lowlevel_ecdsa_getpub(bench_curves[curve].curve_id,
+                                          peer_private_key, peer_private_key_size,
+                                          peer_public_key_x, sizeof(peer_public_key_x),
+                                          &peer_public_key_x_size,
+                                          peer_public_key_y, sizeof(peer_public_key_y),
+                                          &peer_public_key_y_size);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+        cyccnt_start = get_cycle_count();
+        err = cc3xx_lowlevel_ecdh(bench_curves[curve].curve_id,
+                                  private_key, private_key_size,
+                                  peer_public_key_x, peer_public_key_x_size,
+                                  peer_public_key_y, peer_public_key_y_size,
+                                  shared_secret, sizeof(shared_secret),
+                                  &shared_secret_size);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+        snprintf(name, sizeof(name), "ecdh-%s", bench_curves[curve].name);
+        bench_report(BENCH_PATH_LOWLEVEL, name, 0, get_cycle_count() - cyccnt_start);
+    }
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+#endif /* CC3XX_CONFIG_ECDH_ENABLE && CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE */
+
+#ifdef CC3XX_CONFIG_RNG_ENABLE
+static int bench_drbg(void)
+{
+    uint32_t cyccnt_start;
+    cc3xx_err_t err;
+    int rc;
+
+    /* Get the one-off instantiation out of the way, so it isn't counted
+     * against the first message size.
+     */
+    err = cc3xx_lowlevel_rng_get_random((uint8_t *)bench_out, 16, CC3XX_RNG_DRBG);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    for (size_t idx = 0; idx < ARRAY_SIZE(bench_msg_sizes); idx++) {
+        if (bench_msg_sizes[idx] > sizeof(bench_out)) {
+            break;
+        }
+
+        cyccnt_start = get_cycle_count();
+        err = cc3xx_lowlevel_rng_get_random((uint8_t *)bench_out, bench_msg_sizes[idx],
+                                            CC3XX_RNG_DRBG);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+        bench_report(BENCH_PATH_LOWLEVEL, "drbg", bench_msg_sizes[idx],
+                     get_cycle_count() - cyccnt_start);
+    }
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+#endif /* CC3XX_CONFIG_RNG_ENABLE */
+
+#ifdef TEST_CC3XX_BENCHMARK_PSA
+static int bench_psa_hash(void)
+{
+    uint8_t digest[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+    size_t digest_len;
+    uint32_t cyccnt_start;
+    psa_status_t status;
+    int rc;
+
+    for (size_t idx = 0; idx < ARRAY_SIZE(bench_msg_sizes); idx++) {
+        if (bench_msg_sizes[idx] > CC3XX_TEST_BENCHMARK_PSA_MAX_MSG_SIZE) {
+            break;
+        }
+
+        cyccnt_start = get_cycle_count();
+        status = psa_hash_compute(PSA_ALG_SHA_256, (uint8_t *)bench_in,
+                                  bench_msg_sizes[idx], digest, sizeof(digest),
+                                  &digest_len);
+        if (status == PSA_ERROR_NOT_SUPPORTED) {
+            break;
+        }
+        cc3xx_test_assert(status == PSA_SUCCESS);
+        bench_report(BENCH_PATH_PSA, "sha256", bench_msg_sizes[idx],
+                     get_cycle_count() - cyccnt_start);
+    }
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+
+static const struct {
+    psa_key_type_t key_type;
+    psa_algorithm_t alg;
+    const char *name;
+    size_t key_bits;
+    size_t nonce_len;
+} bench_psa_ciphers[] = {
+    {PSA_KEY_TYPE_AES, PSA_ALG_ECB_NO_PADDING, "aes128-ecb", 128, 0},
+    {PSA_KEY_TYPE_AES, PSA_ALG_CBC_NO_PADDING, "aes128-cbc", 128, 0},
+    {PSA_KEY_TYPE_AES, PSA_ALG_CTR, "aes128-ctr", 128, 0},
+    {PSA_KEY_TYPE_AES, PSA_ALG_GCM, "aes128-gcm", 128, 12},
+    {PSA_KEY_TYPE_AES, PSA_ALG_CCM, "aes128-ccm", 128, 12},
+    {PSA_KEY_TYPE_AES, PSA_ALG_CMAC, "aes128-cmac", 128, 0},
+    {PSA_KEY_TYPE_CHACHA20, PSA_ALG_CHACHA20_POLY1305, "chacha20-poly1305", 256, 12},
+};
+
+/* The cipher modes generate their IV inside psa_cipher_encrypt(), and key
+ * import is left out of the measurement, as it has no low-level equivalent.
+ * Algorithms left out of the crypto service config are skipped, as they are
+ * in the other PSA benchmarks.
+ */
+static int bench_psa_cipher(void)
+{
+    psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+    psa_key_id_t key = PSA_KEY_ID_NULL;
+    size_t out_len;
+    uint32_t cyccnt_start;
+    psa_algorithm_t alg;
+    psa_status_t status;
+    int rc;
+
+    for (size_t cipher = 0; cipher < ARRAY_SIZE(bench_psa_ciphers); cipher++) {
+        alg = bench_psa_ciphers[cipher].alg;
+
+        psa_set_key_type(&attr, bench_psa_ciphers[cipher].key_type);
+        psa_set_key_bits(&attr, bench_psa_ciphers[cipher].key_bits);
+        psa_set_key_algorithm(&attr, alg);
+        psa_set_key_usage_flags(&attr, PSA_ALG_IS_MAC(alg) ? PSA_KEY_USAGE_SIGN_MESSAGE
+                                                           : PSA_KEY_USAGE_ENCRYPT);
+
+        status = psa_import_key(&attr, (const uint8_t *)bench_key,
+                                PSA_BITS_TO_BYTES(bench_psa_ciphers[cipher].key_bits),
+                                &key);
+        if (status == PSA_ERROR_NOT_SUPPORTED) {
+            continue;
+        }
+        cc3xx_test_assert(status == PSA_SUCCESS);
+
+        for (size_t idx = 0; idx < ARRAY_SIZE(bench_msg_sizes); idx++) {
+            if (bench_msg_sizes[idx] > CC3XX_TEST_BENCHMARK_PSA_MAX_MSG_SIZE) {
+                break;
+            }
+
+            cyccnt_start = get_cycle_count();
+            if (PSA_ALG_IS_MAC(alg)) {
+                status = psa_mac_compute(key, alg, (uint8_t *)bench_in,
+                                         bench_msg_sizes[idx], (uint8_t *)bench_out,
+                                         sizeof(bench_out), &out_len);
+            } else if (PSA_ALG_IS_AEAD(alg)) {
+                status = psa_aead_encrypt(key, alg, (const uint8_t *)bench_iv,
+                                          bench_psa_ciphers[cipher].nonce_len,
+                                          NULL, 0, (uint8_t *)bench_in,
+                                          bench_msg_sizes[idx], (uint8_t *)bench_out,
+                                          sizeof(bench_out), &out_len);
+            } else {
+                status = psa_cipher_encrypt(key, alg, (uint8_t *)bench_in,
+                                            bench_msg_sizes[idx], (uint8_t *)bench_out,
+                                            sizeof(bench_out), &out_len);
+            }
+            cc3xx_test_assert(status == PSA_SUCCESS);
+            bench_report(BENCH_PATH_PSA, bench_psa_ciphers[cipher].name,
+                         bench_msg_sizes[idx], get_cycle_count() - cyccnt_start);
+        }
+
+        psa_destroy_key(key);
+        key = PSA_KEY_ID_NULL;
+    }
+
+    rc = 0;
+cleanup:
+    if (key != PSA_KEY_ID_NULL) {
+        psa_destroy_key(key);
+    }
+
+    return rc;
+}
+
+static const struct {
+    size_t key_bits;
+    const char *name;
+} bench_psa_curves[] = {
+    {256, "p256"},
+    {384, "p384"},
+};
+
+static int bench_psa_ecc(void)
+{
+    psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+    psa_key_id_t key = PSA_KEY_ID_NULL;
+    psa_key_id_t peer_key = PSA_KEY_ID_NULL;
+    uint8_t sig[PSA_SIGNATURE_MAX_SIZE];
+    uint8_t peer_public_key[PSA_EXPORT_PUBLIC_KEY_MAX_SIZE];
+    uint8_t shared_secret[PSA_RAW_KEY_AGREEMENT_OUTPUT_MAX_SIZE];
+    size_t sig_len, peer_public_key_len, shared_secret_len;
+    char name[32];
+    uint32_t cyccnt_start;
+    psa_status_t status;
+    int rc;
+
+    for (size_t curve = 0; curve < ARRAY_SIZE(bench_psa_curves); curve++) {
+        psa_set_key_type(&attr, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+        psa_set_key_bits(&attr, bench_psa_curves[curve].key_bits);
+        psa_set_key_algorithm(&attr, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
+        psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_SIGN_HASH | PSA_KEY_USAGE_VERIFY_HASH);
+
+        status = psa_generate_key(&attr, &key);
+        if (status == PSA_ERROR_NOT_SUPPORTED) {
+            continue;
+        }
+        cc3xx_test_assert(status == PSA_SUCCESS);
+
+        /* The input message is as good a hash as any for timing purposes */
+        cyccnt_start = get_cycle_count();
+        status = psa_sign_hash(key, PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+                               (uint8_t *)bench_in, SHA256_OUTPUT_SIZE,
+                               sig, sizeof(sig), &sig_len);
+        cc3xx_test_assert(status == PSA_SUCCESS);
+        snprintf(name, sizeof(name), "ecdsa-%s-sign", bench_psa_curves[curve].name);
+        bench_report(BENCH_PATH_PSA, name, 0, get_cycle_count() - cyccnt_start);
+
+        cyccnt_start = get_cycle_count();
+        status = psa_verify_hash(key, PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+                                 (uint8_t *)bench_in, SHA256_OUTPUT_SIZE,
+                                 sig, sig_len);
+        cc3xx_test_assert(status == PSA_SUCCESS);
+        snprintf(name, sizeof(name), "ecdsa-%s-verify", bench_psa_curves[curve].name);
+        bench_report(BENCH_PATH_PSA, name, 0, get_cycle_count() - cyccnt_start);
+
+        psa_destroy_key(key);
+        key = PSA_KEY_ID_NULL;
+
+        psa_set_key_algorithm(&attr, PSA_ALG_ECDH);
+        psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_DERIVE);
+
+        status = psa_generate_key(&attr, &key);
+        if (status == PSA_ERROR_NOT_SUPPORTED) {
+            continue;
+        }
+        cc3xx_test_assert(status == PSA_SUCCESS);
+
+        status = psa_generate_key(&attr, &peer_key);
+        cc3xx_test_assert(status == PSA_SUCCESS);
+
+        status = psa_export_public_key(peer_key, peer_public_key,
+                                       sizeof(peer_public_key),
+                                       &peer_public_key_len);
+        cc3xx_test_assert(status == PSA_SUCCESS);
+
+        cyccnt_start = get_cycle_count();
+        status = psa_raw_key_agreement(PSA_ALG_ECDH, key, peer_public_key,
+                                       peer_public_key_len, shared_secret,
+                                       sizeof(shared_secret), &shared_secret_len);
+        cc3xx_test_assert(status == PSA_SUCCESS);
+        snprintf(name, sizeof(name), "ecdh-%s", bench_psa_curves[curve].name);
+        bench_report(BENCH_PATH_PSA, name, 0, get_cycle_count() - cyccnt_start);
+
+        psa_destroy_key(key);
+        key = PSA_KEY_ID_NULL;
+        psa_destroy_key(peer_key);
+        peer_key = PSA_KEY_ID_NULL;
+    }
+
+    rc = 0;
+cleanup:
+    if (key != PSA_KEY_ID_NULL) {
+        psa_destroy_key(key);
+    }
+    if (peer_key != PSA_KEY_ID_NULL) {
+        psa_destroy_key(peer_key);
+    }
+
+    return rc;
+}
+
+static int bench_psa_random(void)
+{
+    uint32_t cyccnt_start;
+    psa_status_t status;
+    int rc;
+
+    for (size_t idx = 0; idx < ARRAY_SIZE(bench_msg_sizes); idx++) {
+        if (bench_msg_sizes[idx] > CC3XX_TEST_BENCHMARK_PSA_MAX_MSG_SIZE) {
+            break;
+        }
+
+        cyccnt_start = get_cycle_count();
+        status = psa_generate_random((uint8_t *)bench_out, bench_msg_sizes[idx]);
+        if (status == PSA_ERROR_NOT_SUPPORTED) {
+            break;
+        }
+        cc3xx_test_assert(status == PSA_SUCCESS);
+        bench_report(BENCH_PATH_PSA, "drbg", bench_msg_sizes[idx],
+                     get_cycle_count() - cyccnt_start);
+    }
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+#endif /* TEST_CC3XX_BENCHMARK_PSA */
+
+#ifdef TEST_CC3XX_BENCHMARK_MBEDTLS
+static const struct {
+    enum cc3xx_bench_mbedtls_alg_t alg;
+    const char *name;
+} bench_mbedtls_algs[] = {
+    {CC3XX_BENCH_MBEDTLS_SHA256, "sha256"},
+    {CC3XX_BENCH_MBEDTLS_AES128_ECB, "aes128-ecb"},
+    {CC3XX_BENCH_MBEDTLS_AES128_CBC, "aes128-cbc"},
+    {CC3XX_BENCH_MBEDTLS_AES128_CTR, "aes128-ctr"},
+    {CC3XX_BENCH_MBEDTLS_AES128_GCM, "aes128-gcm"},
+    {CC3XX_BENCH_MBEDTLS_AES128_CCM, "aes128-ccm"},
+    {CC3XX_BENCH_MBEDTLS_AES128_CMAC, "aes128-cmac"},
+    {CC3XX_BENCH_MBEDTLS_CHACHA20_POLY1305, "chacha20-poly1305"},
+};
+
+/* Algorithms left out of the Mbed TLS config are skipped */
+static int bench_mbedtls(void)
+{
+    uint32_t cyccnt_start;
+    int err;
+    int rc;
+
+    for (size_t alg = 0; alg < ARRAY_SIZE(bench_mbedtls_algs); alg++) {
+        for (size_t idx = 0; idx < ARRAY_SIZE(bench_msg_sizes); idx++) {
+            if (bench_msg_sizes[idx] > sizeof(bench_in)) {
+                break;
+            }
+
+            cyccnt_start = get_cycle_count();
+            err = cc3xx_bench_mbedtls_run(bench_mbedtls_algs[alg].alg,
+                                          (const uint8_t *)bench_key,
+                                          (const uint8_t *)bench_iv,
+                                          (const uint8_t *)bench_in,
+                                          bench_msg_sizes[idx],
+                                          (uint8_t *)bench_out, sizeof(bench_out));
+            if (err == CC3XX_BENCH_MBEDTLS_NOT_SUPPORTED) {
+                break;
+            }
+            cc3xx_test_assert(err == 0);
+            bench_report(BENCH_PATH_MBEDTLS, bench_mbedtls_algs[alg].name,
+                         bench_msg_sizes[idx], get_cycle_count() - cyccnt_start);
+        }
+    }
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+#endif /* TEST_CC3XX_BENCHMARK_MBEDTLS */
+
+static void benchmark_tests_run(struct test_result_t *ret)
+{
+    int rc = 0;
+
+    bench_fill_input();
+
+    TEST_LOG("CC3XX_BENCH,path,algorithm,bytes,cycles\r\n");
+
+#ifdef CC3XX_CONFIG_HASH_SHA256_ENABLE
+    rc |= bench_hash();
+#endif /* CC3XX_CONFIG_HASH_SHA256_ENABLE */
+    rc |= bench_aes();
+#if defined(CC3XX_CONFIG_CHACHA_ENABLE) && defined(CC3XX_CONFIG_CHACHA_POLY1305_ENABLE)
+    rc |= bench_chacha20_poly1305();
+#endif /* CC3XX_CONFIG_CHACHA_ENABLE && CC3XX_CONFIG_CHACHA_POLY1305_ENABLE */
+#if defined(CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE) && \
+    defined(CC3XX_CONFIG_ECDSA_SIGN_ENABLE) && \
+    defined(CC3XX_CONFIG_ECDSA_VERIFY_ENABLE)
+    rc |= bench_ecdsa();
+#endif /* CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE && CC3XX_CONFIG_ECDSA_SIGN_ENABLE && CC3XX_CONFIG_ECDSA_VERIFY_ENABLE */
+#if defined(CC3XX_CONFIG_ECDH_ENABLE) && defined(CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE)
+    rc |= bench_ecdh();
+#endif /* CC3XX_CONFIG_ECDH_ENABLE && CC3XX_CONFIG_ECDSA_KEYGEN_ENABLE */
+#ifdef CC3XX_CONFIG_RNG_ENABLE
+    rc |= bench_drbg();
+#endif /* CC3XX_CONFIG_RNG_ENABLE */
+
+#ifdef TEST_CC3XX_BENCHMARK_PSA
+    rc |= bench_psa_hash();
+    rc |= bench_psa_cipher();
+    rc |= bench_psa_ecc();
+    rc |= bench_psa_random();
+#endif /* TEST_CC3XX_BENCHMARK_PSA */
+
+#ifdef TEST_CC3XX_BENCHMARK_MBEDTLS
+    rc |= bench_mbedtls();
+#endif /* TEST_CC3XX_BENCHMARK_MBEDTLS */
+
+    if (rc != 0) {
+        TEST_FAIL("Benchmarked operation failed");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+static struct test_t benchmark_tests = {
+    &benchmark_tests_run,
+    "CC3XX_BENCHMARK",
+    "CC3XX benchmarks",
+};
+
+void add_cc3xx_benchmark_tests_to_testsuite(struct test_suite_t *p_ts, uint32_t ts_size)
+{
+    enable_cycle_counter();
+
+    cc3xx_add_tests_to_testsuite(&benchmark_tests, 1, p_ts, ts_size);
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2025, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CC3XX_TEST_BENCHMARK_H__
+#define __CC3XX_TEST_BENCHMARK_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "test_framework.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void add_cc3xx_benchmark_tests_to_testsuite(struct test_suite_t *p_ts, uint32_t ts_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CC3XX_TEST_BENCHMARK_H__ */
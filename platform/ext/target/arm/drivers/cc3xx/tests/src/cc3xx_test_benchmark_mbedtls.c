@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "cc3xx_test_benchmark_mbedtls.h"
+
+#include "mbedtls/sha256.h"
+#include "mbedtls/aes.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/ccm.h"
+#include "mbedtls/cmac.h"
+#include "mbedtls/chachapoly.h"
+
+#include <string.h>
+
+#define BENCH_AES_BLOCK_SIZE 16
+#define BENCH_TAG_SIZE       16
+
+#ifdef MBEDTLS_SHA256_C
+static int bench_mbedtls_sha256(const uint8_t *in, size_t in_len,
+                                uint8_t *out, size_t out_size)
+{
+    if (out_size < 32) {
+        return -1;
+    }
+
+    return mbedtls_sha256(in, in_len, out, 0);
+}
+#endif /* MBEDTLS_SHA256_C */
+
+#ifdef MBEDTLS_AES_C
+static int bench_mbedtls_aes(enum cc3xx_bench_mbedtls_alg_t alg,
+                             const uint8_t *key, const uint8_t *iv,
+                             const uint8_t *in, size_t in_len,
+                             uint8_t *out)
+{
+    mbedtls_aes_context ctx;
+    uint8_t iv_copy[BENCH_AES_BLOCK_SIZE];
+#ifdef MBEDTLS_CIPHER_MODE_CTR
+    uint8_t stream_block[BENCH_AES_BLOCK_SIZE];
+    size_t nc_off = 0;
+#endif /* MBEDTLS_CIPHER_MODE_CTR */
+    int rc;
+
+    /* CBC and CTR update the IV in place */
+    memcpy(iv_copy, iv, sizeof(iv_copy));
+
+    mbedtls_aes_init(&ctx);
+
+    rc = mbedtls_aes_setkey_enc(&ctx, key, 128);
+    if (rc != 0) {
+        goto out;
+    }
+
+    switch (alg) {
+    case CC3XX_BENCH_MBEDTLS_AES128_ECB:
+        for (size_t idx = 0; idx < in_len; idx += BENCH_AES_BLOCK_SIZE) {
+            rc = mbedtls_aes_crypt_ecb(&ctx, MBEDTLS_AES_ENCRYPT,
+                                       in + idx, out + idx);
+            if (rc != 0) {
+                break;
+            }
+        }
+        break;
+#ifdef MBEDTLS_CIPHER_MODE_CBC
+    case CC3XX_BENCH_MBEDTLS_AES128_CBC:
+        rc = mbedtls_aes_crypt_cbc(&ctx, MBEDTLS_AES_ENCRYPT, in_len,
+                                   iv_copy, in, out);
+        break;
+#endif /* MBEDTLS_CIPHER_MODE_CBC */
+#ifdef MBEDTLS_CIPHER_MODE_CTR
+    case CC3XX_BENCH_MBEDTLS_AES128_CTR:
+        rc = mbedtls_aes_crypt_ctr(&ctx, in_len, &nc_off, iv_copy,
+                                   stream_block, in, out);
+        break;
+#endif /* MBEDTLS_CIPHER_MODE_CTR */
+    default:
+        rc = CC3XX_BENCH_MBEDTLS_NOT_SUPPORTED;
+        break;
+    }
+
+out:
+    mbedtls_aes_free(&ctx);
+
+    return rc;
+}
+#endif /* MBEDTLS_AES_C */
+
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+static int bench_mbedtls_aes_gcm(const uint8_t *key, const uint8_t *iv,
+                                 const uint8_t *in, size_t in_len,
+                                 uint8_t *out)
+{
+    mbedtls_gcm_context ctx;
+    uint8_t tag[BENCH_TAG_SIZE];
+    int rc;
+
+    mbedtls_gcm_init(&ctx);
+
+    rc = mbedtls_gcm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, 128);
+    if (rc == 0) {
+        rc = mbedtls_gcm_crypt_and_tag(&ctx, MBEDTLS_GCM_ENCRYPT, in_len,
+                                       iv, 12, NULL, 0, in, out,
+                                       sizeof(tag), tag);
+    }
+
+    mbedtls_gcm_free(&ctx);
+
+    return rc;
+}
+#endif /* MBEDTLS_GCM_C && MBEDTLS_AES_C */
+
+#if defined(MBEDTLS_CCM_C) && defined(MBEDTLS_AES_C)
+static int bench_mbedtls_aes_ccm(const uint8_t *key, const uint8_t *iv,
+                                 const uint8_t *in, size_t in_len,
+                                 uint8_t *out)
+{
+    mbedtls_ccm_context ctx;
+    uint8_t tag[BENCH_TAG_SIZE];
+    int rc;
+
+    mbedtls_ccm_init(&ctx);
+
+    rc = mbedtls_ccm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, 128);
+    if (rc == 0) {
+        rc = mbedtls_ccm_encrypt_and_tag(&ctx, in_len, iv, 12, NULL, 0,
+                                         in, out, tag, sizeof(tag));
+    }
+
+    mbedtls_ccm_free(&ctx);
+
+    return rc;
+}
+#endif /* MBEDTLS_CCM_C && MBEDTLS_AES_C */
+
+#if defined(MBEDTLS_CMAC_C) && defined(MBEDTLS_AES_C)
+static int bench_mbedtls_aes_cmac(const uint8_t *key,
+                                  const uint8_t *in, size_t in_len,
+                                  uint8_t *out, size_t out_size)
+{
+    const mbedtls_cipher_info_t *info =
+        mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
+
+    if ((info == NULL) || (out_size < BENCH_TAG_SIZE)) {
+        return -1;
+    }
+
+    return mbedtls_cipher_cmac(info, key, 128, in, in_len, out);
+}
+#endif /* MBEDTLS_CMAC_C && MBEDTLS_AES_C */
+
+#ifdef MBEDTLS_CHACHAPOLY_C
+static int bench_mbedtls_chachapoly(const uint8_t *key, const uint8_t *iv,
+                                    const uint8_t *in, size_t in_len,
+                                    uint8_t *out)
+{
+    mbedtls_chachapoly_context ctx;
+    uint8_t tag[BENCH_TAG_SIZE];
+    int rc;
+
+    mbedtls_chachapoly_init(&ctx);
+
+    rc = mbedtls_chachapoly_setkey(&ctx, key);
+    if (rc == 0) {
+        rc = mbedtls_chachapoly_encrypt_and_tag(&ctx, in_len, iv, NULL, 0,
+                                                in, out, tag);
+    }
+
+    mbedtls_chachapoly_free(&ctx);
+
+    return rc;
+}
+#endif /* MBEDTLS_CHACHAPOLY_C */
+
+int cc3xx_bench_mbedtls_run(enum cc3xx_bench_mbedtls_alg_t alg,
+                            const uint8_t *key, const uint8_t *iv,
+                            const uint8_t *in, size_t in_len,
+                            uint8_t *out, size_t out_size)
+{
+    /* Unused when only hashes are built in */
+    (void)key;
+    (void)iv;
+
+    if ((alg != CC3XX_BENCH_MBEDTLS_SHA256) &&
+        (alg != CC3XX_BENCH_MBEDTLS_AES128_CMAC) &&
+        ((out_size < in_len) || (in_len % BENCH_AES_BLOCK_SIZE != 0))) {
+        return -1;
+    }
+
+    switch (alg) {
+#ifdef MBEDTLS_SHA256_C
+    case CC3XX_BENCH_MBEDTLS_SHA256:
+        return bench_mbedtls_sha256(in, in_len, out, out_size);
+#endif /* MBEDTLS_SHA256_C */
+#ifdef MBEDTLS_AES_C
+    case CC3XX_BENCH_MBEDTLS_AES128_ECB:
+    case CC3XX_BENCH_MBEDTLS_AES128_CBC:
+    case CC3XX_BENCH_MBEDTLS_AES128_CTR:
+        return bench_mbedtls_aes(alg, key, iv, in, in_len, out);
+#endif /* MBEDTLS_AES_C */
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+    case CC3XX_BENCH_MBEDTLS_AES128_GCM:
+        return bench_mbedtls_aes_gcm(key, iv, in, in_len, out);
+#endif /* MBEDTLS_GCM_C && MBEDTLS_AES_C */
+#if defined(MBEDTLS_CCM_C) && defined(MBEDTLS_AES_C)
+    case CC3XX_BENCH_MBEDTLS_AES128_CCM:
+        return bench_mbedtls_aes_ccm(key, iv, in, in_len, out);
+#endif /* MBEDTLS_CCM_C && MBEDTLS_AES_C */
+#if defined(MBEDTLS_CMAC_C) && defined(MBEDTLS_AES_C)
+    case CC3XX_BENCH_MBEDTLS_AES128_CMAC:
+        return bench_mbedtls_aes_cmac(key, in, in_len, out, out_size);
+#endif /* MBEDTLS_CMAC_C && MBEDTLS_AES_C */
+#ifdef MBEDTLS_CHACHAPOLY_C
+    case CC3XX_BENCH_MBEDTLS_CHACHA20_POLY1305:
+        return bench_mbedtls_chachapoly(key, iv, in, in_len, out);
+#endif /* MBEDTLS_CHACHAPOLY_C */
+    default:
+        return CC3XX_BENCH_MBEDTLS_NOT_SUPPORTED;
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CC3XX_TEST_BENCHMARK_MBEDTLS_H__
+#define __CC3XX_TEST_BENCHMARK_MBEDTLS_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum cc3xx_bench_mbedtls_alg_t {
+    CC3XX_BENCH_MBEDTLS_SHA256 = 0,
+    CC3XX_BENCH_MBEDTLS_AES128_ECB,
+    CC3XX_BENCH_MBEDTLS_AES128_CBC,
+    CC3XX_BENCH_MBEDTLS_AES128_CTR,
+    CC3XX_BENCH_MBEDTLS_AES128_GCM,
+    CC3XX_BENCH_MBEDTLS_AES128_CCM,
+    CC3XX_BENCH_MBEDTLS_AES128_CMAC,
+    CC3XX_BENCH_MBEDTLS_CHACHA20_POLY1305,
+    CC3XX_BENCH_MBEDTLS_ALG_COUNT,
+};
+
+/* The algorithm is left out of the Mbed TLS config */
+#define CC3XX_BENCH_MBEDTLS_NOT_SUPPORTED 1
+
+/**
+ * \brief Runs a one-shot operation through the software implementation of
+ *        Mbed TLS, for comparison with the CC3XX paths.
+ *
+ * \note  This is built against the Mbed TLS config of the crypto service,
+ *        hence it lives in its own translation unit.
+ *
+ * \param[in]  alg       Algorithm to run
+ * \param[in]  key       Key, 16 bytes for AES and 32 bytes for ChaCha20
+ * \param[in]  iv        IV or nonce, 16 bytes for CBC and CTR, 12 otherwise
+ * \param[in]  in        Input message, a multiple of the AES block size
+ * \param[in]  in_len    Size of the input message
+ * \param[out] out       Output buffer, for the digest, MAC or ciphertext
+ * \param[in]  out_size  Size of the output buffer
+ *
+ * \return 0 on success, CC3XX_BENCH_MBEDTLS_NOT_SUPPORTED if \p alg isn't
+ *         built in, a negative value otherwise
+ */
+int cc3xx_bench_mbedtls_run(enum cc3xx_bench_mbedtls_alg_t alg,
+                            const uint8_t *key, const uint8_t *iv,
+                            const uint8_t *in, size_t in_len,
+                            uint8_t *out, size_t out_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CC3XX_TEST_BENCHMARK_MBEDTLS_H__ */
@@ -12,6 +12,7 @@
 #include CC3XX_CONFIG_FILE
 #endif
 #include "cc3xx_test_assert.h"
+#include "cc3xx_rng.h"
 
 #include "cc3xx_test_utils.h"
 
@@ -205,6 +206,51 @@ cleanup:
 }
 #endif /* CC3XX_CONFIG_DRBG_CTR_ENABLE */
 
+#ifdef CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE
+void rng_entropy_pool_test(struct test_result_t *ret)
+{
+    cc3xx_err_t err;
+    uint32_t first[CC3XX_RNG_ENTROPY_SIZE / sizeof(uint32_t)];
+    uint32_t second[CC3XX_RNG_ENTROPY_SIZE / sizeof(uint32_t)];
+    uint32_t large[(CC3XX_CONFIG_RNG_ENTROPY_POOL_SIZE + CC3XX_RNG_ENTROPY_SIZE)
+                   / sizeof(uint32_t)];
+    size_t drawn;
+
+    err = cc3xx_lowlevel_rng_refill_entropy_pool();
+    TEST_ASSERT(err == CC3XX_ERR_SUCCESS, "entropy pool refill failed");
+    TEST_ASSERT(!cc3xx_lowlevel_rng_entropy_pool_needs_refill(),
+                "full entropy pool asks for a refill");
+
+    /* Draw from the pool until it drops below the low water mark */
+    for (drawn = 0; !cc3xx_lowlevel_rng_entropy_pool_needs_refill();
+         drawn += sizeof(first)) {
+        TEST_ASSERT(drawn < CC3XX_CONFIG_RNG_ENTROPY_POOL_SIZE,
+                    "drained entropy pool doesn't ask for a refill");
+        err = cc3xx_lowlevel_rng_get_entropy(first, sizeof(first));
+        TEST_ASSERT(err == CC3XX_ERR_SUCCESS, "pooled entropy draw failed");
+    }
+    TEST_ASSERT(drawn > CC3XX_CONFIG_RNG_ENTROPY_POOL_SIZE -
+                        CC3XX_CONFIG_RNG_ENTROPY_POOL_LOW_WATER_MARK,
+                "entropy pool asks for a refill above the low water mark");
+
+    /* Pooled entropy must never be handed out twice */
+    err = cc3xx_lowlevel_rng_refill_entropy_pool();
+    TEST_ASSERT(err == CC3XX_ERR_SUCCESS, "entropy pool refill failed");
+    err = cc3xx_lowlevel_rng_get_entropy(first, sizeof(first));
+    TEST_ASSERT(err == CC3XX_ERR_SUCCESS, "pooled entropy draw failed");
+    err = cc3xx_lowlevel_rng_get_entropy(second, sizeof(second));
+    TEST_ASSERT(err == CC3XX_ERR_SUCCESS, "pooled entropy draw failed");
+    TEST_ASSERT(memcmp(first, second, sizeof(first)) != 0,
+                "entropy pool repeated its output");
+
+    /* Requests larger than the pool are collected from the TRNG directly */
+    err = cc3xx_lowlevel_rng_get_entropy(large, sizeof(large));
+    TEST_ASSERT(err == CC3XX_ERR_SUCCESS, "entropy draw larger than the pool failed");
+
+    ret->val = TEST_PASSED;
+}
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE */
+
 static struct test_t drbg_ctr_tests[] = {
     /* df = derivative function, pr = prediction resistance */
 #ifdef CC3XX_CONFIG_DRBG_HASH_ENABLE
@@ -228,13 +274,21 @@ static struct test_t drbg_ctr_tests[] = {
         "CC3XX DRBG CTR test df=False pr=False",
     },
 #endif /* CC3XX_CONFIG_DRBG_CTR_ENABLE */
+#ifdef CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE
+    {
+        &rng_entropy_pool_test,
+        "CC3XX_RNG_ENTROPY_POOL_TEST",
+        "CC3XX RNG entropy pool test",
+    },
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE */
 };
 
 void add_cc3xx_drbg_tests_to_testsuite(struct test_suite_t *p_ts, uint32_t ts_size)
 {
 #if defined(CC3XX_CONFIG_DRBG_HASH_ENABLE) || \
     defined(CC3XX_CONFIG_DRBG_HMAC_ENABLE) || \
-    defined(CC3XX_CONFIG_DRBG_CTR_ENABLE)
+    defined(CC3XX_CONFIG_DRBG_CTR_ENABLE) || \
+    defined(CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE)
     cc3xx_add_tests_to_testsuite(drbg_ctr_tests, ARRAY_SIZE(drbg_ctr_tests), p_ts, ts_size);
 #endif
 }
@@ -48,6 +48,17 @@ typedef struct {
     uint8_t expected_y[32];
 } cc3xx_ec_point_exp_test_data_t;
 
+/* The values are big-endian byte strings, stored as words so that they can be
+ * passed to the PKA directly. Each word holds four bytes in memory order.
+ */
+typedef struct {
+    cc3xx_ec_curve_id_t curve_id;
+    uint32_t s[48 / 4];
+    uint32_t expected_x[48 / 4];
+    uint32_t expected_y[48 / 4];
+    size_t size;
+} cc3xx_ec_generator_exp_test_data_t;
+
 cc3xx_ec_public_key_test_data_t cavp_public_key_test_data[] = {
 {
     .curve_id = CC3XX_EC_CURVE_SECP_256_R1,
@@ -194,6 +205,40 @@ cc3xx_ec_point_exp_test_data_t exp_test_data = {
     .expected_y = {0x97, 0xad, 0x03, 0xe8, 0x3e, 0x55, 0xeb, 0x8b, 0x13, 0x6f, 0x90, 0x5a, 0x2e, 0xac, 0x44, 0xb4, 0x87, 0xa4, 0x8c, 0x85, 0xbb, 0xc4, 0xcb, 0xb5, 0x31, 0xd9, 0x59, 0xdf, 0x0b, 0x2d, 0xac, 0x4f, },
 };
 
+/* An odd and an even scalar for each curve with a comb table, as the comb
+ * handles them differently
+ */
+cc3xx_ec_generator_exp_test_data_t generator_exp_test_data[] = {
+{
+    .curve_id = CC3XX_EC_CURVE_SECP_256_R1,
+    .size = 32,
+    .s = {0x53471ec5, 0xe6c1deaf, 0xb9a5c6b6, 0x8d3ff492, 0x93a8c7d0, 0x8b707230, 0x8b462265, 0xfd06fb2f},
+    .expected_x = {0x409f2c94, 0x829dad8e, 0x9a1b4ad3, 0xbe7e826a, 0x78df2d3e, 0x238d442b, 0x43611bbe, 0xf4ce8c98},
+    .expected_y = {0x6caf9e8c, 0x92d9140d, 0xd3ba63fc, 0xe26b49e2, 0xb51ce6ee, 0xf4657fb9, 0xa594ca28, 0xa119eed0},
+},
+{
+    .curve_id = CC3XX_EC_CURVE_SECP_256_R1,
+    .size = 32,
+    .s = {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x02000000},
+    .expected_x = {0x187bf27c, 0x7e4f038d, 0x0338528a, 0xc31ab504, 0xe26989c0, 0x351bf277, 0xfc480ba6, 0x78996647},
+    .expected_y = {0x10557707, 0x40d08edb, 0xc69a3d29, 0xdb30749f, 0xe6ad7dba, 0x2982e93c, 0x9db7049e, 0xd1737822},
+},
+{
+    .curve_id = CC3XX_EC_CURVE_SECP_384_R1,
+    .size = 48,
+    .s = {0x94bc6795, 0x039dff1d, 0x5961fb2b, 0x7397e636, 0x35ca00a7, 0x1bc6b51d, 0x862db3ed, 0xd4cdb2e5, 0x01f6ae5c, 0x574270f4, 0xf4ef222f, 0x3f34943e},
+    .expected_x = {0xf9f9c491, 0x7c76a6aa, 0xf804a163, 0x71d32aa8, 0x9cb0f0d7, 0x72c0c619, 0xe361ac55, 0x59f72493, 0x24a2ef1a, 0x3173680e, 0x160c34cf, 0x0ec64aa2},
+    .expected_y = {0x367f3fe0, 0x9a8e56c7, 0xbb73924a, 0xb73f858e, 0x27ab7f8f, 0xd7e1e045, 0xd9c8aab0, 0x7becd45e, 0xc198c071, 0xc3425170, 0xdac56aaa, 0x6615616e},
+},
+{
+    .curve_id = CC3XX_EC_CURVE_SECP_384_R1,
+    .size = 48,
+    .s = {0x94bc6795, 0x039dff1d, 0x5961fb2b, 0x7397e636, 0x35ca00a7, 0x1bc6b51d, 0x862db3ed, 0xd4cdb2e5, 0x01f6ae5c, 0x574270f4, 0xf4ef222f, 0x3e34943e},
+    .expected_x = {0xdabededd, 0xd6a6f12c, 0xdbb5e525, 0x1662bc0b, 0x27b70130, 0x4f310724, 0xc76542c0, 0xe45ba528, 0x985a407e, 0x3a80a7ec, 0x76538286, 0xb7f244a2},
+    .expected_y = {0xb1c48fce, 0x3cec696f, 0x1c808f61, 0xc7a90e50, 0xdf1736bb, 0xfff69aab, 0x2925ffe9, 0xf7508e5e, 0x3a60803c, 0x3acd41fd, 0x70092f98, 0x7ef99969},
+},
+};
+
 int cc3xx_test_ecc_validate_point(cc3xx_ec_public_key_test_data_t *data)
 {
     size_t curve_register_size;
@@ -328,6 +373,42 @@ cleanup:
     return rc;
 }
 
+int cc3xx_test_ecc_exp_generator(cc3xx_ec_generator_exp_test_data_t *data)
+{
+    cc3xx_pka_reg_id_t s;
+    cc3xx_ec_point_affine result;
+    cc3xx_ec_curve_t curve;
+    uint32_t result_x[48 / 4];
+    uint32_t result_y[48 / 4];
+    cc3xx_err_t err;
+    int rc;
+
+    err = cc3xx_lowlevel_ec_init(data->curve_id, &curve);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    s = cc3xx_lowlevel_pka_allocate_reg();
+    cc3xx_lowlevel_pka_write_reg_swap_endian(s, data->s, data->size);
+
+    result = cc3xx_lowlevel_ec_allocate_point();
+
+    /* Passing the curve generator itself selects the fixed-base path, if it is
+     * enabled by config.
+     */
+    err = cc3xx_lowlevel_ec_multiply_point_by_scalar(&curve, &curve.generator, s,
+                                                     &result);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    cc3xx_lowlevel_pka_read_reg_swap_endian(result.x, result_x, data->size);
+    cc3xx_lowlevel_pka_read_reg_swap_endian(result.y, result_y, data->size);
+
+    cc3xx_test_assert(memcmp(data->expected_x, result_x, data->size) == 0);
+    cc3xx_test_assert(memcmp(data->expected_y, result_y, data->size) == 0);
+
+    rc = 0;
+cleanup:
+    return rc;
+}
+
 static void ecc_tests_run(struct test_result_t *ret)
 {
     for (int idx = 0;
@@ -342,6 +423,13 @@ static void ecc_tests_run(struct test_result_t *ret)
     TEST_ASSERT(cc3xx_test_ecc_exp_point(&exp_test_data_small) == 0, "point exponentiation should succeed (small example)");
     TEST_ASSERT(cc3xx_test_ecc_exp_point(&exp_test_data) == 0, "point exponentiation should succeed");
 
+    for (size_t idx = 0;
+         idx < sizeof(generator_exp_test_data) / sizeof(generator_exp_test_data[0]);
+         idx++) {
+        TEST_ASSERT(cc3xx_test_ecc_exp_generator(&generator_exp_test_data[idx]) == 0,
+                    "generator exponentiation should succeed");
+    }
+
     ret->val = TEST_PASSED;
     return;
 }
@@ -5,12 +5,14 @@
  *
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include "cc3xx_test_ecdsa.h"
 
 #include "cc3xx_ecdsa.h"
 #include "cc3xx_test_assert.h"
 #include "cc3xx_hash.h"
+#include "cc3xx_pka.h"
 
 #include "cc3xx_test_utils.h"
 
@@ -3414,6 +3416,18 @@ static int curve_id_to_name(cc3xx_ec_curve_id_t curve_id, const char **curve_nam
     return 0;
 }
 
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+static void print_pka_reg_stats(void)
+{
+    struct cc3xx_pka_reg_stats_t stats;
+
+    cc3xx_lowlevel_pka_get_reg_stats(&stats);
+    printf("    pka register maps: %" PRIu32 ", evictions: %" PRIu32
+           ", flushes: %" PRIu32 "\r\n",
+           stats.maps, stats.evictions, stats.flushes);
+}
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
+
 int cc3xx_test_sign_verify(cc3xx_ecdsa_validate_test_data_t *data)
 {
     cc3xx_err_t err;
@@ -3481,6 +3495,9 @@ int cc3xx_test_sign_verify(cc3xx_ecdsa_validate_test_data_t *data)
                              public_key_y, sizeof(public_key_y), &public_key_y_size);
     cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
 
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+    cc3xx_lowlevel_pka_reset_reg_stats();
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
     uint32_t cyccnt_start = get_cycle_count();
     err = cc3xx_lowlevel_ecdsa_sign(data->curve_id, private_key, private_key_size, hash, hash_len,
                            sig_r, sizeof(sig_r), &sig_r_size,
@@ -3488,10 +3505,16 @@ int cc3xx_test_sign_verify(cc3xx_ecdsa_validate_test_data_t *data)
     uint32_t cyccnt_end = get_cycle_count();
     printf("%s (%s) sign: %d cycles\r\n", curve_name, hash_name,
                                           cyccnt_end - cyccnt_start);
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+    print_pka_reg_stats();
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
 
     cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
 
     reset_cycle_count();
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+    cc3xx_lowlevel_pka_reset_reg_stats();
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
     uint32_t cyccnt_start_2 = get_cycle_count();
     err = cc3xx_lowlevel_ecdsa_verify(data->curve_id,
                              public_key_x, public_key_x_size,
@@ -3507,6 +3530,9 @@ int cc3xx_test_sign_verify(cc3xx_ecdsa_validate_test_data_t *data)
                                               "",
 #endif
                                             cyccnt_end_2 - cyccnt_start_2);
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+    print_pka_reg_stats();
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
 
     cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
 
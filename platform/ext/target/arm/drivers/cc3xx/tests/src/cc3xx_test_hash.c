@@ -127,6 +127,8 @@ static void hash_ ## alg  ## _lowlevel_tests_run(struct test_result_t *ret) \
                 "hash_test_long should pass"); \
     TEST_ASSERT(hash_test_lowlevel_oneshot(&hash_test_zero, alg) == 0, \
                 "hash_test_zero should pass"); \
+    TEST_ASSERT(hash_test_lowlevel_async(&hash_test_long, alg) == 0, \
+                "async hash_test_long should pass"); \
     TEST_ASSERT(hash_test_lowlevel_multipart(&hash_test_long, alg, 32) == 0, \
                 "multipart hash_test_long should pass with chunk size 32"); \
     TEST_ASSERT(hash_test_lowlevel_multipart(&hash_test_long, alg, 31) == 0, \
@@ -139,6 +141,12 @@ static void hash_ ## alg  ## _lowlevel_tests_run(struct test_result_t *ret) \
                 "multipart hash_test_long should pass with chunk size 64"); \
     TEST_ASSERT(hash_test_lowlevel_saveload_multipart(&hash_test_long, alg, 64) == 0, \
                 "multipart saveload hash_test_long should pass with chunk size 64"); \
+    TEST_ASSERT(hash_test_lowlevel_iovec(&hash_test_long, alg) == 0, \
+                "iovec hash_test_long should pass"); \
+    TEST_ASSERT(hash_test_lowlevel_iovec(&hash_test_short, alg) == 0, \
+                "iovec hash_test_short should pass"); \
+    TEST_ASSERT(hash_test_lowlevel_interleaved(&hash_test_long, alg, 31) == 0, \
+                "interleaved hash_test_long should pass with chunk size 31"); \
     TEST_ASSERT(hash_test_lowlevel_reinit(&hash_test_block, alg) == 0, \
                 "reiniting hash_test_block should pass"); \
     ret->val = TEST_PASSED; \
@@ -13,6 +13,8 @@
 #include "cc3xx_test_pka.h"
 #include "cc3xx_test_ecc.h"
 #include "cc3xx_test_ecdsa.h"
+#include "cc3xx_test_drbg.h"
+#include "cc3xx_test_benchmark.h"
 
 void add_cc3xx_tests_to_testsuite(struct test_suite_t *p_ts, uint32_t ts_size)
 {
@@ -37,4 +39,7 @@ void add_cc3xx_tests_to_testsuite(struct test_suite_t *p_ts, uint32_t ts_size)
 #if defined(TEST_CC3XX) && defined(TEST_CC3XX_DRBG)
     add_cc3xx_drbg_tests_to_testsuite(p_ts, ts_size);
 #endif
+#if defined(TEST_CC3XX) && defined(TEST_CC3XX_BENCHMARK)
+    add_cc3xx_benchmark_tests_to_testsuite(p_ts, ts_size);
+#endif
 }
@@ -13,6 +13,7 @@
 #endif
 #include "cc3xx_test_assert.h"
 #include "cc3xx_dev.h"
+#include "cc3xx_rng.h"
 
 #include "cc3xx_test_utils.h"
 
@@ -845,38 +846,55 @@ cleanup:
     return;
 }
 
+#ifdef CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE
+/* Uses more virtual registers than there are physical registers, so that
+ * mappings have to be evicted while the operands stay live.
+ */
 void pka_test_virtual_registers(struct test_result_t *ret)
 {
     cc3xx_pka_reg_id_t r[CC3XX_CONFIG_PKA_MAX_VIRT_REG_AMOUNT - 4];
+    const uint32_t reg_am = sizeof(r) / sizeof(r[0]);
     cc3xx_pka_reg_id_t res;
     uint64_t readback;
     uint32_t idx;
     uint32_t rand_0;
     uint32_t rand_1;
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+    struct cc3xx_pka_reg_stats_t stats;
+
+    cc3xx_lowlevel_pka_reset_reg_stats();
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
 
     cc3xx_lowlevel_pka_init(4);
     res = cc3xx_lowlevel_pka_allocate_reg();
 
-    for (idx = 0; idx < sizeof(r); idx++) {
+    for (idx = 0; idx < reg_am; idx++) {
         r[idx] = cc3xx_lowlevel_pka_allocate_reg();
         cc3xx_lowlevel_pka_write_reg(r[idx], &idx, sizeof(idx));
     }
 
     for (idx = 0; idx < 128; idx++) {
-        cc3xx_lowlevel_rng_get_random_uint(sizeof(r), &rand_0);
-        cc3xx_lowlevel_rng_get_random_uint(sizeof(r), &rand_1);
+        cc3xx_lowlevel_rng_get_random_uint(reg_am, &rand_0, CC3XX_RNG_DRBG);
+        cc3xx_lowlevel_rng_get_random_uint(reg_am, &rand_1, CC3XX_RNG_DRBG);
 
+        readback = 0;
         cc3xx_lowlevel_pka_add(r[rand_0], r[rand_1], res);
-        cc3xx_lowlevel_pka_read_reg(res, &readback, sizeof(readback));
+        cc3xx_lowlevel_pka_read_reg(res, (uint32_t *)&readback, sizeof(readback));
         TEST_ASSERT(readback == rand_0 + rand_1, "readback not equal to expected");
     }
 
+#ifdef CC3XX_CONFIG_PKA_STATS_ENABLE
+    cc3xx_lowlevel_pka_get_reg_stats(&stats);
+    TEST_ASSERT(stats.evictions > 0, "no registers were evicted");
+#endif /* CC3XX_CONFIG_PKA_STATS_ENABLE */
+
     ret->val = TEST_PASSED;
 cleanup:
     cc3xx_lowlevel_pka_uninit();
 
     return;
 }
+#endif /* CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE */
 
 void pka_test_large_exponentiation(struct test_result_t *ret)
 {
@@ -1020,14 +1038,12 @@ void pka_test_cycle_counts(struct test_result_t *ret)
         cc3xx_lowlevel_pka_are_equal_si,
         cc3xx_lowlevel_pka_less_than_si,
         cc3xx_lowlevel_pka_greater_than_si,
-        cc3xx_lowlevel_pka_test_bits_ui,
     };
 
     char *binary_imm_function_names[] = {
         "cc3xx_lowlevel_pka_are_equal_si",
         "cc3xx_lowlevel_pka_less_than_si",
         "cc3xx_lowlevel_pka_greater_than_si",
-        "cc3xx_lowlevel_pka_test_bits_ui",
     };
 
     void (*trinary_functions[])(cc3xx_pka_reg_id_t, cc3xx_pka_reg_id_t, cc3xx_pka_reg_id_t) = {
@@ -1127,7 +1143,7 @@ void pka_test_cycle_counts(struct test_result_t *ret)
 
     printf_set_color(MAGENTA);
 
-    for (int I = 0; I < sizeof(unary_functions) / 4; I++) {
+    for (size_t I = 0; I < ARRAY_SIZE(unary_functions); I++) {
         cyccnt_start = get_cycle_count();
         unary_functions[I](foo);
         cyccnt_end = get_cycle_count();
@@ -1135,7 +1151,7 @@ void pka_test_cycle_counts(struct test_result_t *ret)
                                     cyccnt_end - cyccnt_start);
     }
 
-    for (int I = 0; I < sizeof(binary_functions) / 4; I++) {
+    for (size_t I = 0; I < ARRAY_SIZE(binary_functions); I++) {
         cyccnt_start = get_cycle_count();
         binary_functions[I](r0, foo);
         cyccnt_end = get_cycle_count();
@@ -1143,7 +1159,7 @@ void pka_test_cycle_counts(struct test_result_t *ret)
                                     cyccnt_end - cyccnt_start);
     }
 
-    for (int I = 0; I < sizeof(binary_uimm_functions) / 4; I++) {
+    for (size_t I = 0; I < ARRAY_SIZE(binary_uimm_functions); I++) {
         cyccnt_start = get_cycle_count();
         binary_uimm_functions[I](foo, imm);
         cyccnt_end = get_cycle_count();
@@ -1151,7 +1167,7 @@ void pka_test_cycle_counts(struct test_result_t *ret)
                                     cyccnt_end - cyccnt_start);
     }
 
-    for (int I = 0; I < sizeof(binary_imm_functions) / 4; I++) {
+    for (size_t I = 0; I < ARRAY_SIZE(binary_imm_functions); I++) {
         cyccnt_start = get_cycle_count();
         binary_imm_functions[I](foo, simm);
         cyccnt_end = get_cycle_count();
@@ -1159,7 +1175,7 @@ void pka_test_cycle_counts(struct test_result_t *ret)
                                     cyccnt_end - cyccnt_start);
     }
 
-    for (int I = 0; I < sizeof(trinary_functions) / 4; I++) {
+    for (size_t I = 0; I < ARRAY_SIZE(trinary_functions); I++) {
         cyccnt_start = get_cycle_count();
         trinary_functions[I](r0, r1, foo);
         cyccnt_end = get_cycle_count();
@@ -1167,15 +1183,15 @@ void pka_test_cycle_counts(struct test_result_t *ret)
                                     cyccnt_end - cyccnt_start);
     }
 
-    for (int I = 0; I < sizeof(trinary_imm_functions) / 4; I++) {
+    for (size_t I = 0; I < ARRAY_SIZE(trinary_imm_functions); I++) {
         cyccnt_start = get_cycle_count();
-        trinary_uimm_functions[I](r0, simm, foo);
+        trinary_imm_functions[I](r0, simm, foo);
         cyccnt_end = get_cycle_count();
-        TEST_LOG("%s: %d cycles\r\n", trinary_uimm_function_names[I],
+        TEST_LOG("%s: %d cycles\r\n", trinary_imm_function_names[I],
                                     cyccnt_end - cyccnt_start);
     }
 
-    for (int I = 0; I < sizeof(trinary_imm_functions) / 4; I++) {
+    for (size_t I = 0; I < ARRAY_SIZE(trinary_uimm_functions); I++) {
         cyccnt_start = get_cycle_count();
         trinary_uimm_functions[I](r0, simm, foo);
         cyccnt_end = get_cycle_count();
@@ -1183,7 +1199,7 @@ void pka_test_cycle_counts(struct test_result_t *ret)
                                     cyccnt_end - cyccnt_start);
     }
 
-    for (int I = 0; I < sizeof(trinary_dual_uimm_functions) / 4; I++) {
+    for (size_t I = 0; I < ARRAY_SIZE(trinary_dual_uimm_functions); I++) {
         cyccnt_start = get_cycle_count();
         for (int J = 0; J < 100; J++) {
             trinary_dual_uimm_functions[I](r0, imm, imm);
@@ -1357,11 +1373,13 @@ static struct test_t pka_tests[] = {
         "CC3XX_PKA_TEST_TEST_BITS_UI",
         "CC3XX PKA bit-test (unsigned immediate) test",
     },
-    /* { */
-    /*     &pka_test_virtual_registers, */
-    /*     "CC3XX_PKA_TEST_VIRTUAL_REGISTERS", */
-    /*     "CC3XX PKA virtual register test", */
-    /* }, */
+#ifdef CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE
+    {
+        &pka_test_virtual_registers,
+        "CC3XX_PKA_TEST_VIRTUAL_REGISTERS",
+        "CC3XX PKA virtual register test",
+    },
+#endif /* CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE */
     {
         &pka_test_large_exponentiation,
         "CC3XX_PKA_TEST_LARGE_EXPONENTIATION",
@@ -152,19 +152,29 @@ int chacha_test_lowlevel_verify_negative(struct chacha_test_data_t *data)
                         data->iv_len);
     cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
 
-    auth_data[0] ^= 0xFF;
+    if (data->auth_data_len > 0) {
+        /* Mangle auth data */
+        auth_data[0] ^= 0xFF;
+        expected_ciphertext_match = 1;
+    } else {
+        /* Mangle ciphertext */
+        ciphertext[0] ^= 0xFF;
+    }
 
     cc3xx_lowlevel_chacha20_set_output_buffer(plaintext, sizeof(plaintext));
 
-    cc3xx_lowlevel_chacha20_update_authed_data(auth_data, data->auth_data_len);
+    cc3xx_lowlevel_chacha20_update_authed_data((uint8_t *)auth_data, data->auth_data_len);
 
-    cc3xx_lowlevel_chacha20_update(data->ciphertext, data->ciphertext_len);
+    cc3xx_lowlevel_chacha20_update((uint8_t *)ciphertext, data->ciphertext_len);
 
     err = cc3xx_lowlevel_chacha20_finish(data->tag, NULL);
     cc3xx_test_assert(err == CC3XX_ERR_INVALID_TAG);
 
-    cc3xx_test_assert(memcmp(plaintext, data->plaintext,
-                             data->plaintext_len) == 0);
+    if (data->ciphertext_len != 0) {
+        cc3xx_test_assert((memcmp(plaintext, data->plaintext,
+                                  data->plaintext_len) == 0)
+                          == expected_ciphertext_match);
+    }
 
     rc = 0;
 cleanup:
@@ -8,7 +8,9 @@
 #include "cc3xx_test_hash.h"
 
 #include "cc3xx_hash.h"
+#include "cc3xx_dma.h"
 #include "cc3xx_test_assert.h"
+#include "cc3xx_test_utils.h"
 
 #include <string.h>
 
@@ -38,6 +40,55 @@ cleanup:
     return rc;
 }
 
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+static void hash_test_dma_completion(void *ctx)
+{
+    (*(uint32_t *)ctx)++;
+}
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
+int hash_test_lowlevel_async(struct hash_test_data_t *data,
+                             cc3xx_hash_alg_t alg)
+{
+    uint32_t output[SHA256_OUTPUT_SIZE / sizeof(uint32_t)];
+    cc3xx_err_t err;
+    int rc;
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+    uint32_t completions = 0;
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
+    err = cc3xx_lowlevel_hash_init(alg);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+    cc3xx_lowlevel_dma_set_async(hash_test_dma_completion, &completions);
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
+    err = cc3xx_lowlevel_hash_update(data->input, data->input_size);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+#ifdef CC3XX_CONFIG_DMA_ASYNC_ENABLE
+    /* Poll the handler, in case the interrupt isn't routed to it */
+    while (cc3xx_lowlevel_dma_is_busy()) {
+        cc3xx_lowlevel_dma_irq_handler();
+    }
+
+    /* Only the whole blocks before the last are transferred asynchronously */
+    cc3xx_test_assert(completions == (data->input_size > 64 ? 1 : 0));
+#endif /* CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
+    cc3xx_lowlevel_hash_finish(output, hash_size_from_alg(alg));
+
+    cc3xx_test_assert(memcmp(output, output_from_alg_and_data(alg, data),
+                      hash_size_from_alg(alg)) == 0);
+
+    rc = 0;
+cleanup:
+    cc3xx_lowlevel_hash_uninit();
+
+    return rc;
+}
+
 int hash_test_lowlevel_multipart(struct hash_test_data_t *data,
                                  cc3xx_hash_alg_t alg,
                                  size_t chunk_size)
@@ -69,6 +120,120 @@ cleanup:
     return rc;
 }
 
+int hash_test_lowlevel_iovec(struct hash_test_data_t *data,
+                             cc3xx_hash_alg_t alg)
+{
+    uint32_t output[SHA256_OUTPUT_SIZE / sizeof(uint32_t)] = {0};
+    /* Fragments which straddle blocks, fill them exactly and are empty */
+    const size_t frag_sizes[] = {7, 64, 0, 1, 121};
+    struct cc3xx_dma_iovec_t iov[ARRAY_SIZE(frag_sizes)];
+    cc3xx_err_t err;
+    size_t offset = 0;
+    size_t idx;
+    int rc;
+
+    for (idx = 0; idx < ARRAY_SIZE(frag_sizes); idx++) {
+        size_t len = frag_sizes[idx];
+
+        if (len > data->input_size - offset) {
+            len = data->input_size - offset;
+        }
+
+        iov[idx].buf = data->input + offset;
+        iov[idx].len = len;
+        offset += len;
+    }
+
+    err = cc3xx_lowlevel_hash_init(alg);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    err = cc3xx_lowlevel_hash_update_iovec(iov, ARRAY_SIZE(iov));
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    /* Anything which didn't fit in the fragments */
+    err = cc3xx_lowlevel_hash_update(data->input + offset,
+                                     data->input_size - offset);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    cc3xx_lowlevel_hash_finish(output, hash_size_from_alg(alg));
+
+    cc3xx_test_assert(memcmp(output, output_from_alg_and_data(alg, data),
+                             hash_size_from_alg(alg)) == 0);
+
+    rc = 0;
+cleanup:
+    cc3xx_lowlevel_hash_uninit();
+
+    return rc;
+}
+
+int hash_test_lowlevel_interleaved(struct hash_test_data_t *data,
+                                   cc3xx_hash_alg_t alg,
+                                   size_t chunk_size)
+{
+    uint32_t output[SHA256_OUTPUT_SIZE / sizeof(uint32_t)] = {0};
+    struct cc3xx_hash_state_t state_a = {0};
+    struct cc3xx_hash_state_t state_b = {0};
+    struct cc3xx_hash_state_t state_copy = {0};
+    cc3xx_err_t err;
+    size_t chunk;
+    size_t idx;
+    int rc;
+
+    err = cc3xx_lowlevel_hash_init(alg);
+    cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+
+    cc3xx_lowlevel_hash_get_state(&state_a);
+    cc3xx_lowlevel_hash_uninit();
+    memcpy(&state_b, &state_a, sizeof(state_b));
+
+    for (idx = 0; idx < data->input_size; idx += chunk_size) {
+        chunk = data->input_size - idx < chunk_size ?
+                data->input_size - idx : chunk_size;
+
+        /* Back-to-back steps on the same state, then a switch */
+        cc3xx_lowlevel_hash_load_state(&state_a);
+        err = cc3xx_lowlevel_hash_update(data->input + idx, chunk);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+        cc3xx_lowlevel_hash_put_state(&state_a);
+
+        cc3xx_lowlevel_hash_load_state(&state_b);
+        err = cc3xx_lowlevel_hash_update(data->input + idx, chunk);
+        cc3xx_test_assert(err == CC3XX_ERR_SUCCESS);
+        cc3xx_lowlevel_hash_put_state(&state_b);
+
+        /* A user of the engine which knows nothing about the states */
+        if ((idx / chunk_size) % 2) {
+            cc3xx_test_assert(hash_test_lowlevel_oneshot(data, alg) == 0);
+        }
+    }
+
+    cc3xx_lowlevel_hash_copy_state(&state_copy, &state_b);
+
+    cc3xx_lowlevel_hash_load_state(&state_a);
+    cc3xx_lowlevel_hash_finish(output, hash_size_from_alg(alg));
+    cc3xx_test_assert(memcmp(output, output_from_alg_and_data(alg, data),
+                             hash_size_from_alg(alg)) == 0);
+
+    cc3xx_lowlevel_hash_load_state(&state_b);
+    cc3xx_lowlevel_hash_finish(output, hash_size_from_alg(alg));
+    cc3xx_test_assert(memcmp(output, output_from_alg_and_data(alg, data),
+                             hash_size_from_alg(alg)) == 0);
+
+    cc3xx_lowlevel_hash_load_state(&state_copy);
+    cc3xx_lowlevel_hash_finish(output, hash_size_from_alg(alg));
+    cc3xx_test_assert(memcmp(output, output_from_alg_and_data(alg, data),
+                             hash_size_from_alg(alg)) == 0);
+
+    rc = 0;
+cleanup:
+    cc3xx_lowlevel_hash_discard_state(&state_a);
+    cc3xx_lowlevel_hash_discard_state(&state_b);
+    cc3xx_lowlevel_hash_uninit();
+
+    return rc;
+}
+
 int hash_test_lowlevel_reinit(struct hash_test_data_t *data,
                               cc3xx_hash_alg_t alg)
 {
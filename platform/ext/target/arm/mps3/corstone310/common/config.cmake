@@ -27,6 +27,12 @@ set(TFM_PXN_ENABLE                    ON    CACHE BOOL    "Use Privileged execut
 set(CONFIG_TFM_USE_TRUSTZONE          ON)
 set(TFM_MULTI_CORE_TOPOLOGY           OFF)
 
+# Known-answer tests for the Helium SHA-256 compression function of the
+# crypto service, run as part of the secure regression tests
+if(CRYPTO_MVE_ACCELERATION)
+    set(EXTRA_S_TEST_SUITE_PATH         "${CMAKE_CURRENT_LIST_DIR}/tests/secure" CACHE STRING "path to extra secure testsuite")
+endif()
+
 # Ethos-U NPU configurations
 set(ETHOSU_ARCH                       "U55"            CACHE STRING    "Ethos-U NPU type [U55,U65]")
 set(ETHOS_DRIVER_PATH                 "DOWNLOAD"       CACHE PATH      "Path to Ethos-U Core Driver (or DOWNLOAD to fetch automatically")
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "extra_s_tests.h"
+#include "psa/crypto.h"
+
+#define ARRAY_SIZE(arr) (sizeof(arr)/sizeof((arr)[0]))
+
+/*
+ * Known-answer tests for the Helium SHA-256 compression function used by the
+ * crypto service when CRYPTO_MVE_ACCELERATION is enabled. The generic crypto
+ * regression tests mostly check that the results round-trip, which a wrong but
+ * self-consistent block function would also pass.
+ */
+
+/* FIPS 180-2 appendix B.1 and B.2 */
+static const struct {
+    const char *msg;
+    uint8_t digest[32];
+} sha256_kat[] = {
+    {"abc",
+     {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+      0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+      0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+      0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad}},
+    {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+     {0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8,
+      0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+      0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67,
+      0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1}},
+};
+
+static void s_test_mve_sha256_kat(struct test_result_t *ret)
+{
+    uint8_t digest[32];
+    size_t digest_len;
+    psa_status_t status;
+
+    for (size_t idx = 0; idx < ARRAY_SIZE(sha256_kat); idx++) {
+        status = psa_hash_compute(PSA_ALG_SHA_256,
+                                  (const uint8_t *)sha256_kat[idx].msg,
+                                  strlen(sha256_kat[idx].msg),
+                                  digest, sizeof(digest), &digest_len);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("SHA-256 hash computation failed");
+            return;
+        }
+
+        if (digest_len != sizeof(digest) ||
+            memcmp(digest, sha256_kat[idx].digest, sizeof(digest)) != 0) {
+            TEST_FAIL("SHA-256 digest doesn't match the known answer");
+            return;
+        }
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+static struct test_t plat_s_t[] = {
+    {&s_test_mve_sha256_kat, "TFM_S_EXTRA_TEST_1001",
+     "Extra Secure test: MVE SHA-256 known-answer test"},
+};
+
+void register_testsuite_extra_s_interface(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size = ARRAY_SIZE(plat_s_t);
+
+    set_testsuite("Extra Secure interface tests"
+                  "(TFM_S_EXTRA_TEST_1XXX)",
+                  plat_s_t, list_size, p_test_suite);
+}
@@ -99,10 +99,11 @@ enum tfm_plat_err_t boot_dma_init_cfg(void)
     return TFM_PLAT_ERR_SUCCESS;
 }
 
-int32_t boot_dma_memcpy(uint32_t src_addr,
-                        uint32_t dest_addr,
-                        uint32_t size,
-                        uint32_t ch_idx)
+static int32_t boot_dma_memcpy_exec(uint32_t src_addr,
+                                    uint32_t dest_addr,
+                                    uint32_t size,
+                                    uint32_t ch_idx,
+                                    enum dma350_lib_exec_type_t exec_type)
 {
     struct dma350_ch_dev_t *dma_ch_ptr;
     enum dma350_lib_error_t dma_config_ret_val =
@@ -119,7 +120,7 @@ int32_t boot_dma_memcpy(uint32_t src_addr,
                                        (void *)src_addr,
                                        (void *)dest_addr,
                                        size,
-                                       DMA350_LIB_EXEC_BLOCKING);
+                                       exec_type);
 
     if (dma_config_ret_val != 0) {
         BOOT_LOG_ERR("[DMA350 BL2] dma350_memcpy return value: 0x%x",
@@ -131,3 +132,39 @@ int32_t boot_dma_memcpy(uint32_t src_addr,
 
     return 0;
 }
+
+int32_t boot_dma_memcpy(uint32_t src_addr,
+                        uint32_t dest_addr,
+                        uint32_t size,
+                        uint32_t ch_idx)
+{
+    return boot_dma_memcpy_exec(src_addr, dest_addr, size, ch_idx,
+                                DMA350_LIB_EXEC_BLOCKING);
+}
+
+int32_t boot_dma_memcpy_start(uint32_t src_addr,
+                              uint32_t dest_addr,
+                              uint32_t size,
+                              uint32_t ch_idx)
+{
+    return boot_dma_memcpy_exec(src_addr, dest_addr, size, ch_idx,
+                                DMA350_LIB_EXEC_START_ONLY);
+}
+
+int32_t boot_dma_wait(uint32_t ch_idx)
+{
+    union dma350_ch_status_t status;
+
+    if (ch_idx >= BOOT_DMA_NUM_CHANNELS) {
+        return -1;
+    }
+
+    status = dma350_ch_wait_status(dma350_channel_list[ch_idx]);
+    if (!status.b.STAT_DONE || status.b.STAT_ERR) {
+        BOOT_LOG_ERR("[DMA350 BL2] dma channel %u failed, status 0x%x",
+                     ch_idx, status.w);
+        return -1;
+    }
+
+    return 0;
+}
@@ -31,6 +31,37 @@ int32_t boot_dma_memcpy(uint32_t src_addr,
                         uint32_t size,
                         uint32_t channel_idx);
 
+/*!
+ * \brief Starts a DMA memory copy and returns without waiting for it to
+ *        complete.
+ *
+ * \param[in] src_addr      Source address of the data to be copied.
+ * \param[in] dest_addr     Destination address of the data to be copied.
+ * \param[in] size          Size of the data to be copied in bytes copied.
+ * \param[in] channel_idx   DMA channel index to be used for copy service.
+ *
+ * \note The destination must not be accessed until \ref boot_dma_wait has
+ *       returned for the same channel.
+ *
+ * \return Returns 0 on success else -1
+ *
+ */
+int32_t boot_dma_memcpy_start(uint32_t src_addr,
+                              uint32_t dest_addr,
+                              uint32_t size,
+                              uint32_t channel_idx);
+
+/*!
+ * \brief Waits for the copy started by \ref boot_dma_memcpy_start on a channel
+ *        to complete.
+ *
+ * \param[in] channel_idx   DMA channel index the copy was started on.
+ *
+ * \return Returns 0 if the copy completed successfully else -1
+ *
+ */
+int32_t boot_dma_wait(uint32_t channel_idx);
+
 /**
  * \brief Initialise the DMA devices and channels.
  *
@@ -217,6 +217,7 @@ set(PLATFORM_DEFAULT_ATTEST_HAL         OFF        CACHE BOOL     "Use default a
 set(PLATFORM_DEFAULT_SYSTEM_RESET_HALT  OFF        CACHE BOOL     "Use default system reset/halt implementation")
 set(PLATFORM_HAS_BOOT_DMA               ON         CACHE BOOL     "Enable dma support for memory transactions for bootloader")
 set(PLATFORM_BOOT_DMA_MIN_SIZE_REQ      0x40       CACHE STRING   "Minimum transaction size (in bytes) required to enable dma support for bootloader")
+set(PLATFORM_BOOT_DMA_READ_AHEAD_SIZE   0          CACHE STRING   "Size (in bytes) of each of the two buffers used to read flash ahead of the bootloader with dma, 0 to disable")
 set(PLATFORM_SVC_HANDLERS               ON         CACHE BOOL     "Platform supports custom SVC handlers")
 set(PLATFORM_ERROR_CODES                ON         CACHE BOOL     "Whether to use platform-specific error codes.")
 
@@ -71,6 +71,19 @@
  */
 /* #define CC3XX_CONFIG_DMA_WFI_WAIT_ENABLE */
 
+/* Whether DMA transfers can be left running while the CPU continues, with
+ * completion signalled through cc3xx_lowlevel_dma_irq_handler(). Only used once
+ * cc3xx_lowlevel_dma_set_async() has been called.
+ */
+/* #define CC3XX_CONFIG_DMA_ASYNC_ENABLE */
+
+/* Whether the context of a multipart operation is left loaded in the engine
+ * between calls, and only written back when another user needs the engine.
+ * Not supported at runtime: each update is a separate request, and the engine
+ * is shared with partitions which can't write the contexts back.
+ */
+/* #define CC3XX_CONFIG_ENGINE_AFFINITY_ENABLE */
+
 /* How many DMA remap regions are available */
 #ifndef CC3XX_CONFIG_DMA_REMAP_REGION_AM
 #define CC3XX_CONFIG_DMA_REMAP_REGION_AM 4
@@ -126,6 +139,23 @@
 #define CC3XX_CONFIG_RNG_RING_OSCILLATOR_ID 0
 #endif /* !CC_RNG_RING_OSCILLATOR_ID */
 
+/* Whether TRNG output is collected ahead of time into a health-tested pool, so
+ * that seeding and reseeding is served from memory. The pool is topped up by
+ * calling cc3xx_lowlevel_rng_refill_entropy_pool() outside the hot path, which
+ * the crypto partition does at the end of each request.
+ */
+#define CC3XX_CONFIG_RNG_ENTROPY_POOL_ENABLE
+
+/* Size in bytes of the entropy pool, a multiple of the 24 byte EHR size */
+#ifndef CC3XX_CONFIG_RNG_ENTROPY_POOL_SIZE
+#define CC3XX_CONFIG_RNG_ENTROPY_POOL_SIZE 96
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_SIZE */
+
+/* Amount of pooled entropy in bytes below which the pool asks for a refill */
+#ifndef CC3XX_CONFIG_RNG_ENTROPY_POOL_LOW_WATER_MARK
+#define CC3XX_CONFIG_RNG_ENTROPY_POOL_LOW_WATER_MARK 48
+#endif /* CC3XX_CONFIG_RNG_ENTROPY_POOL_LOW_WATER_MARK */
+
 /* How many virtual registers can be allocated in the PKA engine */
 #ifndef CC3XX_CONFIG_PKA_MAX_VIRT_REG_AMOUNT
 #define CC3XX_CONFIG_PKA_MAX_VIRT_REG_AMOUNT 64
@@ -147,6 +177,18 @@
  */
 #define CC3XX_CONFIG_PKA_ALIGN_FOR_PERFORMANCE
 
+/* Whether running out of physical PKA registers evicts the mapping of a freed
+ * or least recently used virtual register, instead of failing an assertion.
+ * Callers then don't need to unmap all registers to keep loops with many live
+ * values working.
+ */
+/* #define CC3XX_CONFIG_PKA_LRU_EVICTION_ENABLE */
+
+/* Whether counters of physical PKA register maps, evictions and flushes are
+ * kept, for profiling register pressure.
+ */
+/* #define CC3XX_CONFIG_PKA_STATS_ENABLE */
+
 /* Whether various EC curve types are enabled */
 #define CC3XX_CONFIG_EC_CURVE_TYPE_WEIERSTRASS_ENABLE
 /* #define CC3XX_CONFIG_EC_CURVE_TYPE_MONTGOMERY_ENABLE */
@@ -185,6 +227,23 @@
  */
 #define CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE
 
+/* Whether the Shamir trick will recode the scalars in joint sparse form, which
+ * needs a point addition for half of the scalar bits instead of three quarters.
+ * This is variable-time, so it is only used for verification. Needs
+ * CC3XX_CONFIG_EC_SHAMIR_TRICK_ENABLE, and uses about 1KiB more stack for the
+ * largest enabled curve.
+ */
+/* #define CC3XX_CONFIG_EC_SHAMIR_TRICK_JSF_ENABLE */
+
+/* Whether multiplication of the curve generator, as done for ECDSA signing and
+ * key generation, will use a precomputed comb table in flash for the curves
+ * that have one (secp256r1 and secp384r1). This roughly halves the number of
+ * point operations. The scalar is still blinded for DPA, but isn't split, as
+ * the accumulator is already randomized. Has a code-size penalty of 1KiB of
+ * table data for secp256r1 and 1.5KiB for secp384r1.
+ */
+/* #define CC3XX_CONFIG_EC_FIXED_BASE_COMB_ENABLE */
+
 /* Whether various ECDSA features are enabled */
 #define CC3XX_CONFIG_ECDSA_SIGN_ENABLE
 #define CC3XX_CONFIG_ECDSA_VERIFY_ENABLE
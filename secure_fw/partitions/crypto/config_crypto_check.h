@@ -10,6 +10,14 @@
 
 #include "config_tfm.h"
 
+/* Total number of contexts available, in the shared and dedicated pools */
+#define TFM_CRYPTO_TOTAL_OPER_NUM (CRYPTO_CONC_OPER_NUM +              \
+                                   CRYPTO_CONC_CIPHER_OPER_NUM +       \
+                                   CRYPTO_CONC_MAC_OPER_NUM +          \
+                                   CRYPTO_CONC_HASH_OPER_NUM +         \
+                                   CRYPTO_CONC_KEY_DERIV_OPER_NUM +    \
+                                   CRYPTO_CONC_AEAD_OPER_NUM)
+
 /* Check invalid configs. */
 #if CRYPTO_NV_SEED && CRYPTO_EXT_RNG
 #error "Invalid config: CRYPTO_NV_SEED AND CRYPTO_EXT_RNG!"
@@ -19,4 +27,21 @@
 #error "Invalid config: NOT CRYPTO_NV_SEED AND NOT CRYPTO_EXT_RNG!"
 #endif
 
+#if (CRYPTO_CONC_OPER_NUM < 1) || (CRYPTO_CONC_OPER_NUM > 255)
+#error "Invalid config: CRYPTO_CONC_OPER_NUM must be between 1 and 255!"
+#endif
+
+#if (CRYPTO_CONC_CIPHER_OPER_NUM > 255) || (CRYPTO_CONC_MAC_OPER_NUM > 255) || \
+    (CRYPTO_CONC_HASH_OPER_NUM > 255) || (CRYPTO_CONC_AEAD_OPER_NUM > 255) || \
+    (CRYPTO_CONC_KEY_DERIV_OPER_NUM > 255)
+#error "Invalid config: dedicated pools must hold at most 255 operations!"
+#endif
+
+#if (CRYPTO_CONC_OPER_NUM_PER_PARTITION < 0) || \
+    (CRYPTO_CONC_OPER_NUM_PER_PARTITION > 255) || \
+    (CRYPTO_CONC_OPER_NUM_PER_NS_CLIENT < 0) || \
+    (CRYPTO_CONC_OPER_NUM_PER_NS_CLIENT > 255)
+#error "Invalid config: per owner quota must be between 0 and 255!"
+#endif
+
 #endif /* __CONFIG_PARTITION_CRYPTO_H__ */
@@ -1,19 +1,23 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
 
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
 #include "config_tfm.h"
+#include "config_crypto_check.h"
 #include "tfm_mbedcrypto_include.h"
 
 #include "tfm_crypto_api.h"
 #include "tfm_crypto_defs.h"
+#include "tfm_sp_log.h"
 
 /**
  * \brief Define miscellaneous literal constants that are used in the service
@@ -29,39 +33,282 @@ enum {
 #define TFM_CRYPTO_INVALID_HANDLE (0x0u)
 
 /**
- * \brief A type describing the context stored in Secure memory by the TF-M Crypto
- *        service to support multipart calls on secure side
+ * \brief A handle is made of the slot index plus one in the lowest bits, so
+ *        that a handle is never equal to TFM_CRYPTO_INVALID_HANDLE, of the
+ *        index of the pool the slot belongs to, and of the generation of the
+ *        slot in the remaining bits. The generation is bumped at each release
+ *        so that stale handles are never resolved to a slot which has been
+ *        allocated again in the meantime.
  */
-struct tfm_crypto_operation_s {
+#define TFM_CRYPTO_HANDLE_INDEX_BITS  (8u)
+#define TFM_CRYPTO_HANDLE_INDEX_MASK  ((1u << TFM_CRYPTO_HANDLE_INDEX_BITS) - 1)
+#define TFM_CRYPTO_HANDLE_POOL_BITS   (4u)
+#define TFM_CRYPTO_HANDLE_POOL_MASK   ((1u << TFM_CRYPTO_HANDLE_POOL_BITS) - 1)
+#define TFM_CRYPTO_HANDLE_GEN_SHIFT   (TFM_CRYPTO_HANDLE_INDEX_BITS + \
+                                       TFM_CRYPTO_HANDLE_POOL_BITS)
+#define TFM_CRYPTO_HANDLE_GEN_MASK    (UINT32_MAX >> TFM_CRYPTO_HANDLE_GEN_SHIFT)
+
+#define TFM_CRYPTO_HANDLE(pool, index, gen) \
+    ((((gen) & TFM_CRYPTO_HANDLE_GEN_MASK) << TFM_CRYPTO_HANDLE_GEN_SHIFT) | \
+     ((pool) << TFM_CRYPTO_HANDLE_INDEX_BITS) | ((index) + 1u))
+#define TFM_CRYPTO_HANDLE_INDEX(handle) \
+    (((handle) & TFM_CRYPTO_HANDLE_INDEX_MASK) - 1u)
+#define TFM_CRYPTO_HANDLE_POOL(handle) \
+    (((handle) >> TFM_CRYPTO_HANDLE_INDEX_BITS) & TFM_CRYPTO_HANDLE_POOL_MASK)
+#define TFM_CRYPTO_HANDLE_GEN(handle) \
+    ((handle) >> TFM_CRYPTO_HANDLE_GEN_SHIFT)
+
+/**
+ * \brief Marks the end of the free list
+ */
+#define TFM_CRYPTO_FREE_LIST_END (UINT8_MAX)
+
+/**
+ * \brief A type which can hold the context of any operation, used by the
+ *        shared pool
+ */
+union tfm_crypto_operation_u {
+    psa_cipher_operation_t cipher;    /*!< Cipher operation context */
+    psa_mac_operation_t mac;          /*!< MAC operation context */
+    psa_hash_operation_t hash;        /*!< Hash operation context */
+    psa_key_derivation_operation_t key_deriv; /*!< Key derivation operation context */
+    psa_aead_operation_t aead;        /*!< AEAD operation context */
+};
+
+/**
+ * \brief A type describing the bookkeeping of a context stored in Secure
+ *        memory by the TF-M Crypto service to support multipart calls on
+ *        secure side
+ */
+struct tfm_crypto_slot_s {
     uint32_t in_use;                /*!< Indicates if the operation is in use */
     int32_t owner;                  /*!< Indicates an ID of the owner of
                                      *   the context
                                      */
     enum tfm_crypto_operation_type type; /*!< Type of the operation */
-    union {
-        psa_cipher_operation_t cipher;    /*!< Cipher operation context */
-        psa_mac_operation_t mac;          /*!< MAC operation context */
-        psa_hash_operation_t hash;        /*!< Hash operation context */
-        psa_key_derivation_operation_t key_deriv; /*!< Key derivation operation context */
-        psa_aead_operation_t aead;        /*!< AEAD operation context */
-    } operation;
+    uint32_t generation;            /*!< Generation tag of the handle */
+    uint8_t next_free;              /*!< Next slot in the free list */
 };
 
-static struct tfm_crypto_operation_s operations[CRYPTO_CONC_OPER_NUM] = {{0}};
+/**
+ * \brief A pool of contexts of a given size. The shared pool holds contexts
+ *        of any type, each sized for the largest one, while the dedicated
+ *        pools only hold contexts of their own type, so that a platform can
+ *        have many concurrent operations with small contexts (e.g. hash)
+ *        without paying for the largest context in each of them.
+ */
+struct tfm_crypto_pool_s {
+    enum tfm_crypto_operation_type type; /*!< Type served, NONE for shared */
+    struct tfm_crypto_slot_s *slots;     /*!< Bookkeeping of the contexts */
+    uint8_t *ctxs;                       /*!< Storage of the contexts */
+    size_t ctx_size;                     /*!< Size of a single context */
+    uint8_t num;                         /*!< Number of contexts */
+    uint8_t free_head;                   /*!< Head of the free list */
+};
+
+#define TFM_CRYPTO_POOL_STORAGE(name, ctx_type, count)  \
+    static struct tfm_crypto_slot_s name##_slots[count]; \
+    static ctx_type name##_ctxs[count]
+
+#define TFM_CRYPTO_POOL(name, oper_type, count)                         \
+    {                                                                   \
+        .type = oper_type,                                              \
+        .slots = name##_slots,                                          \
+        .ctxs = (uint8_t *)name##_ctxs,                                 \
+        .ctx_size = sizeof(name##_ctxs[0]),                             \
+        .num = count,                                                   \
+        .free_head = TFM_CRYPTO_FREE_LIST_END,                          \
+    }
+
+TFM_CRYPTO_POOL_STORAGE(shared, union tfm_crypto_operation_u,
+                        CRYPTO_CONC_OPER_NUM);
+#if CRYPTO_CONC_CIPHER_OPER_NUM > 0
+TFM_CRYPTO_POOL_STORAGE(cipher, psa_cipher_operation_t,
+                        CRYPTO_CONC_CIPHER_OPER_NUM);
+#endif
+#if CRYPTO_CONC_MAC_OPER_NUM > 0
+TFM_CRYPTO_POOL_STORAGE(mac, psa_mac_operation_t, CRYPTO_CONC_MAC_OPER_NUM);
+#endif
+#if CRYPTO_CONC_HASH_OPER_NUM > 0
+TFM_CRYPTO_POOL_STORAGE(hash, psa_hash_operation_t, CRYPTO_CONC_HASH_OPER_NUM);
+#endif
+#if CRYPTO_CONC_KEY_DERIV_OPER_NUM > 0
+TFM_CRYPTO_POOL_STORAGE(key_deriv, psa_key_derivation_operation_t,
+                        CRYPTO_CONC_KEY_DERIV_OPER_NUM);
+#endif
+#if CRYPTO_CONC_AEAD_OPER_NUM > 0
+TFM_CRYPTO_POOL_STORAGE(aead, psa_aead_operation_t, CRYPTO_CONC_AEAD_OPER_NUM);
+#endif
+
+/**
+ * \brief The pools of contexts. The shared pool must stay the first one, as
+ *        it's the fallback when the dedicated pool of a type is exhausted.
+ */
+static struct tfm_crypto_pool_s pools[] = {
+    TFM_CRYPTO_POOL(shared, TFM_CRYPTO_OPERATION_NONE, CRYPTO_CONC_OPER_NUM),
+#if CRYPTO_CONC_CIPHER_OPER_NUM > 0
+    TFM_CRYPTO_POOL(cipher, TFM_CRYPTO_CIPHER_OPERATION,
+                    CRYPTO_CONC_CIPHER_OPER_NUM),
+#endif
+#if CRYPTO_CONC_MAC_OPER_NUM > 0
+    TFM_CRYPTO_POOL(mac, TFM_CRYPTO_MAC_OPERATION, CRYPTO_CONC_MAC_OPER_NUM),
+#endif
+#if CRYPTO_CONC_HASH_OPER_NUM > 0
+    TFM_CRYPTO_POOL(hash, TFM_CRYPTO_HASH_OPERATION, CRYPTO_CONC_HASH_OPER_NUM),
+#endif
+#if CRYPTO_CONC_KEY_DERIV_OPER_NUM > 0
+    TFM_CRYPTO_POOL(key_deriv, TFM_CRYPTO_KEY_DERIVATION_OPERATION,
+                    CRYPTO_CONC_KEY_DERIV_OPER_NUM),
+#endif
+#if CRYPTO_CONC_AEAD_OPER_NUM > 0
+    TFM_CRYPTO_POOL(aead, TFM_CRYPTO_AEAD_OPERATION, CRYPTO_CONC_AEAD_OPER_NUM),
+#endif
+};
+
+#define TFM_CRYPTO_POOL_NUM (sizeof(pools) / sizeof(pools[0]))
+
+/**
+ * \brief Usage counters of the operation contexts held by a single owner
+ */
+struct tfm_crypto_owner_stats_s {
+    int32_t owner;           /*!< ID of the owner */
+    uint16_t in_use;         /*!< Number of contexts currently held */
+    uint16_t peak;           /*!< Maximum number of contexts held at once */
+    uint32_t alloc_failures; /*!< Number of rejected allocations */
+};
+
+/**
+ * \brief Usage counters of the operation contexts of the Alloc module
+ */
+struct tfm_crypto_alloc_stats_s {
+    uint32_t in_use;         /*!< Number of contexts currently allocated */
+    uint32_t peak;           /*!< Maximum number of contexts allocated at once */
+    uint32_t alloc_failures; /*!< Number of rejected allocations */
+};
+
+/**
+ * \brief Usage counters of the owners which currently hold operations, or
+ *        held them recently. There can't be more owners holding operations
+ *        than there are operations.
+ */
+static struct tfm_crypto_owner_stats_s owner_stats[TFM_CRYPTO_TOTAL_OPER_NUM];
+
+static struct tfm_crypto_alloc_stats_s alloc_stats;
+
+static inline void *pool_ctx(const struct tfm_crypto_pool_s *pool, uint32_t index)
+{
+    return (void *)&pool->ctxs[index * pool->ctx_size];
+}
 
 /*
- * \brief Function used to clear the memory associated to a backend context
+ * \brief Resolves a handle to the slot it refers to
  *
- * \param[in] index Numerical index in the database of the backend contexts
+ * \param[in]  handle Handle to resolve
+ * \param[out] pool   Pool the slot belongs to
+ * \param[out] index  Index of the slot in the pool
  *
- * \return None
+ * \return true if the handle refers to an in use slot of its generation
  *
  */
-static void memset_operation_context(uint32_t index)
+static bool handle_to_slot(uint32_t handle, struct tfm_crypto_pool_s **pool,
+                           uint32_t *index)
 {
-    /* Clear the contents of the backend context */
-    (void)memset((uint8_t *)&(operations[index].operation), 0,
-                 sizeof(operations[index].operation));
+    uint32_t p, i;
+
+    if (handle == TFM_CRYPTO_INVALID_HANDLE) {
+        return false;
+    }
+
+    p = TFM_CRYPTO_HANDLE_POOL(handle);
+    i = TFM_CRYPTO_HANDLE_INDEX(handle);
+    if ((p >= TFM_CRYPTO_POOL_NUM) || (i >= pools[p].num)) {
+        return false;
+    }
+
+    if ((pools[p].slots[i].in_use != TFM_CRYPTO_IN_USE) ||
+        (pools[p].slots[i].generation != TFM_CRYPTO_HANDLE_GEN(handle))) {
+        return false;
+    }
+
+    *pool = &pools[p];
+    *index = i;
+    return true;
+}
+
+/*
+ * \brief Selects the pool to allocate a context of a given type from: the
+ *        dedicated pool of the type if it has free contexts, otherwise the
+ *        shared pool.
+ *
+ * \param[in] type Type of the operation context to allocate
+ *
+ * \return Index of the pool in \ref pools
+ *
+ */
+static uint32_t select_pool(enum tfm_crypto_operation_type type)
+{
+    uint32_t p;
+
+    for (p = 1; p < TFM_CRYPTO_POOL_NUM; p++) {
+        if ((pools[p].type == type) &&
+            (pools[p].free_head != TFM_CRYPTO_FREE_LIST_END)) {
+            return p;
+        }
+    }
+
+    return 0;
+}
+
+static bool owner_stats_is_tracked(const struct tfm_crypto_owner_stats_s *stats)
+{
+    return (stats->in_use != 0) || (stats->peak != 0) ||
+           (stats->alloc_failures != 0);
+}
+
+/*
+ * \brief Finds the usage counters of an owner, taking over the entry of an
+ *        owner which doesn't hold any operation if the owner isn't tracked yet
+ *
+ * \param[in] owner ID of the owner
+ *
+ * \return Pointer to the counters, or NULL if all entries are busy
+ *
+ */
+static struct tfm_crypto_owner_stats_s *get_owner_stats(int32_t owner)
+{
+    struct tfm_crypto_owner_stats_s *idle = NULL;
+    uint32_t i;
+
+    for (i = 0; i < TFM_CRYPTO_TOTAL_OPER_NUM; i++) {
+        if (owner_stats_is_tracked(&owner_stats[i])) {
+            if (owner_stats[i].owner == owner) {
+                return &owner_stats[i];
+            }
+            /* Prefer never used entries, to keep the history of the others */
+            if ((owner_stats[i].in_use == 0) && (idle == NULL)) {
+                idle = &owner_stats[i];
+            }
+        } else if ((idle == NULL) || owner_stats_is_tracked(idle)) {
+            idle = &owner_stats[i];
+        }
+    }
+
+    if (idle != NULL) {
+        (void)memset(idle, 0, sizeof(*idle));
+        idle->owner = owner;
+    }
+
+    return idle;
+}
+
+static uint32_t owner_quota(int32_t owner)
+{
+    /* Negative client IDs are assigned to NS clients */
+    uint32_t quota = (owner < 0) ? CRYPTO_CONC_OPER_NUM_PER_NS_CLIENT
+                                 : CRYPTO_CONC_OPER_NUM_PER_PARTITION;
+
+    /* 0 lets an owner hold all the contexts of the pools */
+    return (quota == 0) ? TFM_CRYPTO_TOTAL_OPER_NUM : quota;
 }
 
 /*!
@@ -73,8 +320,24 @@ static void memset_operation_context(uint32_t index)
 /*!@{*/
 psa_status_t tfm_crypto_init_alloc(void)
 {
-    /* Clear the contents of the local contexts */
-    (void)memset(operations, 0, sizeof(operations));
+    uint32_t p, i;
+
+    (void)memset(owner_stats, 0, sizeof(owner_stats));
+    (void)memset(&alloc_stats, 0, sizeof(alloc_stats));
+
+    for (p = 0; p < TFM_CRYPTO_POOL_NUM; p++) {
+        /* Clear the contents of the local contexts */
+        (void)memset(pools[p].slots, 0, pools[p].num * sizeof(pools[p].slots[0]));
+        (void)memset(pools[p].ctxs, 0, pools[p].num * pools[p].ctx_size);
+
+        /* Chain all the slots in the free list */
+        for (i = 0; i < pools[p].num; i++) {
+            pools[p].slots[i].next_free = (i + 1 < pools[p].num) ?
+                                   (uint8_t)(i + 1) : TFM_CRYPTO_FREE_LIST_END;
+        }
+        pools[p].free_head = (pools[p].num > 0) ? 0 : TFM_CRYPTO_FREE_LIST_END;
+    }
+
     return PSA_SUCCESS;
 }
 
@@ -85,6 +348,9 @@ psa_status_t tfm_crypto_operation_alloc(enum tfm_crypto_operation_type type,
     uint32_t i = 0;
     int32_t partition_id = 0;
     psa_status_t status;
+    struct tfm_crypto_owner_stats_s *stats;
+    struct tfm_crypto_pool_s *pool;
+    struct tfm_crypto_slot_s *slot;
 
     /* Handle must be initialised before calling a setup function */
     if (*handle != TFM_CRYPTO_INVALID_HANDLE) {
@@ -102,62 +368,108 @@ psa_status_t tfm_crypto_operation_alloc(enum tfm_crypto_operation_type type,
         return status;
     }
 
-    for (i = 0; i < CRYPTO_CONC_OPER_NUM; i++) {
-        if (operations[i].in_use == TFM_CRYPTO_NOT_IN_USE) {
-            operations[i].in_use = TFM_CRYPTO_IN_USE;
-            operations[i].owner = partition_id;
-            operations[i].type = type;
-            *handle = i + 1;
-            *ctx = (void *) &(operations[i].operation);
-            return PSA_SUCCESS;
+    stats = get_owner_stats(partition_id);
+    pool = &pools[select_pool(type)];
+
+    if ((pool->free_head == TFM_CRYPTO_FREE_LIST_END) || (stats == NULL) ||
+        (stats->in_use >= owner_quota(partition_id))) {
+        alloc_stats.alloc_failures++;
+        if (stats != NULL) {
+            stats->alloc_failures++;
+            LOG_DBGFMT("[DBG][Crypto] Alloc failed for owner %" PRId32 ": "
+                       "%" PRIu32 " in use, peak %" PRIu32 ", "
+                       "%" PRIu32 " failures\r\n", partition_id,
+                       (uint32_t)stats->in_use, (uint32_t)stats->peak,
+                       stats->alloc_failures);
         }
+        LOG_DBGFMT("[DBG][Crypto] Contexts: %" PRIu32 " in use, "
+                   "peak %" PRIu32 ", %" PRIu32 " failures\r\n",
+                   alloc_stats.in_use, alloc_stats.peak,
+                   alloc_stats.alloc_failures);
+        return PSA_ERROR_NOT_PERMITTED;
     }
 
-    return PSA_ERROR_NOT_PERMITTED;
+    /* Pop the first slot from the free list */
+    i = pool->free_head;
+    slot = &pool->slots[i];
+    pool->free_head = slot->next_free;
+
+    slot->in_use = TFM_CRYPTO_IN_USE;
+    slot->owner = partition_id;
+    slot->type = type;
+    slot->next_free = TFM_CRYPTO_FREE_LIST_END;
+    *handle = TFM_CRYPTO_HANDLE((uint32_t)(pool - pools), i, slot->generation);
+    *ctx = pool_ctx(pool, i);
+
+    stats->in_use++;
+    if (stats->in_use > stats->peak) {
+        stats->peak = stats->in_use;
+    }
+    alloc_stats.in_use++;
+    if (alloc_stats.in_use > alloc_stats.peak) {
+        alloc_stats.peak = alloc_stats.in_use;
+    }
+
+    return PSA_SUCCESS;
 }
 
 psa_status_t tfm_crypto_operation_release(uint32_t *handle)
 {
     uint32_t h_val = *handle;
+    uint32_t i;
     int32_t partition_id = 0;
     psa_status_t status;
+    struct tfm_crypto_owner_stats_s *stats;
+    struct tfm_crypto_pool_s *pool;
+    struct tfm_crypto_slot_s *slot;
 
     /* Handle shall be cleaned up always at first */
     *handle = TFM_CRYPTO_INVALID_HANDLE;
 
-    if ((h_val == TFM_CRYPTO_INVALID_HANDLE) ||
-        (h_val > CRYPTO_CONC_OPER_NUM)) {
+    if (!handle_to_slot(h_val, &pool, &i)) {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
+    slot = &pool->slots[i];
 
     status = tfm_crypto_get_caller_id(&partition_id);
     if (status != PSA_SUCCESS) {
         return status;
     }
 
-    if ((operations[h_val - 1].in_use == TFM_CRYPTO_IN_USE) &&
-        (operations[h_val - 1].owner == partition_id)) {
+    if (slot->owner != partition_id) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Clear the contents of the backend context */
+    (void)memset(pool_ctx(pool, i), 0, pool->ctx_size);
+    slot->in_use = TFM_CRYPTO_NOT_IN_USE;
+    slot->type = TFM_CRYPTO_OPERATION_NONE;
+    slot->owner = 0;
+    slot->generation = (slot->generation + 1) & TFM_CRYPTO_HANDLE_GEN_MASK;
 
-        memset_operation_context(h_val - 1);
-        operations[h_val - 1].in_use = TFM_CRYPTO_NOT_IN_USE;
-        operations[h_val - 1].type = TFM_CRYPTO_OPERATION_NONE;
-        operations[h_val - 1].owner = 0;
+    /* Push the slot back on the free list */
+    slot->next_free = pool->free_head;
+    pool->free_head = (uint8_t)i;
 
-        return PSA_SUCCESS;
+    stats = get_owner_stats(partition_id);
+    if ((stats != NULL) && (stats->in_use > 0)) {
+        stats->in_use--;
     }
+    alloc_stats.in_use--;
 
-    return PSA_ERROR_INVALID_ARGUMENT;
+    return PSA_SUCCESS;
 }
 
 psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
                                          uint32_t handle,
                                          void **ctx)
 {
+    uint32_t i;
     int32_t partition_id = 0;
     psa_status_t status;
+    struct tfm_crypto_pool_s *pool;
 
-    if ((handle == TFM_CRYPTO_INVALID_HANDLE) ||
-        (handle > CRYPTO_CONC_OPER_NUM)) {
+    if (handle == TFM_CRYPTO_INVALID_HANDLE) {
         return PSA_ERROR_BAD_STATE;
     }
 
@@ -170,10 +482,10 @@ psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
         return status;
     }
 
-    if ((operations[handle - 1].in_use == TFM_CRYPTO_IN_USE) &&
-        (operations[handle - 1].type == type) &&
-        (operations[handle - 1].owner == partition_id)) {
-        *ctx = (void *) &(operations[handle - 1].operation);
+    if (handle_to_slot(handle, &pool, &i) &&
+        (pool->slots[i].type == type) &&
+        (pool->slots[i].owner == partition_id)) {
+        *ctx = pool_ctx(pool, i);
         return PSA_SUCCESS;
     }
 
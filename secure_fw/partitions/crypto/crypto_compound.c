@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2024, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "config_tfm.h"
+#include "tfm_mbedcrypto_include.h"
+#include "tfm_crypto_api.h"
+#include "tfm_crypto_key.h"
+#include "tfm_crypto_defs.h"
+
+#include "crypto_library.h"
+
+/*!
+ * \addtogroup tfm_crypto_api_shim_layer
+ *
+ */
+
+/*!@{*/
+#if CRYPTO_COMPOUND_MODULE_ENABLED
+/**
+ * \brief Result of a step, either a slice of the intermediate buffer or the
+ *        caller output for the last step, or a volatile key
+ */
+struct compound_result {
+    const uint8_t *data;
+    size_t length;
+    bool has_key;
+    tfm_crypto_library_key_id_t key;
+};
+
+/**
+ * \brief Buffer holding the outputs of the intermediate steps. They never
+ *        leave the partition and are wiped once the operation completes.
+ */
+static uint8_t compound_buf[CRYPTO_COMPOUND_BUFFER_SIZE];
+
+static bool step_produces_key(uint16_t op)
+{
+    return (op == TFM_CRYPTO_COMPOUND_OP_IMPORT_KEY) ||
+           (op == TFM_CRYPTO_COMPOUND_OP_DERIVE_KEY);
+}
+
+static bool step_produces_data(uint16_t op)
+{
+    return (op == TFM_CRYPTO_COMPOUND_OP_HASH_COMPUTE) ||
+           (op == TFM_CRYPTO_COMPOUND_OP_MAC_COMPUTE) ||
+           (op == TFM_CRYPTO_COMPOUND_OP_SIGN_HASH) ||
+           (op == TFM_CRYPTO_COMPOUND_OP_AEAD_ENCRYPT) ||
+           (op == TFM_CRYPTO_COMPOUND_OP_AEAD_DECRYPT);
+}
+
+/**
+ * \brief Checks the whole list of steps before running any of them, so that
+ *        a malformed list doesn't leave partial results behind
+ */
+static psa_status_t validate_steps(const struct tfm_crypto_compound_step *steps,
+                                   size_t step_count, size_t input_length)
+{
+    size_t i, j;
+
+    for (i = 0; i < step_count; i++) {
+        if (!step_produces_key(steps[i].op) &&
+            !step_produces_data(steps[i].op) &&
+            (steps[i].op != TFM_CRYPTO_COMPOUND_OP_VERIFY_HASH)) {
+            return PSA_ERROR_NOT_SUPPORTED;
+        }
+
+        /* Steps producing keys are only useful to the steps which follow */
+        if (step_produces_key(steps[i].op) && (i == step_count - 1)) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        switch (steps[i].key_source) {
+        case TFM_CRYPTO_COMPOUND_SRC_NONE:
+            break;
+        case TFM_CRYPTO_COMPOUND_SRC_STEP:
+            if ((steps[i].key_step >= i) ||
+                !step_produces_key(steps[steps[i].key_step].op)) {
+                return PSA_ERROR_INVALID_ARGUMENT;
+            }
+            break;
+        default:
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        for (j = 0; j < TFM_CRYPTO_COMPOUND_MAX_REFS; j++) {
+            const struct tfm_crypto_compound_ref *ref = &steps[i].ref[j];
+
+            switch (ref->source) {
+            case TFM_CRYPTO_COMPOUND_SRC_NONE:
+                break;
+            case TFM_CRYPTO_COMPOUND_SRC_INPUT:
+                if (((size_t)ref->offset + ref->length) > input_length) {
+                    return PSA_ERROR_INVALID_ARGUMENT;
+                }
+                break;
+            case TFM_CRYPTO_COMPOUND_SRC_STEP:
+                if ((ref->step >= i) ||
+                    !step_produces_data(steps[ref->step].op)) {
+                    return PSA_ERROR_INVALID_ARGUMENT;
+                }
+                break;
+            default:
+                return PSA_ERROR_INVALID_ARGUMENT;
+            }
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+static void resolve_ref(const struct tfm_crypto_compound_ref *ref,
+                        const uint8_t *input,
+                        const struct compound_result results[],
+                        const uint8_t **data, size_t *length)
+{
+    switch (ref->source) {
+    case TFM_CRYPTO_COMPOUND_SRC_INPUT:
+        *data = input + ref->offset;
+        *length = ref->length;
+        break;
+    case TFM_CRYPTO_COMPOUND_SRC_STEP:
+        *data = results[ref->step].data;
+        *length = results[ref->step].length;
+        break;
+    default:
+        *data = NULL;
+        *length = 0;
+        break;
+    }
+}
+
+static psa_status_t run_step(const struct tfm_crypto_compound_step *step,
+                             const uint8_t *input,
+                             struct compound_result results[],
+                             struct compound_result *result,
+                             int32_t owner,
+                             uint8_t *out, size_t out_size)
+{
+    psa_status_t status;
+    const uint8_t *d[TFM_CRYPTO_COMPOUND_MAX_REFS];
+    size_t l[TFM_CRYPTO_COMPOUND_MAX_REFS];
+    size_t i;
+    tfm_crypto_library_key_id_t library_key;
+    psa_key_attributes_t key_attr = PSA_KEY_ATTRIBUTES_INIT;
+    psa_key_derivation_operation_t op = PSA_KEY_DERIVATION_OPERATION_INIT;
+
+    for (i = 0; i < TFM_CRYPTO_COMPOUND_MAX_REFS; i++) {
+        resolve_ref(&step->ref[i], input, results, &d[i], &l[i]);
+    }
+
+    if (step->key_source == TFM_CRYPTO_COMPOUND_SRC_STEP) {
+        library_key = results[step->key_step].key;
+    } else {
+        library_key = tfm_crypto_library_key_id_init(owner, step->key_id);
+    }
+
+    if (step_produces_key(step->op)) {
+        psa_set_key_type(&key_attr, step->key_type);
+        psa_set_key_bits(&key_attr, step->key_bits);
+        psa_set_key_usage_flags(&key_attr, step->key_usage);
+        psa_set_key_algorithm(&key_attr, step->key_alg);
+        psa_set_key_lifetime(&key_attr, PSA_KEY_LIFETIME_VOLATILE);
+        tfm_crypto_library_get_library_key_id_set_owner(owner, &key_attr);
+    }
+
+    result->data = out;
+    result->length = 0;
+
+    switch (step->op) {
+    case TFM_CRYPTO_COMPOUND_OP_HASH_COMPUTE:
+        return psa_hash_compute(step->alg, d[0], l[0],
+                                out, out_size, &result->length);
+    case TFM_CRYPTO_COMPOUND_OP_MAC_COMPUTE:
+        return psa_mac_compute(library_key, step->alg, d[0], l[0],
+                               out, out_size, &result->length);
+    case TFM_CRYPTO_COMPOUND_OP_SIGN_HASH:
+        return psa_sign_hash(library_key, step->alg, d[0], l[0],
+                             out, out_size, &result->length);
+    case TFM_CRYPTO_COMPOUND_OP_VERIFY_HASH:
+        return psa_verify_hash(library_key, step->alg, d[0], l[0],
+                               d[1], l[1]);
+    case TFM_CRYPTO_COMPOUND_OP_AEAD_ENCRYPT:
+        return psa_aead_encrypt(library_key, step->alg, d[0], l[0],
+                                d[1], l[1], d[2], l[2],
+                                out, out_size, &result->length);
+    case TFM_CRYPTO_COMPOUND_OP_AEAD_DECRYPT:
+        return psa_aead_decrypt(library_key, step->alg, d[0], l[0],
+                                d[1], l[1], d[2], l[2],
+                                out, out_size, &result->length);
+    case TFM_CRYPTO_COMPOUND_OP_IMPORT_KEY:
+        status = psa_import_key(&key_attr, d[0], l[0], &result->key);
+        result->has_key = (status == PSA_SUCCESS);
+        return status;
+    case TFM_CRYPTO_COMPOUND_OP_DERIVE_KEY:
+        status = psa_key_derivation_setup(&op, step->alg);
+        if (status == PSA_SUCCESS) {
+            status = psa_key_derivation_input_bytes(&op,
+                                                    PSA_KEY_DERIVATION_INPUT_SALT,
+                                                    d[0], l[0]);
+        }
+        if (status == PSA_SUCCESS) {
+            status = psa_key_derivation_input_key(&op,
+                                                  PSA_KEY_DERIVATION_INPUT_SECRET,
+                                                  library_key);
+        }
+        if (status == PSA_SUCCESS) {
+            status = psa_key_derivation_input_bytes(&op,
+                                                    PSA_KEY_DERIVATION_INPUT_INFO,
+                                                    d[1], l[1]);
+        }
+        if (status == PSA_SUCCESS) {
+            status = psa_key_derivation_output_key(&key_attr, &op,
+                                                   &result->key);
+            result->has_key = (status == PSA_SUCCESS);
+        }
+        (void)psa_key_derivation_abort(&op);
+        return status;
+    default:
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+}
+
+psa_status_t tfm_crypto_compound_interface(psa_invec in_vec[],
+                                           psa_outvec out_vec[],
+                                           struct tfm_crypto_key_id_s *encoded_key)
+{
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    struct tfm_crypto_compound_step steps[TFM_CRYPTO_COMPOUND_MAX_STEPS];
+    const uint8_t *input = in_vec[2].base;
+    size_t input_length = in_vec[2].len;
+    size_t step_count;
+    size_t buf_used = 0;
+    size_t i;
+    struct compound_result results[TFM_CRYPTO_COMPOUND_MAX_STEPS] = {0};
+    psa_status_t status = PSA_SUCCESS;
+
+    if (iov->function_id != TFM_CRYPTO_COMPOUND_EXECUTE_SID) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    if ((in_vec[1].base == NULL) ||
+        (in_vec[1].len % sizeof(struct tfm_crypto_compound_step) != 0)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    step_count = in_vec[1].len / sizeof(struct tfm_crypto_compound_step);
+    if ((step_count == 0) || (step_count > TFM_CRYPTO_COMPOUND_MAX_STEPS)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* With mapped iovecs the steps still live in client memory. Validate and
+     * run a private copy, so that they can't change once they've been checked.
+     */
+    (void)memcpy(steps, in_vec[1].base, in_vec[1].len);
+
+    status = validate_steps(steps, step_count, input_length);
+    if (status != PSA_SUCCESS) {
+        out_vec[0].len = 0;
+        return status;
+    }
+
+    for (i = 0; (i < step_count) && (status == PSA_SUCCESS); i++) {
+        if (i == step_count - 1) {
+            /* The last step writes straight into the caller output */
+            status = run_step(&steps[i], input, results, &results[i],
+                              encoded_key->owner,
+                              out_vec[0].base, out_vec[0].len);
+            out_vec[0].len = results[i].length;
+        } else {
+            status = run_step(&steps[i], input, results, &results[i],
+                              encoded_key->owner,
+                              &compound_buf[buf_used],
+                              sizeof(compound_buf) - buf_used);
+            buf_used += results[i].length;
+        }
+    }
+
+    if (status != PSA_SUCCESS) {
+        out_vec[0].len = 0;
+    }
+
+    /* Volatile keys and intermediate outputs never outlive the operation */
+    for (i = 0; i < step_count; i++) {
+        if (results[i].has_key) {
+            (void)psa_destroy_key(results[i].key);
+        }
+    }
+    (void)memset(compound_buf, 0, sizeof(compound_buf));
+
+    return status;
+}
+#else /* CRYPTO_COMPOUND_MODULE_ENABLED */
+psa_status_t tfm_crypto_compound_interface(psa_invec in_vec[],
+                                           psa_outvec out_vec[],
+                                           struct tfm_crypto_key_id_s *encoded_key)
+{
+    (void)in_vec;
+    (void)out_vec;
+    (void)encoded_key;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+#endif /* CRYPTO_COMPOUND_MODULE_ENABLED */
+/*!@}*/
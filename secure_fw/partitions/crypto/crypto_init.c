@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -88,8 +88,9 @@ static psa_status_t tfm_crypto_init_iovecs(const psa_msg_t *msg,
 }
 #else /* PSA_FRAMEWORK_HAS_MM_IOVEC == 1 */
 /**
- * \brief Internal scratch used for IOVec allocations
- *
+ * \brief Internal scratch used for IOVec allocations. Requests are serviced
+ *        synchronously, from the IOVecs being staged to the outputs being
+ *        written back, so a single one is enough
  */
 static struct tfm_crypto_scratch {
     __attribute__((__aligned__(TFM_CRYPTO_IOVEC_ALIGNMENT)))
@@ -133,10 +134,36 @@ static psa_status_t tfm_crypto_alloc_scratch(size_t requested_size, void **buf)
     return PSA_SUCCESS;
 }
 
-static void tfm_crypto_clear_scratch(void)
+/**
+ * \brief Wipes the bytes of the scratch which could have been written while
+ *        servicing the request, and resets it for the next one. Inputs are
+ *        wiped up to the length read from the client, outputs up to the size
+ *        allocated for them as the callee may have written anywhere in that
+ *        range. Alignment padding and unused space are never written hence
+ *        they are not touched.
+ */
+static void tfm_crypto_clear_scratch(const psa_msg_t *msg,
+                                     const psa_invec in_vec[],
+                                     size_t in_len,
+                                     const psa_outvec out_vec[],
+                                     size_t out_len)
 {
+    uint32_t i;
+
+    /* The first element is read when parsing, it never lives in the scratch */
+    for (i = 1; i < in_len; i++) {
+        if (in_vec[i].base != NULL) {
+            (void)memset((void *)in_vec[i].base, 0, in_vec[i].len);
+        }
+    }
+
+    for (i = 0; i < out_len; i++) {
+        if (out_vec[i].base != NULL) {
+            (void)memset(out_vec[i].base, 0, msg->out_size[i]);
+        }
+    }
+
     scratch.owner = 0;
-    (void)memset(scratch.buf, 0, scratch.alloc_index);
     scratch.alloc_index = 0;
 }
 
@@ -166,7 +193,6 @@ static psa_status_t tfm_crypto_init_iovecs(const psa_msg_t *msg,
         /* Allocate necessary space in the internal scratch */
         status = tfm_crypto_alloc_scratch(msg->in_size[i], &alloc_buf_ptr);
         if (status != PSA_SUCCESS) {
-            tfm_crypto_clear_scratch();
             return status;
         }
         /* Read from the IPC framework inputs into the scratch */
@@ -180,7 +206,6 @@ static psa_status_t tfm_crypto_init_iovecs(const psa_msg_t *msg,
         /* Allocate necessary space for the output in the internal scratch */
         status = tfm_crypto_alloc_scratch(msg->out_size[i], &alloc_buf_ptr);
         if (status != PSA_SUCCESS) {
-            tfm_crypto_clear_scratch();
             return status;
         }
         /* Populate the fields of the output to the secure function */
@@ -249,6 +274,8 @@ static psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
                                                    &encoded_key);
     case TFM_CRYPTO_GROUP_ID_RANDOM:
         return tfm_crypto_random_interface(in_vec, out_vec);
+    case TFM_CRYPTO_GROUP_ID_COMPOUND:
+        return tfm_crypto_compound_interface(in_vec, out_vec, &encoded_key);
     default:
         LOG_ERRFMT("[ERR][Crypto] Unsupported request!\r\n");
         return PSA_ERROR_NOT_SUPPORTED;
@@ -288,6 +315,9 @@ static psa_status_t tfm_crypto_call_srv(const psa_msg_t *msg)
 
     status = tfm_crypto_init_iovecs(msg, in_vec, in_len, out_vec, out_len);
     if (status != PSA_SUCCESS) {
+#if PSA_FRAMEWORK_HAS_MM_IOVEC != 1
+        tfm_crypto_clear_scratch(msg, in_vec, in_len, out_vec, out_len);
+#endif
         return status;
     }
 
@@ -296,6 +326,13 @@ static psa_status_t tfm_crypto_call_srv(const psa_msg_t *msg)
     /* Call the dispatcher to the functions that implement the PSA Crypto API */
     status = tfm_crypto_api_dispatcher(in_vec, in_len, out_vec, out_len);
 
+#if defined(CRYPTO_HW_ACCELERATOR) && defined(CC3XX_RUNTIME_ENABLED)
+    /* Lets the accelerator do its housekeeping between requests */
+    if (crypto_hw_accelerator_request_done() != 0) {
+        status = PSA_ERROR_HARDWARE_FAILURE;
+    }
+#endif /* CRYPTO_HW_ACCELERATOR && CC3XX_RUNTIME_ENABLED */
+
 #if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
     for (i = 0; i < out_len; i++) {
         if (out_vec[i].base != NULL) {
@@ -319,7 +356,7 @@ static psa_status_t tfm_crypto_call_srv(const psa_msg_t *msg)
     }
 
     /* Clear the allocated internal scratch before returning */
-    tfm_crypto_clear_scratch();
+    tfm_crypto_clear_scratch(msg, in_vec, in_len, out_vec, out_len);
 #endif
 
     return status;
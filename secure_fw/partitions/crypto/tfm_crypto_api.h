@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -13,6 +13,7 @@ extern "C" {
 #endif
 
 #include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "tfm_crypto_defs.h"
 #include "tfm_crypto_key.h"
@@ -179,6 +180,18 @@ psa_status_t tfm_crypto_asymmetric_encrypt_interface(psa_invec in_vec[],
 psa_status_t tfm_crypto_key_derivation_interface(psa_invec in_vec[],
                                                  psa_outvec out_vec[],
                                                  struct tfm_crypto_key_id_s *encoded_key);
+/**
+ * \brief This function acts as interface for the Compound module
+ *
+ * \param[in]  in_vec   Array of invec parameters
+ * \param[out] out_vec  Array of outvec parameters
+ * \param[in]  encoded_key Key encoded with partition_id and key_id
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_compound_interface(psa_invec in_vec[],
+                                           psa_outvec out_vec[],
+                                           struct tfm_crypto_key_id_s *encoded_key);
 /**
  * \brief This function acts as interface for the Random module
  *
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file tfm_mbedcrypto_mve.c
+ *       This file provides the SHA-256 compression function for mbed-crypto
+ *       using the M-profile Vector Extension (Helium) available on Armv8.1-M
+ *       cores such as the Cortex-M55 and Cortex-M85. It is selected through
+ *       the MBEDTLS_SHA256_PROCESS_ALT option when CRYPTO_MVE_ACCELERATION is
+ *       enabled, and is used underneath the PSA Crypto software
+ *       implementation for all SHA-256 based algorithms (i.e. HMAC and HKDF).
+ */
+
+/* The block functions need to access the internals of the contexts */
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include <stdint.h>
+#include <string.h>
+
+#include "tfm_mbedcrypto_include.h"
+
+#if defined(MBEDTLS_SHA256_PROCESS_ALT)
+
+#if !defined(__ARM_FEATURE_MVE) || !(__ARM_FEATURE_MVE & 1)
+#error "tfm_mbedcrypto_mve.c requires a target with integer MVE support"
+#endif
+
+#include <arm_mve.h>
+
+#include "mbedtls/sha256.h"
+#include "mbedtls/platform_util.h"
+
+/* Rotate each 32-bit lane of x right by n bits */
+#define MVE_ROR32(x, n) vsriq_n_u32(vshlq_n_u32((x), 32 - (n)), (x), (n))
+
+static const uint32_t sha256_k[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+    0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+    0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+    0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+    0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+    0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+    0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+    0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+    0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+#define SHA256_ROR(x, n)   (((x) >> (n)) | ((x) << (32 - (n))))
+#define SHA256_S0(x)       (SHA256_ROR(x, 7) ^ SHA256_ROR(x, 18) ^ ((x) >> 3))
+#define SHA256_S1(x)       (SHA256_ROR(x, 17) ^ SHA256_ROR(x, 19) ^ ((x) >> 10))
+#define SHA256_S2(x)       (SHA256_ROR(x, 2) ^ SHA256_ROR(x, 13) ^ SHA256_ROR(x, 22))
+#define SHA256_S3(x)       (SHA256_ROR(x, 6) ^ SHA256_ROR(x, 11) ^ SHA256_ROR(x, 25))
+#define SHA256_F0(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define SHA256_F1(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+
+static inline uint32x4_t sha256_sigma0_x4(uint32x4_t x)
+{
+    return veorq_u32(veorq_u32(MVE_ROR32(x, 7), MVE_ROR32(x, 18)),
+                     vshrq_n_u32(x, 3));
+}
+
+/*
+ * The message schedule is computed four words at a time. Of the four terms
+ * making up W[t], only sigma1(W[t - 2]) depends on words produced in the same
+ * group of four, so it is the only term which is added lane by lane once the
+ * other three have been summed across the vector.
+ */
+static void sha256_schedule(uint32_t w[64], const unsigned char data[64])
+{
+    uint32_t t;
+
+    for (t = 0; t < 16; t += 4) {
+        vst1q_u32(&w[t], vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[4 * t]))));
+    }
+
+    for (t = 16; t < 64; t += 4) {
+        uint32x4_t acc = vaddq_u32(vld1q_u32(&w[t - 16]),
+                                   sha256_sigma0_x4(vld1q_u32(&w[t - 15])));
+        acc = vaddq_u32(acc, vld1q_u32(&w[t - 7]));
+        vst1q_u32(&w[t], acc);
+
+        w[t]     += SHA256_S1(w[t - 2]);
+        w[t + 1] += SHA256_S1(w[t - 1]);
+        w[t + 2] += SHA256_S1(w[t]);
+        w[t + 3] += SHA256_S1(w[t + 1]);
+    }
+}
+
+int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx,
+                                    const unsigned char data[64])
+{
+    uint32_t w[64];
+    uint32_t a[8];
+    uint32_t temp1, temp2;
+    uint32_t i;
+
+    sha256_schedule(w, data);
+
+    for (i = 0; i < 8; i++) {
+        a[i] = ctx->state[i];
+    }
+
+    for (i = 0; i < 64; i++) {
+        temp1 = a[7] + SHA256_S3(a[4]) + SHA256_F1(a[4], a[5], a[6]) +
+                sha256_k[i] + w[i];
+        temp2 = SHA256_S2(a[0]) + SHA256_F0(a[0], a[1], a[2]);
+
+        a[7] = a[6];
+        a[6] = a[5];
+        a[5] = a[4];
+        a[4] = a[3] + temp1;
+        a[3] = a[2];
+        a[2] = a[1];
+        a[1] = a[0];
+        a[0] = temp1 + temp2;
+    }
+
+    for (i = 0; i < 8; i++) {
+        ctx->state[i] += a[i];
+    }
+
+    mbedtls_platform_zeroize(w, sizeof(w));
+    mbedtls_platform_zeroize(a, sizeof(a));
+
+    return 0;
+}
+#endif /* MBEDTLS_SHA256_PROCESS_ALT */
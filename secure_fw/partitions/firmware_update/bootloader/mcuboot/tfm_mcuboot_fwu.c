@@ -44,6 +44,21 @@ typedef struct tfm_fwu_mcuboot_ctx_s {
 
     /* The size of the downloaded data in the FWU process. */
     size_t loaded_size;
+
+    /* Running hash of the data written sequentially from offset 0. */
+    psa_hash_operation_t hash_op;
+
+    /* The size of the data fed into hash_op. */
+    size_t hashed_size;
+
+    /* True while hash_op covers all the data written so far. */
+    bool hash_in_sync;
+
+    /* True once hash_op has been finished into digest. */
+    bool digest_ready;
+
+    uint8_t digest[TFM_FWU_MAX_DIGEST_SIZE];
+    size_t digest_size;
 } tfm_fwu_mcuboot_ctx_t;
 
 static tfm_fwu_mcuboot_ctx_t mcuboot_ctx[FWU_COMPONENT_NUMBER];
@@ -85,6 +100,51 @@ static psa_status_t get_active_image_version(psa_fwu_component_t component,
     return PSA_ERROR_DATA_CORRUPT;
 }
 
+/* Drop the running hash, the digest will be computed from flash instead. */
+static void running_hash_invalidate(psa_fwu_component_t component)
+{
+    if (mcuboot_ctx[component].hash_in_sync &&
+        !mcuboot_ctx[component].digest_ready) {
+        (void)psa_hash_abort(&mcuboot_ctx[component].hash_op);
+    }
+    mcuboot_ctx[component].hash_in_sync = false;
+    mcuboot_ctx[component].digest_ready = false;
+}
+
+static void running_hash_start(psa_fwu_component_t component)
+{
+    running_hash_invalidate(component);
+
+    mcuboot_ctx[component].hash_op = psa_hash_operation_init();
+    mcuboot_ctx[component].hashed_size = 0;
+    mcuboot_ctx[component].digest_size = 0;
+    /* If no hash operation is available, fall back to hashing from flash. */
+    mcuboot_ctx[component].hash_in_sync =
+        (psa_hash_setup(&mcuboot_ctx[component].hash_op,
+                        PSA_ALG_SHA_256) == PSA_SUCCESS);
+}
+
+static void running_hash_update(psa_fwu_component_t component,
+                                size_t image_offset,
+                                const void *block,
+                                size_t block_size)
+{
+    if (!mcuboot_ctx[component].hash_in_sync) {
+        return;
+    }
+
+    /* Only in order writes can be hashed on the fly. */
+    if ((image_offset != mcuboot_ctx[component].hashed_size) ||
+        mcuboot_ctx[component].digest_ready ||
+        (psa_hash_update(&mcuboot_ctx[component].hash_op,
+                         block, block_size) != PSA_SUCCESS)) {
+        running_hash_invalidate(component);
+        return;
+    }
+
+    mcuboot_ctx[component].hashed_size += block_size;
+}
+
 psa_status_t fwu_bootloader_init(void)
 {
     psa_status_t ret;
@@ -130,6 +190,8 @@ psa_status_t fwu_bootloader_staging_area_init(psa_fwu_component_t component,
     /* Reset the loaded_size. */
     mcuboot_ctx[component].loaded_size = 0;
 
+    running_hash_start(component);
+
     return PSA_SUCCESS;
 }
 
@@ -156,6 +218,8 @@ psa_status_t fwu_bootloader_load_image(psa_fwu_component_t component,
         return PSA_ERROR_STORAGE_FAILURE;
     }
 
+    running_hash_update(component, image_offset, block, block_size);
+
     /* The overflow check has been done in flash_area_write. */
     mcuboot_ctx[component].loaded_size += block_size;
     return PSA_SUCCESS;
@@ -497,6 +561,7 @@ psa_status_t fwu_bootloader_abort(psa_fwu_component_t component)
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
+    running_hash_invalidate(component);
     flash_area_erase(fap, 0, fap->fa_size);
     flash_area_close(fap);
     mcuboot_ctx[component].fap = NULL;
@@ -564,6 +629,31 @@ static psa_status_t get_second_image_digest(psa_fwu_component_t component,
     } else {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
+
+    /* The image has been written in order, finish the running hash once and
+     * reuse its digest for the following queries.
+     */
+    if (mcuboot_ctx[component].hash_in_sync &&
+        (mcuboot_ctx[component].hashed_size == data_size)) {
+        if (!mcuboot_ctx[component].digest_ready) {
+            if (psa_hash_finish(&mcuboot_ctx[component].hash_op,
+                                mcuboot_ctx[component].digest,
+                                sizeof(mcuboot_ctx[component].digest),
+                                &mcuboot_ctx[component].digest_size)
+                != PSA_SUCCESS) {
+                (void)psa_hash_abort(&mcuboot_ctx[component].hash_op);
+                mcuboot_ctx[component].hash_in_sync = false;
+            } else {
+                mcuboot_ctx[component].digest_ready = true;
+            }
+        }
+        if (mcuboot_ctx[component].digest_ready) {
+            memcpy(info->impl.candidate_digest, mcuboot_ctx[component].digest,
+                   mcuboot_ctx[component].digest_size);
+            return PSA_SUCCESS;
+        }
+    }
+
     if ((flash_area_open(FLASH_AREA_IMAGE_SECONDARY(component),
                             &fap)) != 0) {
         LOG_ERRFMT("TFM FWU: opening flash failed.\r\n");
@@ -665,6 +755,7 @@ psa_status_t fwu_bootloader_clean_component(psa_fwu_component_t component)
     /* Check if the image is in a FWU process. */
     if (mcuboot_ctx[component].fap != NULL) {
         fap = mcuboot_ctx[component].fap;
+        running_hash_invalidate(component);
         if (flash_area_erase(fap, 0, fap->fa_size) != 0) {
             return PSA_ERROR_STORAGE_FAILURE;
         }
@@ -109,6 +109,29 @@ initial_attest_get_token(const void *challenge_buf, size_t challenge_size,
 psa_status_t
 initial_attest_get_token_size(size_t challenge_size, size_t *token_size);
 
+/**
+ * \brief Get an initial attestation token whose nonce claim is the root of a
+ *        Merkle tree over several challenges
+ *
+ * \param[in]  challenges       Pointer to buffer where the challenges are
+ *                              stored, one after the other.
+ * \param[in]  challenge_size   Size of each challenge in bytes.
+ * \param[in]  challenge_count  Number of challenges.
+ * \param[out] token_buf        Pointer to the buffer where attestation token
+ *                              will be stored.
+ * \param[in]  token_buf_size   Size of allocated buffer for token, in bytes.
+ * \param[out] token_size       Size of the token that has been returned, in
+ *                              bytes.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t
+initial_attest_get_batch_token(const uint8_t *challenges,
+                               size_t challenge_size,
+                               size_t challenge_count,
+                               void *token_buf, size_t token_buf_size,
+                               size_t *token_size);
+
 #ifdef __cplusplus
 }
 #endif
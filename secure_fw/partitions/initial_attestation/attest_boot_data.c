@@ -141,69 +141,6 @@ attest_encode_sw_component(QCBOREncodeContext *encode_ctx,
 
     return PSA_ATTEST_ERR_SUCCESS;
 }
-#else
-/*!
- * \brief Static function to look up all entries in the shared data area
- *       (boot status) which belong to a specific module.
- *
- * \param[in]     module  The identifier of SW module to look up based on this
- * \param[out]    claim   The type of SW module's attribute
- * \param[out]    tlv_len Length of the shared data entry
- * \param[in/out] tlv_ptr Pointer to the shared data entry. If its value NULL as
- *                        input then it will starts the look up from the
- *                        beginning of the shared data section. If not NULL then
- *                        it continue look up from the next entry. It returns
- *                        the address of next found entry which belongs to
- *                        module.
- *
- * \retval    -1          Error, boot status is malformed
- * \retval     0          Entry not found
- * \retval     1          Entry found
- */
-static int32_t attest_get_tlv_by_module(uint8_t    module,
-                                        uint8_t   *claim,
-                                        uint16_t  *tlv_len,
-                                        uint8_t  **tlv_ptr)
-{
-    struct shared_data_tlv_entry tlv_entry;
-    uint8_t *tlv_end;
-    uint8_t *tlv_curr;
-
-    if (boot_data.header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) {
-        return -1;
-    }
-
-    /* Get the boundaries of TLV section where to lookup*/
-    tlv_end = (uint8_t *)&boot_data + boot_data.header.tlv_tot_len;
-    if (*tlv_ptr == NULL) {
-        /* At first call set to the beginning of the TLV section */
-        tlv_curr = boot_data.data;
-    } else {
-        /* Any subsequent call set to the next TLV entry */
-        (void)memcpy(&tlv_entry, *tlv_ptr, SHARED_DATA_ENTRY_HEADER_SIZE);
-
-        tlv_curr  = (*tlv_ptr) + SHARED_DATA_ENTRY_HEADER_SIZE
-                    + tlv_entry.tlv_len;
-    }
-
-    /* Iterates over the TLV section and returns the address and size of TLVs
-     * with requested module identifier
-     */
-    while (tlv_curr < tlv_end) {
-        /* Create local copy to avoid unaligned access */
-        (void)memcpy(&tlv_entry, tlv_curr, SHARED_DATA_ENTRY_HEADER_SIZE);
-        if (GET_IAS_MODULE(tlv_entry.tlv_type) == module) {
-            *claim   = GET_IAS_CLAIM(tlv_entry.tlv_type);
-            *tlv_ptr = tlv_curr;
-            *tlv_len = tlv_entry.tlv_len;
-            return 1;
-        }
-
-        tlv_curr += (SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len);
-    }
-
-    return 0;
-}
 #endif /* TFM_PARTITION_MEASURED_BOOT */
 
 enum psa_attest_err_t
@@ -287,11 +224,11 @@ attest_encode_sw_components_array(QCBOREncodeContext *encode_ctx,
 
 #else /* TFM_PARTITION_MEASURED_BOOT */
     struct q_useful_buf_c encoded_const = NULL_Q_USEFUL_BUF_C;
-    uint16_t tlv_len;
-    uint8_t *tlv_ptr;
-    uint8_t  tlv_id;
-    uint8_t module = 0;
-    int32_t found;
+    struct shared_data_tlv_entry tlv_entry;
+    uint8_t *tlv_end;
+    uint8_t *tlv_curr;
+    uint8_t *module_tlv[SW_MAX] = {NULL};
+    uint8_t module;
 
     if ((encode_ctx == NULL) || (cnt == NULL)) {
         return PSA_ATTEST_ERR_INVALID_INPUT;
@@ -299,22 +236,38 @@ attest_encode_sw_components_array(QCBOREncodeContext *encode_ctx,
 
     *cnt = 0;
 
-    /* Extract all boot records (measurements) from the boot status information
-     * that was received from the secure bootloader.
+    if (boot_data.header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) {
+        /* Boot status area is malformed. */
+        return PSA_ATTEST_ERR_CLAIM_UNAVAILABLE;
+    }
+
+    /* Look up the first entry of each SW module in a single pass over the
+     * TLV section of the boot status information that was received from the
+     * secure bootloader.
      */
+    tlv_end = (uint8_t *)&boot_data + boot_data.header.tlv_tot_len;
+    for (tlv_curr = boot_data.data; tlv_curr < tlv_end;
+         tlv_curr += SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len) {
+        /* Create local copy to avoid unaligned access */
+        (void)memcpy(&tlv_entry, tlv_curr, SHARED_DATA_ENTRY_HEADER_SIZE);
+
+        module = GET_IAS_MODULE(tlv_entry.tlv_type);
+        if ((module < SW_MAX) && (module_tlv[module] == NULL)) {
+            module_tlv[module] = tlv_curr;
+        }
+    }
+
+    /* Extract all boot records (measurements), in the order of SW modules */
     for (module = 0; module < SW_MAX; ++module) {
-        /* Indicates to restart the look up from the beginning of the shared
-         * data section.
-         */
-        tlv_ptr = NULL;
-
-        /* Look up the first TLV entry which belongs to the SW module */
-        found = attest_get_tlv_by_module(module, &tlv_id,
-                                         &tlv_len, &tlv_ptr);
-        if (found == -1) {
-            /* Boot status area is malformed. */
-            return PSA_ATTEST_ERR_CLAIM_UNAVAILABLE;
-        } else if ((found == 1) && (tlv_id == SW_BOOT_RECORD)) {
+        if (module_tlv[module] == NULL) {
+            continue;
+        }
+
+        /* Create local copy to avoid unaligned access */
+        (void)memcpy(&tlv_entry, module_tlv[module],
+                     SHARED_DATA_ENTRY_HEADER_SIZE);
+
+        if (GET_IAS_CLAIM(tlv_entry.tlv_type) == SW_BOOT_RECORD) {
             (*cnt)++;
             if (*cnt == 1) {
                 /* Open array which stores SW components claims. */
@@ -325,8 +278,8 @@ attest_encode_sw_components_array(QCBOREncodeContext *encode_ctx,
                 }
             }
 
-            encoded_const.ptr = tlv_ptr + SHARED_DATA_ENTRY_HEADER_SIZE;
-            encoded_const.len = tlv_len;
+            encoded_const.ptr = module_tlv[module] + SHARED_DATA_ENTRY_HEADER_SIZE;
+            encoded_const.len = tlv_entry.tlv_len;
             QCBOREncode_AddEncoded(encode_ctx, encoded_const);
         }
     }
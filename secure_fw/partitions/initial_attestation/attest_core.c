@@ -5,6 +5,7 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include <stddef.h>
@@ -570,38 +571,312 @@ static enum psa_attest_err_t attest_get_t_cose_algorithm(
     return PSA_ATTEST_ERR_SUCCESS;
 }
 
+/*!
+ * \struct attest_claim_query
+ *
+ * \brief Function adding a claim to the token, and whether the value of the
+ *        claim can be reused across tokens until the next reset.
+ */
+struct attest_claim_query {
+    enum psa_attest_err_t (*add)(struct attest_token_encode_ctx *);
+    bool cacheable;
+};
+
+/* The measured boot partition accepts new measurements at runtime, so the SW
+ * components are only fixed after reset when they come from the boot data.
+ */
+#ifdef TFM_PARTITION_MEASURED_BOOT
+#define ATTEST_SW_COMPONENTS_CACHEABLE false
+#else
+#define ATTEST_SW_COMPONENTS_CACHEABLE true
+#endif /* TFM_PARTITION_MEASURED_BOOT */
+
 #if ATTEST_TOKEN_PROFILE_PSA_IOT_1 || ATTEST_TOKEN_PROFILE_PSA_2_0_0
-    static enum psa_attest_err_t
-    (*claim_query_funcs[])(struct attest_token_encode_ctx *) = {
-        &attest_add_boot_seed_claim,
-        &attest_add_instance_id_claim,
-        &attest_add_implementation_id_claim,
-        &attest_add_caller_id_claim,
-        &attest_add_security_lifecycle_claim,
-        &attest_add_all_sw_components,
-        &attest_add_profile_definition,
+    static const struct attest_claim_query claim_query_funcs[] = {
+        {&attest_add_boot_seed_claim,          true},
+        {&attest_add_instance_id_claim,        true},
+        {&attest_add_implementation_id_claim,  true},
+        {&attest_add_caller_id_claim,          false},
+        {&attest_add_security_lifecycle_claim, true},
+        {&attest_add_all_sw_components,        ATTEST_SW_COMPONENTS_CACHEABLE},
+        {&attest_add_profile_definition,       true},
 #if ATTEST_INCLUDE_OPTIONAL_CLAIMS
-        &attest_add_verification_service,
-        &attest_add_cert_ref_claim
+        {&attest_add_verification_service,     true},
+        {&attest_add_cert_ref_claim,           true},
 #endif
     };
 #elif ATTEST_TOKEN_PROFILE_ARM_CCA
 
-    static enum psa_attest_err_t
-    (*claim_query_funcs[])(struct attest_token_encode_ctx *) = {
-        &attest_add_instance_id_claim,
-        &attest_add_implementation_id_claim,
-        &attest_add_security_lifecycle_claim,
-        &attest_add_all_sw_components,
-        &attest_add_profile_definition,
-        &attest_add_hash_algo_claim,
-        &attest_add_platform_config_claim,
+    static const struct attest_claim_query claim_query_funcs[] = {
+        {&attest_add_instance_id_claim,        true},
+        {&attest_add_implementation_id_claim,  true},
+        {&attest_add_security_lifecycle_claim, true},
+        {&attest_add_all_sw_components,        ATTEST_SW_COMPONENTS_CACHEABLE},
+        {&attest_add_profile_definition,       true},
+        {&attest_add_hash_algo_claim,          true},
+        {&attest_add_platform_config_claim,    true},
 #if ATTEST_INCLUDE_OPTIONAL_CLAIMS
-        &attest_add_verification_service,
+        {&attest_add_verification_service,     true},
 #endif
     };
 #endif
 
+#if ATTEST_CLAIM_CACHE_SIZE > 0
+/*!
+ * \struct attest_cached_claim
+ *
+ * \brief Label and pre-encoded value of a claim held in the claim cache
+ */
+struct attest_cached_claim {
+    int32_t label;
+    struct q_useful_buf_c value;
+};
+
+/*!
+ * \var claim_cache
+ *
+ * \brief The encoded values of the claims which do not change between
+ *        tokens. The security lifecycle is the only one of them which can
+ *        change at runtime, so the cache is rebuilt when it does. A failure
+ *        to build the cache is recorded as well, so that it is not attempted
+ *        again for each token until the security lifecycle changes.
+ */
+static struct {
+    uint8_t buf[ATTEST_CLAIM_CACHE_SIZE];
+    struct attest_cached_claim claims[ARRAY_LENGTH(claim_query_funcs)];
+    uint32_t count;
+    /* Size of the labels and values of the cached claims */
+    size_t encoded_size;
+    /* Size of the token, excluding the payload */
+    size_t token_overhead;
+    bool token_overhead_valid;
+    enum tfm_security_lifecycle_t lifecycle;
+    bool valid;
+    bool build_failed;
+} claim_cache;
+
+/*!
+ * \brief Static function to get the size of the head of a CBOR data item
+ *
+ * \param[in] argument  The argument of the head, i.e. the value of an
+ *                      unsigned integer or the length of a string.
+ *
+ * \return Returns the size of the head in bytes
+ */
+static size_t attest_cbor_head_size(uint64_t argument)
+{
+    if (argument < 24) {
+        return 1;
+    } else if (argument <= UINT8_MAX) {
+        return 2;
+    } else if (argument <= UINT16_MAX) {
+        return 3;
+    } else if (argument <= UINT32_MAX) {
+        return 5;
+    } else {
+        return 9;
+    }
+}
+
+/*!
+ * \brief Static function to get the size of an encoded CBOR integer
+ */
+static size_t attest_cbor_int_size(int64_t value)
+{
+    return attest_cbor_head_size((value >= 0) ? (uint64_t)value :
+                                                (uint64_t)(-(value + 1)));
+}
+
+/*!
+ * \brief Static function to compute the size of the token payload when the
+ *        cacheable claims are taken from the claim cache
+ *
+ * \param[in]  challenge_size  Size of the challenge in bytes
+ * \param[out] payload_size    Size of the encoded payload map
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_payload_size(size_t challenge_size, size_t *payload_size)
+{
+    /* The nonce and the cached claims */
+    size_t item_count = 1 + claim_cache.count;
+    size_t size = claim_cache.encoded_size;
+#if ATTEST_TOKEN_PROFILE_PSA_IOT_1 || ATTEST_TOKEN_PROFILE_PSA_2_0_0
+    enum psa_attest_err_t attest_err;
+    int32_t caller_id;
+
+    /* The caller ID is the only claim which is not cached */
+    attest_err = attest_get_caller_client_id(&caller_id);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        return attest_err;
+    }
+    size += attest_cbor_int_size(IAT_CLIENT_ID) +
+            attest_cbor_int_size(caller_id);
+    item_count++;
+#endif
+
+    size += attest_cbor_int_size(IAT_NONCE) +
+            attest_cbor_head_size(challenge_size) + challenge_size;
+
+    *payload_size = attest_cbor_head_size(item_count) + size;
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
+/*!
+ * \brief Static function to decode the CBOR integer used as a claim label
+ *
+ * \param[in]  encoded  The encoded label, followed by the claim value
+ * \param[out] label    The decoded label
+ *
+ * \return Returns the size of the encoded label, or 0 if it's not an integer
+ *         which fits a claim label.
+ */
+static size_t attest_decode_label(struct q_useful_buf_c encoded,
+                                  int32_t *label)
+{
+    const uint8_t *p = encoded.ptr;
+    uint8_t major_type;
+    uint8_t info;
+    uint32_t value;
+    size_t size;
+
+    if (encoded.len == 0) {
+        return 0;
+    }
+
+    major_type = p[0] >> 5;
+    info = p[0] & 0x1F;
+
+    if (info < 24) {
+        value = info;
+        size = 1;
+    } else if ((info == 24) && (encoded.len > 1)) {
+        value = p[1];
+        size = 2;
+    } else if ((info == 25) && (encoded.len > 2)) {
+        value = ((uint32_t)p[1] << 8) | p[2];
+        size = 3;
+    } else if ((info == 26) && (encoded.len > 4)) {
+        value = ((uint32_t)p[1] << 24) | ((uint32_t)p[2] << 16) |
+                ((uint32_t)p[3] << 8) | p[4];
+        size = 5;
+    } else {
+        return 0;
+    }
+
+    if ((value > INT32_MAX) || ((major_type != 0) && (major_type != 1))) {
+        return 0;
+    }
+
+    *label = (major_type == 0) ? (int32_t)value : -1 - (int32_t)value;
+
+    return size;
+}
+
+/*!
+ * \brief Static function to encode the cacheable claims into the claim cache
+ *
+ * \details Each claim is encoded alone in a map, then the value is located
+ *          after the map header and the label, so that it can later be added
+ *          to the token without calling the claim query function again.
+ *
+ * \param[in] lifecycle  The current security lifecycle, which the cache is
+ *                       built for.
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_claim_cache_build(enum tfm_security_lifecycle_t lifecycle)
+{
+    struct attest_token_encode_ctx encode_ctx;
+    struct q_useful_buf remaining;
+    struct q_useful_buf_c encoded;
+    struct attest_cached_claim *claim;
+    enum psa_attest_err_t attest_err;
+    size_t used = 0;
+    size_t label_size;
+    int i;
+
+    claim_cache.valid = false;
+    claim_cache.token_overhead_valid = false;
+    claim_cache.count = 0;
+    claim_cache.encoded_size = 0;
+    claim_cache.lifecycle = lifecycle;
+
+    for (i = 0; i < ARRAY_LENGTH(claim_query_funcs); ++i) {
+        if (!claim_query_funcs[i].cacheable) {
+            continue;
+        }
+
+        remaining.ptr = &claim_cache.buf[used];
+        remaining.len = sizeof(claim_cache.buf) - used;
+        QCBOREncode_Init(&encode_ctx.cbor_enc_ctx, remaining);
+        QCBOREncode_OpenMap(&encode_ctx.cbor_enc_ctx);
+
+        attest_err = claim_query_funcs[i].add(&encode_ctx);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+
+        QCBOREncode_CloseMap(&encode_ctx.cbor_enc_ctx);
+        if (QCBOREncode_Finish(&encode_ctx.cbor_enc_ctx, &encoded)
+            != QCBOR_SUCCESS) {
+            return PSA_ATTEST_ERR_BUFFER_OVERFLOW;
+        }
+        used += encoded.len;
+
+        /* A map holding a single label and value pair. */
+        if (((const uint8_t *)encoded.ptr)[0] != 0xA1) {
+            return PSA_ATTEST_ERR_GENERAL;
+        }
+        encoded = q_useful_buf_tail(encoded, 1);
+        claim_cache.encoded_size += encoded.len;
+
+        claim = &claim_cache.claims[claim_cache.count];
+        label_size = attest_decode_label(encoded, &claim->label);
+        if (label_size == 0) {
+            return PSA_ATTEST_ERR_GENERAL;
+        }
+        claim->value = q_useful_buf_tail(encoded, label_size);
+        claim_cache.count++;
+    }
+
+    claim_cache.valid = true;
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
+/*!
+ * \brief Static function to check the claim cache, and to build it when it's
+ *        not built yet or when the security lifecycle has changed.
+ *
+ * \return Returns true if the claim cache can be used.
+ */
+static bool attest_claim_cache_ready(void)
+{
+    enum tfm_security_lifecycle_t lifecycle =
+                                        tfm_attest_hal_get_security_lifecycle();
+
+    if ((claim_cache.valid || claim_cache.build_failed) &&
+        (claim_cache.lifecycle == lifecycle)) {
+        return claim_cache.valid;
+    }
+
+    /* If the cache can't be built, the claims are queried for each token. */
+    claim_cache.build_failed =
+                (attest_claim_cache_build(lifecycle) != PSA_ATTEST_ERR_SUCCESS);
+
+    return !claim_cache.build_failed;
+}
+#else /* ATTEST_CLAIM_CACHE_SIZE > 0 */
+static inline bool attest_claim_cache_ready(void)
+{
+    return false;
+}
+#endif /* ATTEST_CLAIM_CACHE_SIZE > 0 */
+
 /*!
  * \brief Static function to create the initial attestation token
  *
@@ -611,13 +886,15 @@ static enum psa_attest_err_t attest_get_t_cose_algorithm(
  *                              create it: pointer + buffer's length
  * \param[out] completed_token  Structure to carry the info about the created
  *                              token: pointer + final token's length
+ * \param[in]  use_cache        Take the cacheable claims from the claim cache
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
 static enum psa_attest_err_t
 attest_create_token(struct q_useful_buf_c *challenge,
                     struct q_useful_buf   *token,
-                    struct q_useful_buf_c *completed_token)
+                    struct q_useful_buf_c *completed_token,
+                    bool                   use_cache)
 {
     enum psa_attest_err_t attest_err = PSA_ATTEST_ERR_SUCCESS;
     enum attest_token_err_t token_err;
@@ -650,9 +927,24 @@ attest_create_token(struct q_useful_buf_c *challenge,
         goto error;
     }
 
+#if ATTEST_CLAIM_CACHE_SIZE > 0
+    if (use_cache) {
+        /* Splice in the values encoded when the cache was built */
+        for (i = 0; i < claim_cache.count; ++i) {
+            attest_token_encode_add_cbor(&attest_token_ctx,
+                                         claim_cache.claims[i].label,
+                                         &claim_cache.claims[i].value);
+        }
+    }
+#endif
+
     for (i = 0; i < ARRAY_LENGTH(claim_query_funcs); ++i) {
+        if (use_cache && claim_query_funcs[i].cacheable) {
+            continue;
+        }
+
         /* Calling the attest_add_XXX_claim functions */
-        attest_err = claim_query_funcs[i](&attest_token_ctx);
+        attest_err = claim_query_funcs[i].add(&attest_token_ctx);
         if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
             goto error;
         }
@@ -668,6 +960,68 @@ error:
     return attest_err;
 }
 
+#if ATTEST_CLAIM_CACHE_SIZE > 0
+/*!
+ * \brief Static function to get the size of a token from the claim cache
+ *
+ * \details The COSE structure around the payload only depends on the key and
+ *          the algorithm, so its size is measured once by running the token
+ *          creation in size calculation mode. The size of the payload is then
+ *          computed from the cached claims and the challenge size.
+ *
+ * \param[in]  challenge_size  Size of the challenge in bytes
+ * \param[out] token_size      Size of the token in bytes
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_get_token_size_from_cache(size_t challenge_size, size_t *token_size)
+{
+    enum psa_attest_err_t attest_err;
+    struct q_useful_buf_c challenge;
+    struct q_useful_buf token;
+    struct q_useful_buf_c completed_token;
+    size_t payload_size;
+
+    if (!claim_cache.token_overhead_valid) {
+        challenge.ptr = NULL;
+        challenge.len = challenge_size;
+        token.ptr = NULL;
+        token.len = INT32_MAX;
+
+        attest_err = attest_create_token(&challenge, &token, &completed_token,
+                                         true);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+
+        attest_err = attest_payload_size(challenge_size, &payload_size);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+
+        claim_cache.token_overhead = completed_token.len -
+                                     attest_cbor_head_size(payload_size) -
+                                     payload_size;
+        claim_cache.token_overhead_valid = true;
+
+        *token_size = completed_token.len;
+        return PSA_ATTEST_ERR_SUCCESS;
+    }
+
+    attest_err = attest_payload_size(challenge_size, &payload_size);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        return attest_err;
+    }
+
+    /* The payload is wrapped in a byte string */
+    *token_size = claim_cache.token_overhead +
+                  attest_cbor_head_size(payload_size) + payload_size;
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+#endif /* ATTEST_CLAIM_CACHE_SIZE > 0 */
+
 psa_status_t
 initial_attest_get_token(const void *challenge_buf, size_t challenge_size,
                          void *token_buf, size_t token_buf_size,
@@ -693,7 +1047,8 @@ initial_attest_get_token(const void *challenge_buf, size_t challenge_size,
         goto error;
     }
 
-    attest_err = attest_create_token(&challenge, &token, &completed_token);
+    attest_err = attest_create_token(&challenge, &token, &completed_token,
+                                     attest_claim_cache_ready());
     if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
         goto error;
     }
@@ -725,7 +1080,16 @@ initial_attest_get_token_size(size_t challenge_size, size_t *token_size)
         goto error;
     }
 
-    attest_err = attest_create_token(&challenge, &token, &completed_token);
+#if ATTEST_CLAIM_CACHE_SIZE > 0
+    if (attest_claim_cache_ready()) {
+        attest_err = attest_get_token_size_from_cache(challenge_size,
+                                                      token_size);
+        goto error;
+    }
+#endif
+
+    attest_err = attest_create_token(&challenge, &token, &completed_token,
+                                     false);
     if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
         goto error;
     }
@@ -735,3 +1099,130 @@ initial_attest_get_token_size(size_t challenge_size, size_t *token_size)
 error:
     return error_mapping_to_psa_status_t(attest_err);
 }
+
+#if ATTEST_BATCH_MAX_CHALLENGES > 0
+/* The default ATTEST_STACK_SIZE only has room for the nodes of that many */
+#if ATTEST_BATCH_MAX_CHALLENGES > 32
+#error "ATTEST_BATCH_MAX_CHALLENGES must not exceed 32"
+#endif
+
+#define ATTEST_BATCH_HASH_SIZE   PSA_HASH_LENGTH(PSA_ALG_SHA_256)
+#define ATTEST_BATCH_LEAF_PREFIX 0x00
+#define ATTEST_BATCH_NODE_PREFIX 0x01
+
+/*!
+ * \brief Static function to hash a prefix byte followed by one or two buffers
+ *
+ * \param[in]  prefix  Domain separation byte for leaves and inner nodes
+ * \param[in]  a       First buffer
+ * \param[in]  a_len   Size of the first buffer in bytes
+ * \param[in]  b       Second buffer, or NULL
+ * \param[in]  b_len   Size of the second buffer in bytes
+ * \param[out] out     Buffer of ATTEST_BATCH_HASH_SIZE bytes for the hash
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t attest_batch_hash(uint8_t prefix,
+                                      const uint8_t *a, size_t a_len,
+                                      const uint8_t *b, size_t b_len,
+                                      uint8_t *out)
+{
+    psa_hash_operation_t operation = PSA_HASH_OPERATION_INIT;
+    size_t hash_len;
+    psa_status_t status;
+
+    status = psa_hash_setup(&operation, PSA_ALG_SHA_256);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = psa_hash_update(&operation, &prefix, sizeof(prefix));
+    if (status == PSA_SUCCESS) {
+        status = psa_hash_update(&operation, a, a_len);
+    }
+    if ((status == PSA_SUCCESS) && (b != NULL)) {
+        status = psa_hash_update(&operation, b, b_len);
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_hash_finish(&operation, out, ATTEST_BATCH_HASH_SIZE,
+                                 &hash_len);
+    }
+
+    if (status != PSA_SUCCESS) {
+        (void)psa_hash_abort(&operation);
+    }
+
+    return status;
+}
+
+psa_status_t
+initial_attest_get_batch_token(const uint8_t *challenges,
+                               size_t challenge_size,
+                               size_t challenge_count,
+                               void *token_buf, size_t token_buf_size,
+                               size_t *token_size)
+{
+    uint8_t nodes[ATTEST_BATCH_MAX_CHALLENGES][ATTEST_BATCH_HASH_SIZE];
+    size_t level_count, i;
+    psa_status_t status;
+
+    if (attest_verify_challenge_size(challenge_size) != PSA_ATTEST_ERR_SUCCESS) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if ((challenge_count == 0) ||
+        (challenge_count > ATTEST_BATCH_MAX_CHALLENGES)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < challenge_count; i++) {
+        status = attest_batch_hash(ATTEST_BATCH_LEAF_PREFIX,
+                                   &challenges[i * challenge_size],
+                                   challenge_size, NULL, 0, nodes[i]);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    /* Reduce the tree level by level, in place. The last node of a level with
+     * an odd number of nodes is promoted unchanged.
+     */
+    for (level_count = challenge_count; level_count > 1;
+         level_count = (level_count + 1) / 2) {
+        for (i = 0; i < level_count / 2; i++) {
+            status = attest_batch_hash(ATTEST_BATCH_NODE_PREFIX,
+                                       nodes[2 * i], ATTEST_BATCH_HASH_SIZE,
+                                       nodes[2 * i + 1], ATTEST_BATCH_HASH_SIZE,
+                                       nodes[i]);
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+        }
+        if (level_count % 2) {
+            (void)memcpy(nodes[i], nodes[level_count - 1],
+                         ATTEST_BATCH_HASH_SIZE);
+        }
+    }
+
+    /* The root is the nonce of a single token, signed once */
+    return initial_attest_get_token(nodes[0], ATTEST_BATCH_HASH_SIZE,
+                                    token_buf, token_buf_size, token_size);
+}
+#else /* ATTEST_BATCH_MAX_CHALLENGES > 0 */
+psa_status_t
+initial_attest_get_batch_token(const uint8_t *challenges,
+                               size_t challenge_size,
+                               size_t challenge_count,
+                               void *token_buf, size_t token_buf_size,
+                               size_t *token_size)
+{
+    (void)challenges;
+    (void)challenge_size;
+    (void)challenge_count;
+    (void)token_buf;
+    (void)token_buf_size;
+    (void)token_size;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+#endif /* ATTEST_BATCH_MAX_CHALLENGES > 0 */
@@ -18,6 +18,7 @@
 #include "psa/service.h"
 #include "psa_manifest/tfm_initial_attestation.h"
 #include "tfm_attest_defs.h"
+#include "config_tfm.h"
 
 #define ECC_P256_PUBLIC_KEY_SIZE PSA_KEY_EXPORT_ECC_PUBLIC_KEY_MAX_SIZE(256)
 
@@ -127,6 +128,82 @@ static psa_status_t psa_attest_get_token_size(const psa_msg_t *msg)
     return status;
 }
 
+#if ATTEST_BATCH_MAX_CHALLENGES > 0
+#if PSA_FRAMEWORK_HAS_MM_IOVEC != 1
+/* Buffer to store the challenges of a batch token request. */
+static uint8_t batch_challenge_buff[ATTEST_BATCH_MAX_CHALLENGES *
+                                    PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
+#endif
+
+static psa_status_t psa_attest_get_batch_token(const psa_msg_t *msg)
+{
+    psa_status_t status;
+    const uint8_t *challenges;
+    void *token_buf;
+    rot_size_t challenge_size;
+    size_t challenge_count;
+    size_t token_buf_size;
+    size_t token_size;
+
+    if ((msg->in_size[1] != sizeof(challenge_size)) ||
+        (msg->out_size[0] == 0)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (psa_read(msg->handle, 1, &challenge_size, sizeof(challenge_size))
+        != sizeof(challenge_size)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if ((challenge_size == 0) ||
+        (challenge_size > PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64) ||
+        (msg->in_size[0] % challenge_size != 0)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    challenge_count = msg->in_size[0] / challenge_size;
+    if ((challenge_count == 0) ||
+        (challenge_count > ATTEST_BATCH_MAX_CHALLENGES)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* store the client ID here for later use in service */
+    g_attest_caller_id = msg->client_id;
+
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    challenges = psa_map_invec(msg->handle, 0);
+    token_buf = psa_map_outvec(msg->handle, 0);
+    token_buf_size = msg->out_size[0];
+#else
+    if (psa_read(msg->handle, 0, batch_challenge_buff, msg->in_size[0])
+        != msg->in_size[0]) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+    challenges = batch_challenge_buff;
+    token_buf = token_buff;
+    token_buf_size = (msg->out_size[0] < sizeof(token_buff)) ?
+                                         msg->out_size[0] : sizeof(token_buff);
+#endif
+
+    status = initial_attest_get_batch_token(challenges, challenge_size,
+                                            challenge_count,
+                                            token_buf, token_buf_size,
+                                            &token_size);
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    if (status == PSA_SUCCESS) {
+        psa_unmap_outvec(msg->handle, 0, token_size);
+        psa_unmap_invec(msg->handle, 0);
+    }
+#else
+    if (status == PSA_SUCCESS) {
+        psa_write(msg->handle, 0, token_buff, token_size);
+    }
+#endif
+
+    return status;
+}
+#endif /* ATTEST_BATCH_MAX_CHALLENGES > 0 */
+
 psa_status_t tfm_attestation_service_sfn(const psa_msg_t *msg)
 {
     switch (msg->type) {
@@ -134,6 +211,10 @@ psa_status_t tfm_attestation_service_sfn(const psa_msg_t *msg)
         return psa_attest_get_token(msg);
     case TFM_ATTEST_GET_TOKEN_SIZE:
         return psa_attest_get_token_size(msg);
+#if ATTEST_BATCH_MAX_CHALLENGES > 0
+    case TFM_ATTEST_GET_BATCH_TOKEN:
+        return psa_attest_get_batch_token(msg);
+#endif
     default:
         return PSA_ERROR_NOT_SUPPORTED;
     }
@@ -9,6 +9,7 @@
 #include "internal_status_code.h"
 #include "fih.h"
 #include "tfm_boot_data.h"
+#include "tfm_boot_timeline.h"
 #include "memory_symbols.h"
 #include "spm.h"
 #include "tfm_hal_isolation.h"
@@ -50,6 +51,8 @@ static fih_int tfm_core_init(void)
         FIH_RET(fih_int_encode(SPM_ERROR_GENERIC));
     }
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_PLATFORM_INIT_DONE, 0);
+
     /*
      * Print the TF-M version now that the platform has initialized
      * the logging backend.
@@ -100,6 +103,8 @@ int main(void)
 
     fih_int fih_rc = FIH_FAILURE;
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_ENTRY, 0);
+
     tfm_arch_config_branch_protection();
 
     /* set Main Stack Pointer limit */
@@ -41,6 +41,8 @@
 #include "load/spm_load_api.h"
 #include "tfm_nspm.h"
 #include "private/assert.h"
+#include "tfm_boot_data.h"
+#include "tfm_boot_timeline.h"
 
 /* Partition and service runtime data list head/runtime data table */
 static struct service_head_t services_listhead;
@@ -430,6 +432,8 @@ uint32_t tfm_spm_init(void)
         }
 
         backend_init_comp_assuredly(partition, service_setting);
+        BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_PARTITION_LOADED,
+                             (uint16_t)partition->p_ldinf->pid);
     }
 
 #if CONFIG_TFM_POST_PARTITION_INIT_HOOK == 1
@@ -443,5 +447,8 @@ uint32_t tfm_spm_init(void)
     }
 #endif /* CONFIG_TFM_POST_PARTITION_INIT_HOOK == 1 */
 
+    BOOT_TIMELINE_RECORD(BOOT_TIMELINE_EVENT_PARTITIONS_LOADED, 0);
+    tfm_core_boot_timeline_save();
+
     return backend_system_run();
 }
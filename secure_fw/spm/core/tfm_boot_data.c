@@ -5,9 +5,11 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include "array.h"
+#include "config_spm.h"
 #include "tfm_boot_status.h"
 #include "region_defs.h"
 #include "psa_manifest/pid.h"
@@ -18,6 +20,8 @@
 #include "spm.h"
 #include "load/partition_defs.h"
 #include "tfm_hal_isolation.h"
+#include "tfm_boot_timeline.h"
+#include "tfm_spm_log.h"
 
 /*!
  * \def BOOT_DATA_VALID
@@ -43,6 +47,116 @@
  */
 static uint32_t is_boot_data_valid = BOOT_DATA_INVALID;
 
+#if defined(BOOT_DATA_AVAILABLE) && (CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM > 0)
+/*!
+ * \struct boot_data_index_entry
+ *
+ * \brief Location of a TLV entry in the shared data area.
+ */
+struct boot_data_index_entry {
+    uint16_t tlv_type;
+    uint16_t offset; /* From the start of the shared data area */
+};
+
+/*!
+ * \var boot_data_index
+ *
+ * \brief Directory of the TLV entries in the shared data area, sorted by
+ *        major type. Entries of the same major type keep the order of the
+ *        shared data area, whatever their minor type.
+ */
+static struct boot_data_index_entry
+                        boot_data_index[CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM];
+
+/*!
+ * \var boot_data_index_num
+ *
+ * \brief Number of entries in \ref boot_data_index. Only valid when
+ *        \ref is_boot_data_indexed is true.
+ */
+static uint32_t boot_data_index_num;
+
+static bool is_boot_data_indexed;
+
+/*!
+ * \brief Build the directory of the TLV entries in the shared data area.
+ *
+ * \details If the shared data area holds more entries than the directory can
+ *          hold, the directory is not used and the shared data area is walked
+ *          for each request instead.
+ */
+static void tfm_core_index_boot_data(void)
+{
+    struct tfm_boot_data *boot_data;
+    struct shared_data_tlv_entry tlv_entry;
+    uintptr_t offset, tlv_end;
+    uint32_t i;
+
+    boot_data = (struct tfm_boot_data *)SHARED_BOOT_MEASUREMENT_BASE;
+    tlv_end = SHARED_BOOT_MEASUREMENT_BASE + boot_data->header.tlv_tot_len;
+    offset  = SHARED_BOOT_MEASUREMENT_BASE + SHARED_DATA_HEADER_SIZE;
+
+    /* The directory is only used once a complete pass has succeeded, as it
+     * can be rebuilt after entries are appended to the shared data area.
+     */
+    is_boot_data_indexed = false;
+    boot_data_index_num = 0;
+
+    for (; offset < tlv_end;
+         offset += SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len) {
+        if (boot_data_index_num == ARRAY_SIZE(boot_data_index)) {
+            return;
+        }
+
+        /* Create local copy to avoid unaligned access */
+        (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                         SHARED_DATA_ENTRY_HEADER_SIZE);
+
+        /* Stable insertion sort on the major type only, so that entries of
+         * the same major type stay in area order
+         */
+        for (i = boot_data_index_num;
+             (i > 0) && (GET_MAJOR(boot_data_index[i - 1].tlv_type) >
+                         GET_MAJOR(tlv_entry.tlv_type));
+             i--) {
+            boot_data_index[i] = boot_data_index[i - 1];
+        }
+        boot_data_index[i].tlv_type = tlv_entry.tlv_type;
+        boot_data_index[i].offset =
+                            (uint16_t)(offset - SHARED_BOOT_MEASUREMENT_BASE);
+        boot_data_index_num++;
+    }
+
+    is_boot_data_indexed = true;
+}
+
+/*!
+ * \brief Find the first directory entry of the given major type.
+ *
+ * \param[in]  major_type  Data type identifier.
+ *
+ * \return  Returns the index of the first entry of \p major_type, or of the
+ *          first entry of a greater major type if there is none.
+ */
+static uint32_t tfm_core_find_boot_data_index(uint8_t major_type)
+{
+    uint32_t low = 0;
+    uint32_t high = boot_data_index_num;
+    uint32_t mid;
+
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (GET_MAJOR(boot_data_index[mid].tlv_type) < major_type) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+#endif /* BOOT_DATA_AVAILABLE && CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM > 0 */
+
 /*!
  * \struct boot_data_access_policy
  *
@@ -79,6 +193,9 @@ static const struct boot_data_access_policy access_policy_table[] = {
 #ifdef TFM_PARTITION_DPE
     {TFM_SP_DPE, TLV_MAJOR_MBS},
 #endif
+#if defined(TFM_BOOT_TIMELINE) && defined(TFM_PARTITION_PLATFORM)
+    {TFM_SP_PLATFORM, TLV_MAJOR_BTL},
+#endif
 };
 
 /*!
@@ -134,12 +251,67 @@ void tfm_core_validate_boot_data(void)
 
     if (boot_data->header.tlv_magic == SHARED_DATA_TLV_INFO_MAGIC) {
         is_boot_data_valid = BOOT_DATA_VALID;
+#if CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM > 0
+        tfm_core_index_boot_data();
+#endif
     }
 #else
     is_boot_data_valid = BOOT_DATA_VALID;
 #endif /* BOOT_DATA_AVAILABLE */
 }
 
+void tfm_core_boot_timeline_save(void)
+{
+#if defined(BOOT_DATA_AVAILABLE) && defined(TFM_BOOT_TIMELINE)
+    struct tfm_boot_data *boot_data;
+    struct shared_data_tlv_entry tlv_entry;
+    struct boot_timeline_event event;
+    uintptr_t offset, tlv_end, event_offset;
+
+    if (is_boot_data_valid != BOOT_DATA_VALID) {
+        return;
+    }
+
+    if (boot_timeline_save(BOOT_TIMELINE_STAGE_SPM) != 0) {
+        SPMLOG_ERRMSG("[Boot timeline] Shared data area is full\r\n");
+    }
+
+#if CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM > 0
+    /* The directory has to cover the entry just added */
+    tfm_core_index_boot_data();
+#endif
+
+    boot_data = (struct tfm_boot_data *)SHARED_BOOT_MEASUREMENT_BASE;
+    tlv_end = SHARED_BOOT_MEASUREMENT_BASE + boot_data->header.tlv_tot_len;
+    offset  = SHARED_BOOT_MEASUREMENT_BASE + SHARED_DATA_HEADER_SIZE;
+
+    for (; offset < tlv_end;
+         offset += SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len) {
+        /* Create local copy to avoid unaligned access */
+        (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                         SHARED_DATA_ENTRY_HEADER_SIZE);
+
+        if (GET_MAJOR(tlv_entry.tlv_type) != TLV_MAJOR_BTL) {
+            continue;
+        }
+
+        for (event_offset = offset + SHARED_DATA_ENTRY_HEADER_SIZE;
+             event_offset + sizeof(event) <=
+             offset + SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len;
+             event_offset += sizeof(event)) {
+            (void)spm_memcpy(&event, (const void *)event_offset,
+                             sizeof(event));
+
+            /* Stage, event and argument packed as 0xSSEEAAAA */
+            SPMLOG_INFMSGVAL("[Boot timeline] Event: ",
+                             ((uint32_t)GET_MINOR(tlv_entry.tlv_type) << 24) |
+                             ((uint32_t)event.event << 16) | event.arg);
+            SPMLOG_INFMSGVAL("[Boot timeline] Timestamp: ", event.timestamp);
+        }
+    }
+#endif /* BOOT_DATA_AVAILABLE && TFM_BOOT_TIMELINE */
+}
+
 void tfm_core_get_boot_data_handler(uint32_t args[])
 {
     uint8_t  tlv_major = (uint8_t)args[0];
@@ -151,6 +323,9 @@ void tfm_core_get_boot_data_handler(uint32_t args[])
     struct shared_data_tlv_entry tlv_entry;
     uintptr_t tlv_end, offset;
     size_t next_tlv_offset = 0;
+#if CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM > 0
+    uint32_t i;
+#endif
 #endif /* BOOT_DATA_AVAILABLE */
     const struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
     fih_int fih_rc = FIH_FAILURE;
@@ -193,6 +368,38 @@ void tfm_core_get_boot_data_handler(uint32_t args[])
 
 #ifdef BOOT_DATA_AVAILABLE
     ptr = boot_data->data;
+
+#if CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM > 0
+    if (is_boot_data_indexed) {
+        /* Copy the TLVs with requested major type, which are contiguous in
+         * the directory.
+         */
+        for (i = tfm_core_find_boot_data_index(tlv_major);
+             (i < boot_data_index_num) &&
+             (GET_MAJOR(boot_data_index[i].tlv_type) == tlv_major);
+             i++) {
+            offset = SHARED_BOOT_MEASUREMENT_BASE + boot_data_index[i].offset;
+            (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                             SHARED_DATA_ENTRY_HEADER_SIZE);
+
+            next_tlv_offset = SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len;
+
+            /* Check buffer overflow */
+            if (((ptr - buf_start) + next_tlv_offset) > buf_size) {
+                args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+                return;
+            }
+
+            (void)spm_memcpy(ptr, (const void *)offset, next_tlv_offset);
+            ptr += next_tlv_offset;
+            boot_data->header.tlv_tot_len += next_tlv_offset;
+        }
+
+        args[0] = (uint32_t)PSA_SUCCESS;
+        return;
+    }
+#endif /* CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM > 0 */
+
     /* Iterates over the TLV section and copy TLVs with requested major
      * type to the provided buffer.
      */
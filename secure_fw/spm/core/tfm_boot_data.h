@@ -24,4 +24,12 @@ void tfm_core_get_boot_data_handler(uint32_t args[]);
  */
 void tfm_core_validate_boot_data(void);
 
+/**
+ * \brief Save the boot timeline of the SPM to the shared memory area, after
+ *        the ones of the bootloaders, and print the whole timeline.
+ *
+ * \note  Does nothing unless TFM_BOOT_TIMELINE is defined.
+ */
+void tfm_core_boot_timeline_save(void);
+
 #endif /* __TFM_BOOT_DATA_H__ */
@@ -23,6 +23,7 @@ extern "C" {
 #define TLV_MAJOR_IAS      0x1
 #define TLV_MAJOR_FWU      0x2
 #define TLV_MAJOR_MBS      0x3
+#define TLV_MAJOR_BTL      0x4
 #define TLV_MAJOR_INVALID  0xF
 
 /**
@@ -62,6 +63,8 @@ extern "C" {
  * |---------------------------------------|
  * | MAJOR_MBS   | slot ID  (6) | claim(6) |
  * |---------------------------------------|
+ * | MAJOR_BTL   |      boot stage         |
+ * |---------------------------------------|
  * | MAJOR_CORE  |          TBD            |
  * |---------------------------------------|
  */
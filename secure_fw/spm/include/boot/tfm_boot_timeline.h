@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The TrustedFirmware-M Contributors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_BOOT_TIMELINE_H__
+#define __TFM_BOOT_TIMELINE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Each boot stage records timestamped events in its own memory, and saves them
+ * as a single TLV entry in the shared data area before it hands over to the
+ * next stage. The major type of the entries is TLV_MAJOR_BTL and the minor type
+ * is the stage. The data is an array of struct boot_timeline_event.
+ *
+ * The timestamps are only comparable across the stages if the timestamp source
+ * is not reset between them.
+ */
+
+/* Boot stages, used as the minor type of the TLV entries */
+#define BOOT_TIMELINE_STAGE_BL1_1   0x00
+#define BOOT_TIMELINE_STAGE_BL1_2   0x01
+#define BOOT_TIMELINE_STAGE_BL2     0x02
+#define BOOT_TIMELINE_STAGE_SPM     0x03
+
+/* Events. The argument of the image related events is the image ID, and the
+ * argument of the partition related events is the partition ID.
+ */
+#define BOOT_TIMELINE_EVENT_ENTRY                0x01
+#define BOOT_TIMELINE_EVENT_EXIT                 0x02
+#define BOOT_TIMELINE_EVENT_PLATFORM_INIT_DONE   0x03
+#define BOOT_TIMELINE_EVENT_COPY_START           0x10
+#define BOOT_TIMELINE_EVENT_COPY_DONE            0x11
+#define BOOT_TIMELINE_EVENT_DECRYPT_START        0x12
+#define BOOT_TIMELINE_EVENT_DECRYPT_DONE         0x13
+#define BOOT_TIMELINE_EVENT_HASH_START           0x14
+#define BOOT_TIMELINE_EVENT_HASH_DONE            0x15
+#define BOOT_TIMELINE_EVENT_SIG_VERIFY_START     0x16
+#define BOOT_TIMELINE_EVENT_SIG_VERIFY_DONE      0x17
+#define BOOT_TIMELINE_EVENT_IMAGE_VALIDATE_START 0x18
+#define BOOT_TIMELINE_EVENT_IMAGE_VALIDATE_DONE  0x19
+#define BOOT_TIMELINE_EVENT_PARTITION_LOADED     0x20
+#define BOOT_TIMELINE_EVENT_PARTITIONS_LOADED    0x21
+
+/**
+ * Timeline event. All fields in little endian.
+ */
+struct boot_timeline_event {
+    uint8_t  event;
+    uint8_t  reserved;
+    uint16_t arg;
+    uint32_t timestamp;
+};
+
+/* Maximum number of events a single stage can record */
+#ifndef BOOT_TIMELINE_MAX_EVENTS
+#define BOOT_TIMELINE_MAX_EVENTS 32
+#endif
+
+#ifdef TFM_BOOT_TIMELINE
+/**
+ * \brief Get the current timestamp. The default implementation returns the
+ *        cycle counter of the DWT where there is one. Platforms can override
+ *        it with a counter which keeps running across the boot stages.
+ *
+ * \return Timestamp in platform defined units
+ */
+uint32_t boot_timeline_get_timestamp(void);
+
+/**
+ * \brief Record an event of the current boot stage. Events are dropped once
+ *        \ref BOOT_TIMELINE_MAX_EVENTS have been recorded.
+ *
+ * \param[in] event  Event ID, one of BOOT_TIMELINE_EVENT_*
+ * \param[in] arg    Event specific argument
+ */
+void boot_timeline_record(uint8_t event, uint16_t arg);
+
+/**
+ * \brief Save the events recorded by the current boot stage to the shared
+ *        data area.
+ *
+ * \param[in] stage  Boot stage, one of BOOT_TIMELINE_STAGE_*
+ *
+ * \return 0 on success, nonzero on failure.
+ */
+int boot_timeline_save(uint8_t stage);
+
+#define BOOT_TIMELINE_RECORD(event, arg) boot_timeline_record((event), (arg))
+#else
+#define BOOT_TIMELINE_RECORD(event, arg)
+#endif /* TFM_BOOT_TIMELINE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_BOOT_TIMELINE_H__ */